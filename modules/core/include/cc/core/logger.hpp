@@ -1,8 +1,18 @@
 #pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
 #include <memory>
+#include <new>
+#include <string>
 #include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
+#include "types.hpp"
 
 namespace cc::log {
 
@@ -16,6 +26,36 @@ enum class Level {
     Off
 };
 
+//NOTE: what a thread does when its async buffer is full
+enum class OverflowPolicy {
+    Block,  // wait for the writer thread to make room
+    Drop,   // discard the message silently
+    Count   // discard the message; the writer reports how many were lost
+};
+
+struct AsyncOptions {
+    u32 bufferSize{1u << 16};                       // bytes per logging thread, rounded up to a power of two
+    OverflowPolicy overflow{OverflowPolicy::Count};
+    std::chrono::milliseconds idleInterval{1};      // writer sleep when every buffer is empty
+};
+
+//NOTE: Init, then move formatting and sink writes off the calling threads. Each thread logs into
+//      its own lock-free ring buffer (allocated on its first message) and one writer thread
+//      formats the records in timestamp order into the same sinks. Records too large for a
+//      buffer are written synchronously once the queue is flushed, so they keep their place;
+//      Critical flushes before returning.
+void InitAsync(std::string_view name, const AsyncOptions& options = {});
+
+//NOTE: blocks until everything logged before the call has reached the sinks
+void Flush();
+
+//NOTE: drains the buffers, stops the writer thread and returns to synchronous logging; also run
+//      at exit
+void Shutdown();
+
+//NOTE: messages discarded by the Drop and Count policies since InitAsync
+[[nodiscard]] u64 DroppedCount() noexcept;
+
 namespace detail {
 inline std::shared_ptr<spdlog::logger>& GetLoggerInstance() noexcept {
     static std::shared_ptr<spdlog::logger> g_logger;
@@ -34,6 +74,145 @@ inline spdlog::level::level_enum ToSpdlogLevel(Level level) noexcept {
         default:              return spdlog::level::info;
     }
 }
+
+//NOTE: set while the async backend runs; records larger than the limit are logged synchronously
+inline std::atomic<bool>& AsyncActive() noexcept {
+    static std::atomic<bool> g_active{false};
+    return g_active;
+}
+
+inline std::atomic<u32>& RecordLimit() noexcept {
+    static std::atomic<u32> g_limit{0};
+    return g_limit;
+}
+
+//NOTE: An async record is a RecordHeader, the format string, then each argument: raw bytes for
+//      scalars, a u32 length and the characters for strings. decode turns the argument bytes back
+//      into values on the writer thread. A message with any other argument type is formatted
+//      whole on the calling thread: such a value may point at memory that is gone by the time the
+//      writer gets to it, and formatting it alone would lose the spec of its placeholder.
+using DecodeFn = void (*)(const std::byte* args, std::string_view format, fmt::memory_buffer& out);
+
+struct RecordHeader {
+    DecodeFn decode;
+    spdlog::log_clock::rep timestamp;
+    u32 formatSize;
+    Level level;
+};
+
+template<typename T>
+inline constexpr bool IsStringLike = std::is_convertible_v<const T&, std::string_view>;
+
+template<typename T>
+inline constexpr bool IsScalar = std::is_scalar_v<T> && !IsStringLike<T>;
+
+template<typename T>
+[[nodiscard]] auto Capture(const T& arg) {
+    if constexpr (IsScalar<T>) {
+        return arg;
+    } else if constexpr (std::is_pointer_v<T>) {
+        return arg ? std::string_view(arg) : std::string_view("(null)");
+    } else {
+        return std::string_view(arg);
+    }
+}
+
+template<typename C>
+using Stored = std::conditional_t<IsScalar<C>, C, std::string_view>;
+
+template<typename C>
+[[nodiscard]] std::size_t EncodedSize(const C& value) noexcept {
+    if constexpr (std::is_same_v<Stored<C>, std::string_view>) {
+        return sizeof(u32) + std::string_view(value).size();
+    } else {
+        return sizeof(C);
+    }
+}
+
+template<typename C>
+void Encode(std::byte*& out, const C& value) noexcept {
+    if constexpr (std::is_same_v<Stored<C>, std::string_view>) {
+        const std::string_view s(value);
+        const u32 size = static_cast<u32>(s.size());
+        std::memcpy(out, &size, sizeof(size));
+        std::memcpy(out + sizeof(size), s.data(), s.size());
+        out += sizeof(size) + s.size();
+    } else {
+        std::memcpy(out, &value, sizeof(C));
+        out += sizeof(C);
+    }
+}
+
+template<typename S>
+[[nodiscard]] S Decode(const std::byte*& in) noexcept {
+    if constexpr (std::is_same_v<S, std::string_view>) {
+        u32 size;
+        std::memcpy(&size, in, sizeof(size));
+        const std::string_view s(reinterpret_cast<const char*>(in + sizeof(size)), size);
+        in += sizeof(size) + size;
+        return s;
+    } else {
+        alignas(S) std::byte storage[sizeof(S)];
+        std::memcpy(storage, in, sizeof(S));
+        in += sizeof(S);
+        return *std::launder(reinterpret_cast<S*>(storage));
+    }
+}
+
+template<typename... S>
+void DecodeRecord(const std::byte* args, std::string_view format, fmt::memory_buffer& out) {
+    //NOTE: braced initialization evaluates the decodes left to right
+    const std::tuple<S...> values{Decode<S>(args)...};
+    std::apply([&](const auto&... v) {
+        fmt::vformat_to(fmt::appender(out), format, fmt::make_format_args(v...));
+    }, values);
+}
+
+//NOTE: defined in logger.cpp; BeginRecord returns space in the calling thread's buffer, or
+//      nullptr when the record is dropped by the overflow policy
+[[nodiscard]] std::byte* BeginRecord(u32 size);
+void CommitRecord() noexcept;
+
+template<typename... C>
+void Push(Level level, std::string_view format, const C&... values) {
+    const std::size_t size = sizeof(RecordHeader) + format.size() + (std::size_t{0} + ... + EncodedSize(values));
+    if (size > RecordLimit().load(std::memory_order_relaxed)) {
+        Flush();
+        GetLoggerInstance()->log(ToSpdlogLevel(level), fmt::runtime(format), values...);
+        return;
+    }
+    std::byte* out = BeginRecord(static_cast<u32>(size));
+    if (!out) {
+        return;
+    }
+    const RecordHeader header{
+        &DecodeRecord<Stored<C>...>,
+        spdlog::log_clock::now().time_since_epoch().count(),
+        static_cast<u32>(format.size()),
+        level
+    };
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    std::memcpy(out, format.data(), format.size());
+    out += format.size();
+    (Encode(out, values), ...);
+    CommitRecord();
+}
+
+template<typename... Args>
+void Enqueue(Level level, std::string_view format, const Args&... args) {
+    if constexpr (((IsScalar<Args> || IsStringLike<Args>) && ...)) {
+        Push(level, format, Capture(args)...);
+    } else {
+        std::string message;
+        try {
+            message = fmt::vformat(format, fmt::make_format_args(args...));
+        } catch (const std::exception& e) {
+            message = fmt::format("[log format error: {}] {}", e.what(), format);
+        }
+        Push(level, "{}", message);
+    }
+}
 }
 
 inline void Init(const std::string_view &name) {
@@ -56,50 +235,49 @@ inline std::shared_ptr<spdlog::logger>& GetLogger() noexcept {
 }
 
 template<typename... Args>
-inline void Trace(std::string_view fmt, Args&&... args) {
+inline void Log(Level level, std::string_view fmt, Args&&... args) {
     auto& logger = GetLogger();
-    if (logger) {
-        logger->trace(fmt::runtime(fmt), std::forward<Args>(args)...);
+    const auto spdlog_level = detail::ToSpdlogLevel(level);
+    if (!logger || !logger->should_log(spdlog_level)) {
+        return;
+    }
+    if (detail::AsyncActive().load(std::memory_order_acquire)) {
+        detail::Enqueue(level, fmt, args...);
+    } else {
+        logger->log(spdlog_level, fmt::runtime(fmt), std::forward<Args>(args)...);
     }
 }
 
+template<typename... Args>
+inline void Trace(std::string_view fmt, Args&&... args) {
+    Log(Level::Trace, fmt, std::forward<Args>(args)...);
+}
+
 template<typename... Args>
 inline void Debug(std::string_view fmt, Args&&... args) {
-    auto& logger = GetLogger();
-    if (logger) {
-        logger->debug(fmt::runtime(fmt), std::forward<Args>(args)...);
-    }
+    Log(Level::Debug, fmt, std::forward<Args>(args)...);
 }
 
 template<typename... Args>
 inline void Info(std::string_view fmt, Args&&... args) {
-    auto& logger = GetLogger();
-    if (logger) {
-        logger->info(fmt::runtime(fmt), std::forward<Args>(args)...);
-    }
+    Log(Level::Info, fmt, std::forward<Args>(args)...);
 }
 
 template<typename... Args>
 inline void Warn(std::string_view fmt, Args&&... args) {
-    auto& logger = GetLogger();
-    if (logger) {
-        logger->warn(fmt::runtime(fmt), std::forward<Args>(args)...);
-    }
+    Log(Level::Warn, fmt, std::forward<Args>(args)...);
 }
 
 template<typename... Args>
 inline void Error(std::string_view fmt, Args&&... args) {
-    auto& logger = GetLogger();
-    if (logger) {
-        logger->error(fmt::runtime(fmt), std::forward<Args>(args)...);
-    }
+    Log(Level::Error, fmt, std::forward<Args>(args)...);
 }
 
 template<typename... Args>
 inline void Critical(std::string_view fmt, Args&&... args) {
-    auto& logger = GetLogger();
-    if (logger) {
-        logger->critical(fmt::runtime(fmt), std::forward<Args>(args)...);
+    Log(Level::Critical, fmt, std::forward<Args>(args)...);
+    if (detail::AsyncActive().load(std::memory_order_acquire)) {
+        Flush();
     }
 }
 
@@ -0,0 +1,392 @@
+#include <cc/core/logger.hpp>
+#include <algorithm>
+#include <bit>
+#include <condition_variable>
+#include <cstdlib>
+#include <limits>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace cc::log {
+
+namespace {
+
+using detail::RecordHeader;
+
+//NOTE: Single-producer single-consumer byte ring. head and tail count bytes monotonically and sit
+//      on separate cache lines; each side keeps a cached copy of the other's index and only
+//      reloads it when the cached one says the ring is full (or empty). Every entry starts with
+//      its u64 length so the payload stays 8-byte aligned; an entry that does not fit before the
+//      end of the buffer is preceded by a wrap marker covering the remainder.
+class Ring {
+public:
+    explicit Ring(u32 capacity)
+        : data_(std::make_unique<std::byte[]>(capacity)), capacity_(capacity) {}
+
+    //NOTE: the largest record TryReserve can always place, wherever the ring currently wraps
+    [[nodiscard]] static u32 MaxRecordSize(u32 capacity) noexcept {
+        return capacity / 2 - 2 * PrefixSize;
+    }
+
+    //NOTE: producer; space for size bytes, published by Commit
+    [[nodiscard]] std::byte* TryReserve(u32 size) noexcept {
+        const u64 total = (PrefixSize + size + PrefixSize - 1) & ~u64{PrefixSize - 1};
+        u64 head = head_.load(std::memory_order_relaxed);
+        u64 offset = head & (capacity_ - 1);
+        const u64 contiguous = capacity_ - offset;
+        const u64 needed = total > contiguous ? contiguous + total : total;
+        if (head + needed - cachedTail_ > capacity_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head + needed - cachedTail_ > capacity_) {
+                return nullptr;
+            }
+        }
+        if (total > contiguous) {
+            std::memcpy(data_.get() + offset, &WrapMarker, PrefixSize);
+            head += contiguous;
+            offset = 0;
+        }
+        std::memcpy(data_.get() + offset, &total, PrefixSize);
+        pending_ = head + total;
+        return data_.get() + offset + PrefixSize;
+    }
+
+    void Commit() noexcept {
+        head_.store(pending_, std::memory_order_release);
+    }
+
+    //NOTE: consumer; the oldest record, or nullptr when the ring is empty
+    [[nodiscard]] const std::byte* Peek() noexcept {
+        u64 tail = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            if (tail == cachedHead_) {
+                cachedHead_ = head_.load(std::memory_order_acquire);
+                if (tail == cachedHead_) {
+                    return nullptr;
+                }
+            }
+            const u64 offset = tail & (capacity_ - 1);
+            std::memcpy(&current_, data_.get() + offset, PrefixSize);
+            if (current_ != WrapMarker) {
+                return data_.get() + offset + PrefixSize;
+            }
+            tail += capacity_ - offset;
+            tail_.store(tail, std::memory_order_release);
+        }
+    }
+
+    //NOTE: consumer; frees the record returned by the last Peek
+    void Release() noexcept {
+        tail_.store(tail_.load(std::memory_order_relaxed) + current_, std::memory_order_release);
+    }
+
+    [[nodiscard]] bool Empty() const noexcept {
+        return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr u32 PrefixSize = sizeof(u64);
+    static constexpr u64 WrapMarker = std::numeric_limits<u64>::max();
+
+    std::unique_ptr<std::byte[]> data_;
+    u64 capacity_;
+
+    alignas(64) std::atomic<u64> head_{0};
+    u64 cachedTail_{0};
+    u64 pending_{0};
+
+    alignas(64) std::atomic<u64> tail_{0};
+    u64 cachedHead_{0};
+    u64 current_{0};
+};
+
+struct ThreadBuffer {
+    ThreadBuffer(u32 capacity, OverflowPolicy overflow) : ring(capacity), overflow(overflow) {}
+
+    Ring ring;
+    OverflowPolicy overflow;
+    std::atomic<bool> abandoned{false};
+    std::atomic<u64> dropped{0};
+    u64 reported{0};   // writer thread only
+};
+
+//NOTE: Owns the writer thread. Producers only touch their own ThreadBuffer; the mutex guards
+//      registration and the flush tickets, never the records themselves
+class Backend {
+public:
+    Backend(std::shared_ptr<spdlog::logger> logger, const AsyncOptions& options)
+        : logger_(std::move(logger)), options_(options),
+          writer_([this](std::stop_token stop) { Run(stop); }) {}
+
+    ~Backend() {
+        writer_.request_stop();
+        writer_.join();
+    }
+
+    Backend(const Backend&) = delete;
+    Backend& operator=(const Backend&) = delete;
+
+    void Register(std::shared_ptr<ThreadBuffer> buffer) {
+        const std::scoped_lock lock(mutex_);
+        buffers_.push_back(std::move(buffer));
+        changed_ = true;
+    }
+
+    void Flush() {
+        std::unique_lock lock(mutex_);
+        const u64 ticket = ++flushRequested_;
+        wake_.notify_all();
+        flushed_.wait(lock, [&] { return flushCompleted_ >= ticket; });
+    }
+
+    [[nodiscard]] const AsyncOptions& Options() const noexcept {
+        return options_;
+    }
+
+private:
+    void Run(std::stop_token stop) {
+        while (true) {
+            u64 ticket;
+            {
+                const std::scoped_lock lock(mutex_);
+                ticket = flushRequested_;
+                if (changed_) {
+                    local_ = buffers_;
+                    changed_ = false;
+                }
+            }
+
+            const bool wrote = Drain();
+            ReportDropped();
+            Prune();
+            if (ticket != flushedTicket_) {
+                logger_->flush();
+                flushedTicket_ = ticket;
+            }
+
+            std::unique_lock lock(mutex_);
+            flushCompleted_ = ticket;
+            flushed_.notify_all();
+            if (wrote || flushRequested_ != ticket) {
+                continue;
+            }
+            if (stop.stop_requested()) {
+                break;
+            }
+            wake_.wait_for(lock, stop, options_.idleInterval, [&] { return flushRequested_ != ticket; });
+        }
+        logger_->flush();
+    }
+
+    //NOTE: writes everything currently queued, merging the per-thread rings by timestamp
+    bool Drain() {
+        bool wrote = false;
+        while (true) {
+            ThreadBuffer* next = nullptr;
+            const std::byte* record = nullptr;
+            RecordHeader header{};
+            for (const auto& buffer : local_) {
+                const std::byte* candidate = buffer->ring.Peek();
+                if (!candidate) {
+                    continue;
+                }
+                RecordHeader candidateHeader;
+                std::memcpy(&candidateHeader, candidate, sizeof(candidateHeader));
+                if (!next || candidateHeader.timestamp < header.timestamp) {
+                    next = buffer.get();
+                    record = candidate;
+                    header = candidateHeader;
+                }
+            }
+            if (!next) {
+                return wrote;
+            }
+            Write(header, record + sizeof(RecordHeader));
+            next->ring.Release();
+            wrote = true;
+        }
+    }
+
+    void Write(const RecordHeader& header, const std::byte* payload) {
+        const std::string_view format(reinterpret_cast<const char*>(payload), header.formatSize);
+        message_.clear();
+        try {
+            header.decode(payload + header.formatSize, format, message_);
+        } catch (const std::exception& e) {
+            message_.clear();
+            fmt::format_to(fmt::appender(message_), "[log format error: {}] {}", e.what(), format);
+        }
+        const spdlog::log_clock::time_point time{spdlog::log_clock::duration(header.timestamp)};
+        logger_->log(time, spdlog::source_loc{}, detail::ToSpdlogLevel(header.level),
+                     spdlog::string_view_t(message_.data(), message_.size()));
+    }
+
+    void ReportDropped() {
+        for (const auto& buffer : local_) {
+            if (buffer->overflow != OverflowPolicy::Count) {
+                continue;
+            }
+            const u64 dropped = buffer->dropped.load(std::memory_order_relaxed);
+            if (dropped != buffer->reported) {
+                logger_->warn("{} log messages dropped, buffer full", dropped - buffer->reported);
+                buffer->reported = dropped;
+            }
+        }
+    }
+
+    //NOTE: a buffer whose thread has exited goes once the writer has emptied it
+    void Prune() {
+        const auto finished = [](const std::shared_ptr<ThreadBuffer>& buffer) {
+            return buffer->abandoned.load(std::memory_order_acquire) && buffer->ring.Empty();
+        };
+        if (std::none_of(local_.begin(), local_.end(), finished)) {
+            return;
+        }
+        const std::scoped_lock lock(mutex_);
+        std::erase_if(buffers_, finished);
+        local_ = buffers_;
+        changed_ = false;
+    }
+
+    std::shared_ptr<spdlog::logger> logger_;
+    AsyncOptions options_;
+
+    std::mutex mutex_;
+    std::condition_variable_any wake_;
+    std::condition_variable flushed_;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+    bool changed_{false};
+    u64 flushRequested_{0};
+    u64 flushCompleted_{0};
+
+    //NOTE: writer thread only
+    std::vector<std::shared_ptr<ThreadBuffer>> local_;
+    fmt::memory_buffer message_;
+    u64 flushedTicket_{0};
+
+    std::jthread writer_;
+};
+
+std::mutex g_mutex;
+std::shared_ptr<Backend> g_backend;
+std::atomic<u64> g_generation{0};
+std::atomic<u64> g_dropped{0};
+
+//NOTE: the generation tells a thread that its buffer belongs to an earlier InitAsync
+struct LocalSlot {
+    std::shared_ptr<ThreadBuffer> buffer;
+    u64 generation{0};
+
+    ~LocalSlot() {
+        if (buffer) {
+            buffer->abandoned.store(true, std::memory_order_release);
+        }
+    }
+};
+
+thread_local LocalSlot t_slot;
+
+[[nodiscard]] bool Attach(LocalSlot& slot, u64 generation) {
+    const std::scoped_lock lock(g_mutex);
+    if (!g_backend || g_generation.load(std::memory_order_relaxed) != generation) {
+        return false;
+    }
+    if (slot.buffer) {
+        slot.buffer->abandoned.store(true, std::memory_order_release);
+    }
+    const AsyncOptions& options = g_backend->Options();
+    slot.buffer = std::make_shared<ThreadBuffer>(options.bufferSize, options.overflow);
+    slot.generation = generation;
+    g_backend->Register(slot.buffer);
+    return true;
+}
+
+[[nodiscard]] u32 RingCapacity(u32 requested) noexcept {
+    return std::bit_ceil(std::clamp(requested, 1u << 10, 1u << 30));
+}
+
+}
+
+namespace detail {
+
+std::byte* BeginRecord(u32 size) {
+    LocalSlot& slot = t_slot;
+    const u64 generation = g_generation.load(std::memory_order_acquire);
+    if (slot.generation != generation && !Attach(slot, generation)) {
+        return nullptr;
+    }
+
+    ThreadBuffer& buffer = *slot.buffer;
+    std::byte* out = buffer.ring.TryReserve(size);
+    if (!out && buffer.overflow == OverflowPolicy::Block) {
+        while (!(out = buffer.ring.TryReserve(size)) && AsyncActive().load(std::memory_order_relaxed)) {
+            std::this_thread::yield();
+        }
+    }
+    if (!out) {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        g_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    return out;
+}
+
+void CommitRecord() noexcept {
+    t_slot.buffer->ring.Commit();
+}
+
+}
+
+void InitAsync(std::string_view name, const AsyncOptions& options) {
+    Shutdown();
+    //NOTE: keeps a logger Init already registered under this name, and its level
+    if (auto existing = spdlog::get(std::string(name))) {
+        detail::GetLoggerInstance() = std::move(existing);
+    } else {
+        Init(name);
+    }
+
+    AsyncOptions resolved = options;
+    resolved.bufferSize = RingCapacity(options.bufferSize);
+
+    static std::once_flag s_atexit;
+    std::call_once(s_atexit, [] { std::atexit([] { Shutdown(); }); });
+
+    const std::scoped_lock lock(g_mutex);
+    g_backend = std::make_shared<Backend>(detail::GetLoggerInstance(), resolved);
+    g_dropped.store(0, std::memory_order_relaxed);
+    detail::RecordLimit().store(Ring::MaxRecordSize(resolved.bufferSize), std::memory_order_relaxed);
+    g_generation.fetch_add(1, std::memory_order_release);
+    detail::AsyncActive().store(true, std::memory_order_release);
+}
+
+void Flush() {
+    std::shared_ptr<Backend> backend;
+    {
+        const std::scoped_lock lock(g_mutex);
+        backend = g_backend;
+    }
+    if (backend) {
+        backend->Flush();
+    } else if (auto& logger = detail::GetLoggerInstance()) {
+        logger->flush();
+    }
+}
+
+void Shutdown() {
+    std::shared_ptr<Backend> backend;
+    {
+        const std::scoped_lock lock(g_mutex);
+        detail::AsyncActive().store(false, std::memory_order_release);
+        backend = std::move(g_backend);
+    }
+    //NOTE: the last owner joins the writer after a final drain
+    backend.reset();
+}
+
+u64 DroppedCount() noexcept {
+    return g_dropped.load(std::memory_order_relaxed);
+}
+
+}
@@ -3,10 +3,12 @@
 #include "entity.hpp"
 #include "type_id.hpp"
 #include "../storage/component_storage.hpp"
+#include "../storage/soa_storage.hpp"
 
 #include <cc/core/types.hpp>
 #include <unordered_map>
 #include <memory>
+#include <span>
 #include <vector>
 #include <cassert>
 #include <concepts>
@@ -20,8 +22,22 @@ class BasicView;
 //NOTE: helper for friendship of view internals
 namespace detail {
     struct ViewAccess;
+
+    template<typename T>
+    struct StorageSelect {
+        using type = ComponentStorage<T>;
+    };
+
+    template<soa_component T>
+    struct StorageSelect<T> {
+        using type = SoaStorage<T>;
+    };
 }
 
+//NOTE: components with a SoaLayout<T> specialisation are stored field-by-field
+template<typename T>
+using StorageFor = typename detail::StorageSelect<T>::type;
+
 //NOTE: Registry manages entity lifetimes and component storages.
 class Registry {
 public:
@@ -32,11 +48,21 @@ public:
 
     void Destroy(Entity e);
 
+    //NOTE: Deferred destruction. Marked entities stay valid until Sweep(), which strips their
+    //      components from every storage (storages processed in parallel) and then recycles them.
+    void MarkForDestroy(Entity e);
+    void Sweep();
+
+    [[nodiscard]] std::size_t PendingDestroyCount() const noexcept {
+        return pendingDestroy_.size();
+    }
+
     [[nodiscard]] bool IsValid(Entity e) const noexcept;
 
+    //NOTE: returns T& for regular components and void for SoA components
     template<typename T, typename... Args>
     requires std::constructible_from<T, Args...>
-    T& Emplace(Entity e, Args&&... args) {
+    decltype(auto) Emplace(Entity e, Args&&... args) {
         assert(IsValid(e));
         auto& storage = GetOrCreateStorage<T>();
         return storage.Emplace(e, std::forward<Args>(args)...);
@@ -51,8 +77,9 @@ public:
         return storage ? storage->Has(e) : false;
     }
 
+    //NOTE: SoA components are returned by value; use Soa<T>().Field<&T::member>() for bulk access
     template<typename T>
-    [[nodiscard]] T& Get(Entity e) {
+    [[nodiscard]] decltype(auto) Get(Entity e) {
         assert(IsValid(e));
         auto* storage = GetStorage<T>();
         assert(storage && "ComponentStorage not found.");
@@ -60,7 +87,7 @@ public:
     }
 
     template<typename T>
-    [[nodiscard]] const T& Get(Entity e) const {
+    [[nodiscard]] decltype(auto) Get(Entity e) const {
         assert(IsValid(e));
         const auto* storage = GetStorage<T>();
         assert(storage && "ComponentStorage not found.");
@@ -83,25 +110,125 @@ public:
         return BasicView<Components...>(*this);
     }
 
+    template<typename T>
+    requires soa_component<T>
+    [[nodiscard]] SoaStorage<T>& Soa() {
+        return GetOrCreateStorage<T>();
+    }
+
+    //NOTE: Resources are registry-wide singletons (active camera, frame timing, input state)
+    //      stored in a flat array indexed by GetResourceID<T>(), so access is one bounds check
+    //      and a cast. Setting an existing resource assigns in place; references stay valid.
+    template<typename T, typename... Args>
+    requires std::constructible_from<T, Args...>
+    T& SetResource(Args&&... args) {
+        const auto id = GetResourceID<T>();
+        if (id >= resources_.size()) {
+            resources_.resize(id + 1);
+        }
+
+        auto& slot = resources_[id];
+        if (!slot) {
+            auto resource = std::make_unique<ResourceImpl<T>>(std::forward<Args>(args)...);
+            auto* ptr     = &resource->value;
+            slot          = std::move(resource);
+            return *ptr;
+        }
+
+        auto& value = static_cast<ResourceImpl<T>*>(slot.get())->value;
+        value       = T(std::forward<Args>(args)...);
+        return value;
+    }
+
+    template<typename T>
+    [[nodiscard]] T* TryGetResource() noexcept {
+        const auto id = GetResourceID<T>();
+        if (id >= resources_.size() || !resources_[id]) {
+            return nullptr;
+        }
+        return &static_cast<ResourceImpl<T>*>(resources_[id].get())->value;
+    }
+
+    template<typename T>
+    [[nodiscard]] const T* TryGetResource() const noexcept {
+        const auto id = GetResourceID<T>();
+        if (id >= resources_.size() || !resources_[id]) {
+            return nullptr;
+        }
+        return &static_cast<const ResourceImpl<T>*>(resources_[id].get())->value;
+    }
+
+    template<typename T>
+    [[nodiscard]] T& GetResource() noexcept {
+        auto* resource = TryGetResource<T>();
+        assert(resource && "Resource not set.");
+        return *resource;
+    }
+
+    template<typename T>
+    [[nodiscard]] const T& GetResource() const noexcept {
+        const auto* resource = TryGetResource<T>();
+        assert(resource && "Resource not set.");
+        return *resource;
+    }
+
+    template<typename T>
+    [[nodiscard]] bool HasResource() const noexcept {
+        return TryGetResource<T>() != nullptr;
+    }
+
+    template<typename T>
+    void RemoveResource() {
+        const auto id = GetResourceID<T>();
+        if (id < resources_.size()) {
+            resources_[id].reset();
+        }
+    }
+
 private:
     struct IStorage {
         virtual ~IStorage() = default;
+        virtual void RemoveMany(std::span<const Entity> entities) = 0;
+        [[nodiscard]] virtual bool Empty() const noexcept = 0;
     };
 
     template<typename T>
     struct StorageImpl final : IStorage {
-        ComponentStorage<T> storage;
+        StorageFor<T> storage;
+
+        void RemoveMany(std::span<const Entity> entities) override {
+            storage.RemoveMany(entities);
+        }
+
+        [[nodiscard]] bool Empty() const noexcept override {
+            return storage.Empty();
+        }
+    };
+
+    struct IResource {
+        virtual ~IResource() = default;
+    };
+
+    template<typename T>
+    struct ResourceImpl final : IResource {
+        template<typename... Args>
+        explicit ResourceImpl(Args&&... args)
+            : value(std::forward<Args>(args)...) {}
+
+        T value;
     };
 
     std::vector<EntityVersion> versions_;
     std::vector<EntityIndex>   freeList_;
+    std::vector<Entity>        pendingDestroy_;
     std::unordered_map<TypeID, std::unique_ptr<IStorage>> storages_;
+    std::vector<std::unique_ptr<IResource>>               resources_;
 
     [[nodiscard]] EntityIndex AllocateIndex();
     void RecycleIndex(EntityIndex index);
 
     template<typename T>
-    [[nodiscard]] ComponentStorage<T>* GetStorage() {
+    [[nodiscard]] StorageFor<T>* GetStorage() {
         const auto it = storages_.find(GetTypeID<T>());
         if (it == storages_.end()) {
             return nullptr;
@@ -111,7 +238,7 @@ private:
     }
 
     template<typename T>
-    [[nodiscard]] const ComponentStorage<T>* GetStorage() const {
+    [[nodiscard]] const StorageFor<T>* GetStorage() const {
         const auto it = storages_.find(GetTypeID<T>());
         if (it == storages_.end()) {
             return nullptr;
@@ -121,7 +248,7 @@ private:
     }
 
     template<typename T>
-    [[nodiscard]] ComponentStorage<T>& GetOrCreateStorage() {
+    [[nodiscard]] StorageFor<T>& GetOrCreateStorage() {
         const auto id = GetTypeID<T>();
         auto it = storages_.find(id);
         if (it == storages_.end()) {
@@ -21,6 +21,18 @@ TypeID TypeIDImpl() noexcept {
     return id;
 }
 
+//NOTE: separate counter so resource ids stay small and dense enough to index a flat array
+inline TypeID NextResourceID() noexcept {
+    static std::atomic<TypeID> counter{0};
+    return counter++;
+}
+
+template<typename T>
+TypeID ResourceIDImpl() noexcept {
+    static const TypeID id = NextResourceID();
+    return id;
+}
+
 } // namespace detail
 
 template<typename T>
@@ -29,4 +41,10 @@ template<typename T>
     return detail::TypeIDImpl<Decayed>();
 }
 
+template<typename T>
+[[nodiscard]] inline TypeID GetResourceID() noexcept {
+    using Decayed = std::remove_cvref_t<T>;
+    return detail::ResourceIDImpl<Decayed>();
+}
+
 } // namespace cc::ecs
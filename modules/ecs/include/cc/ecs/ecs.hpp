@@ -6,5 +6,6 @@
 #include "core/registry.hpp"
 #include "storage/sparse_set.hpp"
 #include "storage/component_storage.hpp"
+#include "storage/soa_storage.hpp"
 #include "view/view.hpp"
 // IWYU pragma: end_exports
@@ -3,6 +3,7 @@
 #include "../core/entity.hpp"
 #include "sparse_set.hpp"
 
+#include <span>
 #include <vector>
 #include <utility>
 #include <cassert>
@@ -23,8 +24,10 @@ public:
 
         if (pos == components_.size()) {
             components_.emplace_back(std::forward<Args>(args)...);
+            entities_.push_back(e);
         } else {
             components_[pos] = T(std::forward<Args>(args)...);
+            entities_[pos]   = e;
         }
 
         return components_[pos];
@@ -42,16 +45,28 @@ public:
 
         if (pos != last) {
             components_[pos] = std::move(components_[last]);
+            entities_[pos]   = entities_[last];
         }
 
         components_.pop_back();
+        entities_.pop_back();
         sparse_.Erase(idx);
     }
 
+    void RemoveMany(std::span<const Entity> entities) {
+        for (const Entity e : entities) {
+            Remove(e);
+        }
+    }
+
     [[nodiscard]] bool Has(Entity e) const noexcept {
         return sparse_.Contains(e.index);
     }
 
+    [[nodiscard]] SparseSet::Index IndexOf(Entity e) const noexcept {
+        return sparse_.IndexOf(e.index);
+    }
+
     [[nodiscard]] T& Get(Entity e) {
         const auto pos = sparse_.IndexOf(e.index);
         assert(pos != SparseSet::Invalid);
@@ -68,6 +83,11 @@ public:
         return sparse_.Dense();
     }
 
+    //NOTE: full handles (index + version) in the same order as DenseComponents()
+    [[nodiscard]] const std::vector<Entity>& DenseHandles() const noexcept {
+        return entities_;
+    }
+
     [[nodiscard]] const std::vector<T>& DenseComponents() const noexcept {
         return components_;
     }
@@ -85,8 +105,9 @@ public:
     }
 
 private:
-    SparseSet      sparse_;
-    std::vector<T> components_;
+    SparseSet           sparse_;
+    std::vector<T>      components_;
+    std::vector<Entity> entities_;
 };
 
 } // namespace cc::ecs
@@ -0,0 +1,340 @@
+#pragma once
+
+#include "../core/entity.hpp"
+#include "sparse_set.hpp"
+
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cc::ecs {
+
+//NOTE: Opt-in struct-of-arrays layout. Specialise for a component to store each field in its own
+//      column instead of a std::vector<T>:
+//
+//      template<> struct cc::ecs::SoaLayout<Transform> {
+//          static constexpr auto Fields = std::tuple{&Transform::position, &Transform::scale};
+//      };
+template<typename T>
+struct SoaLayout;
+
+template<typename T>
+concept soa_component = requires {
+    { SoaLayout<T>::Fields };
+};
+
+namespace detail {
+
+//NOTE: vector-like fields (cc::vec3f, ...) are split further into one scalar column per axis
+template<typename F>
+concept soa_splittable = std::is_trivially_copyable_v<F> &&
+    requires(F f, std::size_t i) {
+        typename F::value_type;
+        { F::size } -> std::convertible_to<std::size_t>;
+        { f[i] } -> std::convertible_to<typename F::value_type>;
+    } &&
+    std::is_arithmetic_v<typename F::value_type> &&
+    sizeof(F) == F::size * sizeof(typename F::value_type);
+
+template<typename M>
+struct member_traits;
+
+template<typename C, typename F>
+struct member_traits<F C::*> {
+    using Class = C;
+    using Field = F;
+};
+
+template<typename T, std::size_t Align>
+struct AlignedAllocator {
+    using value_type = T;
+
+    AlignedAllocator() noexcept = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Align>&) noexcept {}
+
+    template<typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Align>;
+    };
+
+    [[nodiscard]] T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Align}));
+    }
+
+    void deallocate(T* p, std::size_t) noexcept {
+        ::operator delete(p, std::align_val_t{Align});
+    }
+
+    template<typename U>
+    [[nodiscard]] friend bool operator==(const AlignedAllocator&, const AlignedAllocator<U, Align>&) noexcept {
+        return true;
+    }
+};
+
+} // namespace detail
+
+//NOTE: Per-axis spans of a split field, e.g. Field<&Transform::position>()[0] are all x values.
+template<typename S, std::size_t N>
+struct SoaColumns {
+    std::array<std::span<S>, N> axes;
+
+    [[nodiscard]] constexpr std::span<S> operator[](std::size_t axis) const noexcept {
+        assert(axis < N);
+        return axes[axis];
+    }
+
+    [[nodiscard]] constexpr std::size_t size() const noexcept {
+        return axes[0].size();
+    }
+};
+
+template<typename T>
+requires soa_component<T>
+class SoaStorage {
+public:
+    using Component = T;
+
+    //NOTE: columns are padded to a multiple of LaneWidth and aligned for 8-wide float loads, so
+    //      kernels may always process whole lanes; padding lanes hold unspecified values.
+    static constexpr std::size_t LaneWidth = 8;
+    static constexpr std::size_t Alignment = 32;
+
+    SoaStorage() = default;
+
+    template<typename... Args>
+    void Emplace(Entity e, Args&&... args) {
+        const auto pos = sparse_.Insert(e.index);
+        if (pos == count_) {
+            Grow(count_ + 1);
+            ++count_;
+        }
+        Scatter(pos, T(std::forward<Args>(args)...));
+    }
+
+    void Set(Entity e, const T& value) {
+        const auto pos = sparse_.IndexOf(e.index);
+        assert(pos != SparseSet::Invalid);
+        Scatter(pos, value);
+    }
+
+    void Remove(Entity e) {
+        const auto idx = e.index;
+        if (!sparse_.Contains(idx)) {
+            return;
+        }
+
+        const auto pos  = sparse_.IndexOf(idx);
+        const auto last = count_ - 1;
+        if (pos != last) {
+            ForEachColumn([&](auto& column) { column[pos] = column[last]; });
+        }
+
+        --count_;
+        sparse_.Erase(idx);
+    }
+
+    void RemoveMany(std::span<const Entity> entities) {
+        for (const Entity e : entities) {
+            Remove(e);
+        }
+    }
+
+    [[nodiscard]] bool Has(Entity e) const noexcept {
+        return sparse_.Contains(e.index);
+    }
+
+    //NOTE: gathers the fields back into an AoS value; prefer Field<> spans in hot loops
+    [[nodiscard]] T Get(Entity e) const {
+        const auto pos = sparse_.IndexOf(e.index);
+        assert(pos != SparseSet::Invalid);
+        return Gather(pos);
+    }
+
+    template<auto Member>
+    [[nodiscard]] auto Field() noexcept {
+        return MakeView<Member>(count_);
+    }
+
+    template<auto Member>
+    [[nodiscard]] auto Field() const noexcept {
+        return MakeView<Member>(count_);
+    }
+
+    //NOTE: same columns as Field<>, extended over the padding up to PaddedSize()
+    template<auto Member>
+    [[nodiscard]] auto PaddedField() noexcept {
+        return MakeView<Member>(PaddedSize());
+    }
+
+    [[nodiscard]] const std::vector<SparseSet::Index>& DenseEntities() const noexcept {
+        return sparse_.Dense();
+    }
+
+    [[nodiscard]] std::size_t Size() const noexcept {
+        return count_;
+    }
+
+    [[nodiscard]] std::size_t PaddedSize() const noexcept {
+        return (count_ + LaneWidth - 1) / LaneWidth * LaneWidth;
+    }
+
+    [[nodiscard]] bool Empty() const noexcept {
+        return count_ == 0;
+    }
+
+private:
+    static constexpr auto Fields = SoaLayout<T>::Fields;
+    static constexpr std::size_t FieldCount = std::tuple_size_v<std::remove_cvref_t<decltype(Fields)>>;
+
+    template<std::size_t I>
+    using FieldType = typename detail::member_traits<
+        std::remove_cvref_t<decltype(std::get<I>(Fields))>>::Field;
+
+    template<typename U>
+    using Column = std::vector<U, detail::AlignedAllocator<U, Alignment>>;
+
+    template<typename F>
+    struct ColumnFor {
+        using type = Column<F>;
+    };
+
+    template<typename F>
+    requires detail::soa_splittable<F>
+    struct ColumnFor<F> {
+        using type = std::array<Column<typename F::value_type>, F::size>;
+    };
+
+    template<std::size_t... I>
+    static auto MakeColumns(std::index_sequence<I...>) -> std::tuple<typename ColumnFor<FieldType<I>>::type...>;
+
+    using Columns = decltype(MakeColumns(std::make_index_sequence<FieldCount>{}));
+
+    template<std::size_t I, auto Member>
+    static constexpr bool IsField() {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(std::get<I>(Fields))>, decltype(Member)>) {
+            return std::get<I>(Fields) == Member;
+        } else {
+            return false;
+        }
+    }
+
+    template<auto Member>
+    static constexpr std::size_t IndexOfField() {
+        return []<std::size_t... I>(std::index_sequence<I...>) {
+            std::size_t index = FieldCount;
+            ((IsField<I, Member>() ? (index = I, true) : false) || ...);
+            return index;
+        }(std::make_index_sequence<FieldCount>{});
+    }
+
+    template<auto Member, typename Self>
+    static auto MakeViewImpl(Self& self, std::size_t count) noexcept {
+        constexpr std::size_t I = IndexOfField<Member>();
+        static_assert(I < FieldCount, "Member is not listed in SoaLayout<T>::Fields.");
+        using F = FieldType<I>;
+        auto& column = std::get<I>(self.columns_);
+        if constexpr (detail::soa_splittable<F>) {
+            using S = std::conditional_t<std::is_const_v<Self>, const typename F::value_type, typename F::value_type>;
+            SoaColumns<S, F::size> view{};
+            for (std::size_t axis = 0; axis < F::size; ++axis) {
+                view.axes[axis] = std::span<S>(column[axis].data(), count);
+            }
+            return view;
+        } else {
+            using S = std::conditional_t<std::is_const_v<Self>, const F, F>;
+            return std::span<S>(column.data(), count);
+        }
+    }
+
+    template<auto Member>
+    [[nodiscard]] auto MakeView(std::size_t count) noexcept {
+        return MakeViewImpl<Member>(*this, count);
+    }
+
+    template<auto Member>
+    [[nodiscard]] auto MakeView(std::size_t count) const noexcept {
+        return MakeViewImpl<Member>(*this, count);
+    }
+
+    template<typename Fn>
+    void ForEachColumn(Fn&& fn) {
+        std::apply([&](auto&... fields) {
+            auto visit = [&](auto& field) {
+                if constexpr (requires { field[0].data(); }) {
+                    for (auto& axis : field) {
+                        fn(axis);
+                    }
+                } else {
+                    fn(field);
+                }
+            };
+            (visit(fields), ...);
+        }, columns_);
+    }
+
+    void Grow(std::size_t required) {
+        const std::size_t padded = (required + LaneWidth - 1) / LaneWidth * LaneWidth;
+        ForEachColumn([&](auto& column) {
+            if (column.size() < padded) {
+                column.resize(padded);
+            }
+        });
+    }
+
+    void Scatter(std::size_t pos, const T& value) {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (ScatterField<I>(pos, value), ...);
+        }(std::make_index_sequence<FieldCount>{});
+    }
+
+    template<std::size_t I>
+    void ScatterField(std::size_t pos, const T& value) {
+        using F = FieldType<I>;
+        const F& field = value.*std::get<I>(Fields);
+        auto& column   = std::get<I>(columns_);
+        if constexpr (detail::soa_splittable<F>) {
+            for (std::size_t axis = 0; axis < F::size; ++axis) {
+                column[axis][pos] = field[axis];
+            }
+        } else {
+            column[pos] = field;
+        }
+    }
+
+    [[nodiscard]] T Gather(std::size_t pos) const {
+        T value{};
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (GatherField<I>(pos, value), ...);
+        }(std::make_index_sequence<FieldCount>{});
+        return value;
+    }
+
+    template<std::size_t I>
+    void GatherField(std::size_t pos, T& value) const {
+        using F = FieldType<I>;
+        F& field           = value.*std::get<I>(Fields);
+        const auto& column = std::get<I>(columns_);
+        if constexpr (detail::soa_splittable<F>) {
+            for (std::size_t axis = 0; axis < F::size; ++axis) {
+                field[axis] = column[axis][pos];
+            }
+        } else {
+            field = column[pos];
+        }
+    }
+
+    SparseSet   sparse_;
+    Columns     columns_;
+    std::size_t count_{0};
+};
+
+} // namespace cc::ecs
@@ -3,8 +3,11 @@
 #include "../core/registry.hpp"
 #include "../storage/component_storage.hpp"
 
+#include <array>
+#include <span>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 #include <cassert>
 #include <limits>
 
@@ -26,7 +29,12 @@ namespace detail {
 
 struct ViewAccess {
     template<typename T>
-    [[nodiscard]] static const ComponentStorage<T>* GetStorage(const Registry& registry) {
+    [[nodiscard]] static const StorageFor<T>* GetStorage(const Registry& registry) {
+        return registry.template GetStorage<T>();
+    }
+
+    template<typename T>
+    [[nodiscard]] static StorageFor<T>* GetStorage(Registry& registry) {
         return registry.template GetStorage<T>();
     }
 };
@@ -39,7 +47,7 @@ template<typename... Components>
 
     auto consider = [&](auto typeTag) {
         using Comp = decltype(typeTag);
-        using T    = std::remove_cvref_t<Comp>;
+        using T    = typename std::remove_cvref_t<Comp>::type;
 
         const auto* storage = ViewAccess::GetStorage<T>(registry);
         if (!storage) {
@@ -62,6 +70,9 @@ template<typename... Components>
 
 template<typename... Components>
 class BasicView {
+    static_assert(!(soa_component<Components> || ...),
+                  "SoA components are not iterable per entity; use Registry::Soa<T>() field spans.");
+
 public:
     using RegistryType = Registry;
 
@@ -161,7 +172,76 @@ public:
         return Iterator{registry_, dense, dense->size()};
     }
 
+    //NOTE: Invokes fn(span<const Entity>, span<Components>...) once per run of live entities whose
+    //      components sit at consecutive dense positions in every storage. Single-component views
+    //      and storages filled in the same order yield one long run; interleaved storages degrade
+    //      to short runs, never to wrong data.
+    template<typename Fn>
+    requires std::invocable<Fn&, std::span<const Entity>, std::span<Components>...>
+    void EachChunk(Fn&& fn) {
+        static_assert(sizeof...(Components) > 0, "EachChunk requires at least one component.");
+        EachChunkImpl(fn, std::index_sequence_for<Components...>{});
+    }
+
 private:
+    template<typename Fn, std::size_t... I>
+    void EachChunkImpl(Fn& fn, std::index_sequence<I...>) {
+        const auto storages = std::tuple{detail::ViewAccess::GetStorage<Components>(*registry_)...};
+        if (((std::get<I>(storages) == nullptr) || ...)) {
+            return;
+        }
+
+        //NOTE: drive from the smallest storage, its handles become the entity span
+        const std::vector<Entity>* driver = &std::get<0>(storages)->DenseHandles();
+        ((driver = std::get<I>(storages)->DenseHandles().size() < driver->size()
+                       ? &std::get<I>(storages)->DenseHandles()
+                       : driver), ...);
+
+        const auto& handles  = *driver;
+        const auto& versions = registry_->versions_;
+        const std::size_t count = handles.size();
+
+        std::array<std::size_t, sizeof...(Components)> offsets{};
+
+        auto alive = [&](Entity e) {
+            return e.index < versions.size() && versions[e.index] == e.version;
+        };
+
+        auto locate = [&](auto* storage, std::size_t k, Entity e) {
+            const auto at = storage->IndexOf(e);
+            offsets[k]    = at;
+            return at != SparseSet::Invalid && storage->DenseHandles()[at] == e;
+        };
+
+        auto follows = [&](auto* storage, std::size_t k, std::size_t step, Entity e) {
+            const auto& dense = storage->DenseHandles();
+            const auto  at    = offsets[k] + step;
+            return at < dense.size() && dense[at] == e;
+        };
+
+        std::size_t pos = 0;
+        while (pos < count) {
+            const Entity first = handles[pos];
+            if (!alive(first) || !(locate(std::get<I>(storages), I, first) && ...)) {
+                ++pos;
+                continue;
+            }
+
+            const std::size_t begin = pos++;
+            while (pos < count) {
+                const Entity e = handles[pos];
+                if (!alive(e) || !(follows(std::get<I>(storages), I, pos - begin, e) && ...)) {
+                    break;
+                }
+                ++pos;
+            }
+
+            const std::size_t length = pos - begin;
+            fn(std::span<const Entity>(handles.data() + begin, length),
+               std::span<Components>(std::get<I>(storages)->DenseComponents().data() + offsets[I], length)...);
+        }
+    }
+
     RegistryType* registry_{nullptr};
 };
 
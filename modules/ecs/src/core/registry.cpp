@@ -1,5 +1,9 @@
 #include <cc/ecs/core/registry.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 namespace cc::ecs {
 
 Entity Registry::Create() { 
@@ -19,6 +23,68 @@ void Registry::Destroy(Entity e) {
     //NOTE: component cleanup remains explicit; views filter by IsValid
 }
 
+void Registry::MarkForDestroy(Entity e) {
+    if (!IsValid(e)) {
+        return;
+    }
+    pendingDestroy_.push_back(e);
+}
+
+void Registry::Sweep() {
+    //NOTE: a handle destroyed since it was marked may have had its index reused; stripping by
+    //      index would then take the new entity's components. Marked twice counts once
+    std::erase_if(pendingDestroy_, [this](Entity e) { return !IsValid(e); });
+    std::sort(pendingDestroy_.begin(), pendingDestroy_.end(),
+              [](Entity a, Entity b) { return a.index < b.index; });
+    pendingDestroy_.erase(std::unique(pendingDestroy_.begin(), pendingDestroy_.end()), pendingDestroy_.end());
+    if (pendingDestroy_.empty()) {
+        return;
+    }
+
+    //NOTE: below this many entities, thread start-up costs more than the removals themselves
+    constexpr std::size_t ParallelThreshold = 1024;
+
+    std::vector<IStorage*> targets;
+    targets.reserve(storages_.size());
+    for (auto& [id, storage] : storages_) {
+        if (!storage->Empty()) {
+            targets.push_back(storage.get());
+        }
+    }
+
+    const std::span<const Entity> doomed(pendingDestroy_);
+    const std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t workers  = std::min(targets.size(), hardware);
+
+    if (workers <= 1 || doomed.size() < ParallelThreshold) {
+        for (auto* storage : targets) {
+            storage->RemoveMany(doomed);
+        }
+    } else {
+        //NOTE: one storage per task; storages share no state so no locking is needed
+        std::atomic<std::size_t> next{0};
+        auto drain = [&] {
+            for (std::size_t i = next++; i < targets.size(); i = next++) {
+                targets[i]->RemoveMany(doomed);
+            }
+        };
+
+        std::vector<std::jthread> threads;
+        threads.reserve(workers - 1);
+        for (std::size_t w = 1; w < workers; ++w) {
+            threads.emplace_back(drain);
+        }
+        drain();
+    }
+
+    for (const Entity e : pendingDestroy_) {
+        ++versions_[e.index];
+        RecycleIndex(e.index);
+    }
+
+    pendingDestroy_.clear();
+}
+
 bool Registry::IsValid(Entity e) const noexcept { 
     return e.index < versions_.size() &&
            e.version != 0 &&
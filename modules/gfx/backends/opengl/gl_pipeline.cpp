@@ -32,6 +32,11 @@ struct GLVertexFormatInfo {
         case VertexFormat::UInt4:      return {4, GL_UNSIGNED_INT,   false};
         case VertexFormat::Byte4Norm:  return {4, GL_BYTE,           true};
         case VertexFormat::UByte4Norm: return {4, GL_UNSIGNED_BYTE,  true};
+        case VertexFormat::Half2:      return {2, GL_HALF_FLOAT,     false};
+        case VertexFormat::Half4:      return {4, GL_HALF_FLOAT,     false};
+        case VertexFormat::Short2Norm: return {2, GL_SHORT,          true};
+        case VertexFormat::Short4Norm: return {4, GL_SHORT,          true};
+        case VertexFormat::Int10_10_10_2Norm: return {4, GL_INT_2_10_10_10_REV, true};
     }
     return {4, GL_FLOAT, false};
 }
@@ -183,7 +183,13 @@ enum class VertexFormat : u8 {
     UInt3,
     UInt4,
     Byte4Norm,
-    UByte4Norm
+    UByte4Norm,
+    //NOTE: packed attributes, see cc/math/packing/packing.hpp and the cc::batch converters
+    Half2,
+    Half4,
+    Short2Norm,
+    Short4Norm,
+    Int10_10_10_2Norm
 };
 
 enum class VertexInputRate : u8 {
@@ -10,16 +10,31 @@ namespace {
 
 #if CC_GFX_ENABLE_VALIDATION
 
+[[nodiscard]] static bool IsPackedFloat4(VertexFormat fmt) {
+    switch (fmt) {
+        case VertexFormat::Byte4Norm:
+        case VertexFormat::UByte4Norm:
+        case VertexFormat::Half4:
+        case VertexFormat::Short4Norm:
+        case VertexFormat::Int10_10_10_2Norm:
+            return true;
+        default:
+            return false;
+    }
+}
+
 [[nodiscard]] static bool UniformTypeMatchesVertexFormat(UniformType type, VertexFormat fmt) {
     switch (type) {
         case UniformType::Float:
             return fmt == VertexFormat::Float;
+        //NOTE: half and normalized formats are read as floats; 4-wide packed formats also feed
+        //      vec3 inputs, their fourth component is padding
         case UniformType::Vec2:
-            return fmt == VertexFormat::Float2;
+            return fmt == VertexFormat::Float2 || fmt == VertexFormat::Half2 || fmt == VertexFormat::Short2Norm;
         case UniformType::Vec3:
-            return fmt == VertexFormat::Float3;
+            return fmt == VertexFormat::Float3 || IsPackedFloat4(fmt);
         case UniformType::Vec4:
-            return fmt == VertexFormat::Float4;
+            return fmt == VertexFormat::Float4 || IsPackedFloat4(fmt);
         case UniformType::Int:
             return fmt == VertexFormat::Int || fmt == VertexFormat::UInt;
         case UniformType::IVec2:
@@ -75,9 +90,11 @@ void ValidateVertexLayoutAgainstShader(const VertexLayout* layout, const Shader*
                     );
                 }
 
+                //NOTE: packed formats are smaller than the shader input by design
                 const u32 expectedSize = sa.size;
                 const u32 actualSize   = VertexLayout::GetFormatSize(va.format);
-                if (expectedSize != 0 && actualSize != 0 && expectedSize != actualSize) {
+                const bool packed      = actualSize < VertexLayout::GetFormatComponentCount(va.format) * 4;
+                if (!packed && expectedSize != 0 && actualSize != 0 && expectedSize != actualSize) {
                     log::Warn(
                         "Vertex layout size mismatch at location {} ('{}'): shader size {} bytes, vertex size {} bytes",
                         sa.location,
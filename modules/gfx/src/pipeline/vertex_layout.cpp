@@ -77,6 +77,11 @@ u32 VertexLayout::GetFormatSize(VertexFormat format) {
         case VertexFormat::UInt4:      return 16;
         case VertexFormat::Byte4Norm:  return 4;
         case VertexFormat::UByte4Norm: return 4;
+        case VertexFormat::Half2:      return 4;
+        case VertexFormat::Half4:      return 8;
+        case VertexFormat::Short2Norm: return 4;
+        case VertexFormat::Short4Norm: return 8;
+        case VertexFormat::Int10_10_10_2Norm: return 4;
     }
     return 0;
 }
@@ -97,6 +102,11 @@ u32 VertexLayout::GetFormatComponentCount(VertexFormat format) {
         case VertexFormat::UInt4:      return 4;
         case VertexFormat::Byte4Norm:  return 4;
         case VertexFormat::UByte4Norm: return 4;
+        case VertexFormat::Half2:      return 2;
+        case VertexFormat::Half4:      return 4;
+        case VertexFormat::Short2Norm: return 2;
+        case VertexFormat::Short4Norm: return 4;
+        case VertexFormat::Int10_10_10_2Norm: return 4;
     }
     return 0;
 }
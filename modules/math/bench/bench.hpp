@@ -0,0 +1,150 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+#endif
+
+//NOTE: Minimal micro-benchmark harness for cc_math_bench. Every case reports the best of a few
+//      timed samples in ns per operation: throughput runs the operation over independent inputs,
+//      latency feeds each result into the next call so only the dependency chain is measured.
+namespace cc::bench {
+
+//NOTE: keeps value alive and opaque to the optimizer without forcing it through memory first
+template<typename T>
+inline void do_not_optimize(const T& value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+    _ReadWriteBarrier();
+#endif
+}
+
+//NOTE: returns value unchanged, but the optimizer can no longer see what it is; goes through
+//      memory, so keep it out of timed loops
+template<typename T>
+[[nodiscard]] inline T opaque(T value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : "+m"(value));
+    return value;
+#else
+    volatile T copy = value;
+    return copy;
+#endif
+}
+
+struct options {
+    //NOTE: only cases whose "name/type" contains this substring run
+    std::string_view filter;
+    bool             csv{false};
+    double           min_sample_ms{10.0};
+    int              samples{5};
+};
+
+struct result {
+    std::string name;
+    std::string type;
+    double      throughput_ns{-1.0};
+    double      latency_ns{-1.0};
+};
+
+class suite {
+public:
+    explicit suite(options opts) noexcept : opts_(opts) {}
+
+    //NOTE: fn() performs ops operations per call; latency is left out for kernels where a
+    //      dependency chain is meaningless (e.g. batch calls)
+    template<typename Throughput>
+    void run(std::string_view name, std::string_view type, std::size_t ops, Throughput&& throughput) {
+        if (selected(name, type)) {
+            results_.push_back({std::string(name), std::string(type), measure(throughput, ops), -1.0});
+        }
+    }
+
+    template<typename Throughput, typename Latency>
+    void run(std::string_view name, std::string_view type, std::size_t ops,
+             Throughput&& throughput, Latency&& latency) {
+        if (selected(name, type)) {
+            results_.push_back({std::string(name), std::string(type),
+                                measure(throughput, ops), measure(latency, ops)});
+        }
+    }
+
+    void print() const {
+        if (opts_.csv) {
+            std::printf("name,type,throughput_ns,latency_ns\n");
+            for (const result& r : results_) {
+                std::printf("%s,%s,%.3f,%.3f\n", r.name.c_str(), r.type.c_str(), r.throughput_ns, r.latency_ns);
+            }
+            return;
+        }
+
+        std::printf("%-32s %-8s %14s %14s\n", "benchmark", "type", "throughput ns", "latency ns");
+        for (const result& r : results_) {
+            std::printf("%-32s %-8s %14.2f ", r.name.c_str(), r.type.c_str(), r.throughput_ns);
+            if (r.latency_ns >= 0.0) {
+                std::printf("%14.2f\n", r.latency_ns);
+            } else {
+                std::printf("%14s\n", "-");
+            }
+        }
+    }
+
+private:
+    [[nodiscard]] bool selected(std::string_view name, std::string_view type) const {
+        if (opts_.filter.empty()) {
+            return true;
+        }
+        std::string key(name);
+        key += '/';
+        key += type;
+        return key.find(opts_.filter) != std::string::npos;
+    }
+
+    template<typename Fn>
+    [[nodiscard]] double measure(Fn& fn, std::size_t ops) const {
+        using clock = std::chrono::steady_clock;
+
+        //NOTE: warm up and find a repeat count that fills one sample
+        std::size_t repeats = 1;
+        for (;;) {
+            const auto start = clock::now();
+            for (std::size_t r = 0; r < repeats; ++r) {
+                fn();
+            }
+            const double ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+            if (ms >= opts_.min_sample_ms || repeats >= (std::size_t{1} << 30)) {
+                break;
+            }
+            repeats *= ms > 0.0 ? std::clamp(static_cast<std::size_t>(opts_.min_sample_ms / ms) + 1,
+                                             std::size_t{2}, std::size_t{16})
+                                : 16;
+        }
+
+        double best = 0.0;
+        for (int s = 0; s < opts_.samples; ++s) {
+            const auto start = clock::now();
+            for (std::size_t r = 0; r < repeats; ++r) {
+                fn();
+            }
+            const double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+            const double per_op = ns / static_cast<double>(repeats * ops);
+            best = s == 0 ? per_op : std::min(best, per_op);
+        }
+        return best;
+    }
+
+    options             opts_;
+    std::vector<result> results_;
+};
+
+} // namespace cc::bench
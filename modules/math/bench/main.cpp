@@ -0,0 +1,632 @@
+#include "bench.hpp"
+
+#include <cc/math/math.hpp>
+#include "batch/kernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using namespace cc;
+
+//NOTE: enough elements to amortize the loop, few enough to stay in L1
+constexpr std::size_t Count = 256;
+
+template<typename T>
+struct type_name;
+
+template<>
+struct type_name<float> {
+    static constexpr std::string_view value = "float";
+};
+
+template<>
+struct type_name<double> {
+    static constexpr std::string_view value = "double";
+};
+
+template<typename T>
+struct inputs {
+    std::vector<vec<3, T>>    v3a, v3b;
+    std::vector<vec<4, T>>    v4;
+    std::vector<mat<4, 4, T>> m4a, m4b;
+    std::vector<quat<T>>      qa, qb;
+
+    explicit inputs(unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<T> dist(T{-1}, T{1});
+        const auto v3 = [&] { return vec<3, T>(dist(rng), dist(rng), dist(rng)); };
+        const auto rotation = [&] {
+            return quat<T>::from_axis_angle(v3() + vec<3, T>(T{0}, T{0}, T{2}), dist(rng) * T{3});
+        };
+
+        for (std::size_t i = 0; i < Count; ++i) {
+            v3a.push_back(v3());
+            v3b.push_back(v3());
+            v4.emplace_back(v3(), T{1});
+            m4a.push_back(translate(v3()) * rotation().to_mat4() * scale(T{1.5} + dist(rng) * T{0.5}));
+            m4b.push_back(translate(v3()) * rotation().to_mat4());
+            qa.push_back(rotation());
+            qb.push_back(rotation());
+        }
+    }
+};
+
+//NOTE: header paths, in whatever ISA this TU is compiled for
+template<typename T>
+void header_cases(bench::suite& s) {
+    const inputs<T> in(7);
+    const std::string_view type = type_name<T>::value;
+
+    std::vector<vec<3, T>>    v3(Count);
+    std::vector<vec<4, T>>    v4(Count);
+    std::vector<mat<4, 4, T>> m4(Count);
+    std::vector<quat<T>>      q(Count);
+
+    //NOTE: latency chains that would drift are kept bounded: unit vectors stay unit under
+    //      normalized() and rotations, cross with a unit vector perpendicular to v keeps |v|
+    const vec<3, T> axis = vec<3, T>(T{0}, T{0}, T{1});
+    const mat<4, 4, T> spin = in.m4b[0];
+
+    s.run("vec3::normalized", type, Count,
+        [&] {
+            for (std::size_t i = 0; i < Count; ++i) v3[i] = in.v3a[i].normalized();
+            bench::do_not_optimize(v3.data());
+        },
+        [&] {
+            vec<3, T> v = in.v3a[0];
+            for (std::size_t i = 0; i < Count; ++i) v = v.normalized();
+            bench::do_not_optimize(v);
+        });
+
+    s.run("vec3::cross", type, Count,
+        [&] {
+            for (std::size_t i = 0; i < Count; ++i) v3[i] = in.v3a[i].cross(in.v3b[i]);
+            bench::do_not_optimize(v3.data());
+        },
+        [&] {
+            vec<3, T> v(T{1}, T{0}, T{0});
+            for (std::size_t i = 0; i < Count; ++i) v = v.cross(axis);
+            bench::do_not_optimize(v);
+        });
+
+    //NOTE: operator== goes through approx_equal; it should stay branch-light
+    s.run("vec3::operator==", type, Count, [&] {
+        std::size_t equal = 0;
+        for (std::size_t i = 0; i < Count; ++i) equal += in.v3a[i] == in.v3b[i];
+        bench::do_not_optimize(equal);
+    });
+
+    s.run("mat4::operator*", type, Count,
+        [&] {
+            for (std::size_t i = 0; i < Count; ++i) m4[i] = in.m4a[i] * in.m4b[i];
+            bench::do_not_optimize(m4.data());
+        },
+        [&] {
+            mat<4, 4, T> m = in.m4a[0];
+            for (std::size_t i = 0; i < Count; ++i) m = m * spin;
+            bench::do_not_optimize(m);
+        });
+
+    s.run("mat4::inverse", type, Count,
+        [&] {
+            for (std::size_t i = 0; i < Count; ++i) m4[i] = in.m4a[i].inverse();
+            bench::do_not_optimize(m4.data());
+        },
+        [&] {
+            mat<4, 4, T> m = in.m4a[0];
+            for (std::size_t i = 0; i < Count; ++i) m = m.inverse();
+            bench::do_not_optimize(m);
+        });
+
+    s.run("mat4::inverse_affine", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) m4[i] = in.m4a[i].inverse_affine();
+        bench::do_not_optimize(m4.data());
+    });
+
+    s.run("mat4::operator==", type, Count, [&] {
+        std::size_t equal = 0;
+        for (std::size_t i = 0; i < Count; ++i) equal += in.m4a[i] == in.m4b[i];
+        bench::do_not_optimize(equal);
+    });
+
+    s.run("mat4 * vec4", type, Count,
+        [&] {
+            for (std::size_t i = 0; i < Count; ++i) v4[i] = in.m4a[0] * in.v4[i];
+            bench::do_not_optimize(v4.data());
+        },
+        [&] {
+            vec<4, T> v = in.v4[0];
+            for (std::size_t i = 0; i < Count; ++i) v = spin * v;
+            bench::do_not_optimize(v);
+        });
+
+    //NOTE: fused forms against the operator chains they replace: a per-object model matrix
+    //      under a shared view, and a physics-style position update
+    s.run("mat4 * mat4 * vec4", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) v4[i] = spin * in.m4a[i] * in.v4[i];
+        bench::do_not_optimize(v4.data());
+    });
+
+    s.run("mul(mat4, mat4, vec4)", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) v4[i] = mul(spin, in.m4a[i], in.v4[i]);
+        bench::do_not_optimize(v4.data());
+    });
+
+    s.run("vec4 * s + vec4", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) v4[i] = in.v4[i] * T{0.016} + v4[i];
+        bench::do_not_optimize(v4.data());
+    });
+
+    s.run("fma(vec4, s, vec4)", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) v4[i] = fma(in.v4[i], T{0.016}, v4[i]);
+        bench::do_not_optimize(v4.data());
+    });
+
+    //NOTE: the same rigid transforms as TRS: composing them against mat4::operator*, applying
+    //      them against mat4 * vec4 (one parent with uniform scale, as in a scene hierarchy)
+    std::vector<transform3<T>> ta(Count);
+    std::vector<transform3<T>> tb(Count);
+    std::vector<transform3<T>> tr(Count);
+    for (std::size_t i = 0; i < Count; ++i) {
+        ta[i] = decompose(in.m4a[i]);
+        tb[i] = decompose(in.m4b[i]);
+    }
+    s.run("transform3::operator*", type, Count,
+        [&] {
+            for (std::size_t i = 0; i < Count; ++i) tr[i] = ta[i] * tb[i];
+            bench::do_not_optimize(tr.data());
+        },
+        [&] {
+            transform3<T> t = ta[0];
+            for (std::size_t i = 0; i < Count; ++i) t = t * tb[0];
+            bench::do_not_optimize(t);
+        });
+
+    s.run("transform3::transform_point", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) v3[i] = ta[0].transform_point(in.v3a[i]);
+        bench::do_not_optimize(v3.data());
+    });
+
+    s.run("transform3::inverse", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) tr[i] = ta[i].inverse();
+        bench::do_not_optimize(tr.data());
+    });
+
+    s.run("transform3::to_mat4", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) m4[i] = ta[i].to_mat4();
+        bench::do_not_optimize(m4.data());
+    });
+
+    s.run("decompose(mat4)", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) tr[i] = decompose(in.m4a[i]);
+        bench::do_not_optimize(tr.data());
+    });
+
+    //NOTE: a 16-point centripetal path sampled Count times: Horner per point against forward
+    //      differencing, then the arc-length and closest-point queries
+    const spline<3, T> path = spline<3, T>::catmull_rom(std::span(in.v3a).first(16));
+    const arc_length_table<3, T> table(path);
+    const T spacing = static_cast<T>(path.size()) / static_cast<T>(Count - 1);
+    s.run("spline::evaluate", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) v3[i] = path.evaluate(static_cast<T>(i) * spacing);
+        bench::do_not_optimize(v3.data());
+    });
+
+    s.run("spline::sample", type, Count, [&] {
+        path.sample(v3);
+        bench::do_not_optimize(v3.data());
+    });
+
+    s.run("arc_length_table::parameter", type, Count, [&] {
+        T sum{};
+        for (std::size_t i = 0; i < Count; ++i) sum += table.parameter(static_cast<T>(i) * table.length() / T{Count});
+        bench::do_not_optimize(sum);
+    });
+
+    s.run("closest_point(spline)", type, Count, [&] {
+        T sum{};
+        for (std::size_t i = 0; i < Count; ++i) sum += closest_point(path, in.v3b[i]).parameter;
+        bench::do_not_optimize(sum);
+    });
+
+    //NOTE: slerp latency feeds the result back through t (one extra multiply-add), feeding it
+    //      back as an endpoint would converge and take the nlerp fallback
+    s.run("quat::slerp", type, Count,
+        [&] {
+            for (std::size_t i = 0; i < Count; ++i) q[i] = slerp(in.qa[i], in.qb[i], T{0.3});
+            bench::do_not_optimize(q.data());
+        },
+        [&] {
+            quat<T> r = in.qa[0];
+            for (std::size_t i = 0; i < Count; ++i) r = slerp(in.qa[0], in.qb[0], r.w * T{0.25} + T{0.5});
+            bench::do_not_optimize(r);
+        });
+
+    s.run("quat::fast_slerp", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) q[i] = fast_slerp(in.qa[i], in.qb[i], T{0.3});
+        bench::do_not_optimize(q.data());
+    });
+
+    s.run("quat::nlerp", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) q[i] = nlerp(in.qa[i], in.qb[i], T{0.3});
+        bench::do_not_optimize(q.data());
+    });
+
+    //NOTE: std and cc::fast side by side; the latency chains feed the result back as the argument
+    std::vector<T> angles(Count), xs(Count), ys(Count), out(Count);
+    for (std::size_t i = 0; i < Count; ++i) {
+        angles[i] = in.v3a[i].x * T{10};
+        xs[i]     = in.v3a[i].x;
+        ys[i]     = in.v3a[i].y;
+    }
+
+    s.run("std::sin", type, Count,
+        [&] {
+            for (std::size_t i = 0; i < Count; ++i) out[i] = std::sin(angles[i]);
+            bench::do_not_optimize(out.data());
+        },
+        [&] {
+            T x = angles[0];
+            for (std::size_t i = 0; i < Count; ++i) x = std::sin(x + T{1});
+            bench::do_not_optimize(x);
+        });
+
+    s.run("fast::sin", type, Count,
+        [&] {
+            for (std::size_t i = 0; i < Count; ++i) out[i] = fast::sin(angles[i]);
+            bench::do_not_optimize(out.data());
+        },
+        [&] {
+            T x = angles[0];
+            for (std::size_t i = 0; i < Count; ++i) x = fast::sin(x + T{1});
+            bench::do_not_optimize(x);
+        });
+
+    s.run("fast::sin<low>", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) out[i] = fast::sin<fast::precision::low>(angles[i]);
+        bench::do_not_optimize(out.data());
+    });
+
+    s.run("std::atan2", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) out[i] = std::atan2(ys[i], xs[i]);
+        bench::do_not_optimize(out.data());
+    });
+
+    s.run("fast::atan2", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) out[i] = fast::atan2(ys[i], xs[i]);
+        bench::do_not_optimize(out.data());
+    });
+
+    //NOTE: strided loads out of vec3s keep the loop scalar, which is most of the fast path's win
+    s.run("std::atan2 (vec3)", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) out[i] = std::atan2(in.v3a[i].y, in.v3a[i].x);
+        bench::do_not_optimize(out.data());
+    });
+
+    s.run("fast::atan2 (vec3)", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) out[i] = fast::atan2(in.v3a[i].y, in.v3a[i].x);
+        bench::do_not_optimize(out.data());
+    });
+
+    s.run("std::exp", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) out[i] = std::exp(angles[i]);
+        bench::do_not_optimize(out.data());
+    });
+
+    s.run("fast::exp", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) out[i] = fast::exp(angles[i]);
+        bench::do_not_optimize(out.data());
+    });
+
+    s.run("1 / std::sqrt", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) out[i] = T{1} / std::sqrt(angles[i] * angles[i] + T{1});
+        bench::do_not_optimize(out.data());
+    });
+
+    s.run("fast::rsqrt", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) out[i] = fast::rsqrt(angles[i] * angles[i] + T{1});
+        bench::do_not_optimize(out.data());
+    });
+
+    //NOTE: 3x3 decompositions of the scaled rotations in the upper-left blocks of m4a
+    std::vector<mat<3, 3, T>> m3(Count);
+    for (std::size_t i = 0; i < Count; ++i) {
+        for (std::size_t c = 0; c < 3; ++c) {
+            for (std::size_t r = 0; r < 3; ++r) {
+                m3[i](r, c) = in.m4a[i](r, c) + in.v3a[i][r] * T{0.25};
+            }
+        }
+    }
+    std::vector<svd_result<T>> svds(Count);
+    std::vector<polar_result<T>> polars(Count);
+
+    s.run("svd", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) svds[i] = svd(m3[i]);
+        bench::do_not_optimize(svds.data());
+    });
+
+    s.run("polar", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) polars[i] = polar(m3[i]);
+        bench::do_not_optimize(polars.data());
+    });
+
+    //NOTE: 4x4 systems with a dominant diagonal; spd = m^T * m + I for Cholesky, and 6x3
+    //      least-squares fits built from two stacked 3x3 blocks
+    std::vector<mat<4, 4, T>> sys(Count), spd(Count);
+    std::vector<mat<6, 3, T>> tall(Count);
+    std::vector<vec<4, T>> rhs(Count), x4(Count);
+    std::vector<vec<6, T>> rhs6(Count);
+    std::vector<vec<3, T>> x3(Count);
+    for (std::size_t i = 0; i < Count; ++i) {
+        sys[i] = in.m4a[i] + mat<4, 4, T>::identity() * T{4};
+        spd[i] = in.m4a[i].transpose() * in.m4a[i] + mat<4, 4, T>::identity();
+        for (std::size_t c = 0; c < 3; ++c) {
+            for (std::size_t r = 0; r < 3; ++r) {
+                tall[i](r, c) = m3[i](r, c);
+                tall[i](r + 3, c) = m3[i](c, r) + (r == c ? T{1} : T{0});
+            }
+        }
+        rhs[i] = vec<4, T>(in.v3a[i].x, in.v3a[i].y, in.v3a[i].z, T{1});
+        for (std::size_t r = 0; r < 6; ++r) rhs6[i][r] = in.v3a[i][r % 3] + T(r);
+    }
+
+    s.run("m4.inverse() * v", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) x4[i] = sys[i].inverse() * rhs[i];
+        bench::do_not_optimize(x4.data());
+    });
+
+    s.run("solve m4 (lu)", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) x4[i] = solve(*lu(sys[i]), rhs[i]);
+        bench::do_not_optimize(x4.data());
+    });
+
+    s.run("solve m4 (cholesky)", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) x4[i] = solve(*cholesky(spd[i]), rhs[i]);
+        bench::do_not_optimize(x4.data());
+    });
+
+    s.run("least_squares 6x3", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) x3[i] = *least_squares(tall[i], rhs6[i]);
+        bench::do_not_optimize(x3.data());
+    });
+
+    //NOTE: 2D constant-velocity trackers (state px, py, vx, vy; measured px, py), one
+    //      predict + update per element, as kalman_filter objects and as SoA batches
+    mat<4, 4, T> cv = mat<4, 4, T>::identity();
+    cv(0, 2) = T{1} / T{60};
+    cv(1, 3) = T{1} / T{60};
+    const mat<4, 4, T> process = mat<4, 4, T>::identity() * T{1e-3};
+    mat<2, 4, T> observe(T{0});
+    observe(0, 0) = T{1};
+    observe(1, 1) = T{1};
+    const mat<2, 2, T> noise = mat<2, 2, T>::identity() * T{1e-2};
+
+    std::vector<kalman_filter<4, 2, T>> trackers(Count);
+    s.run("kalman_filter 4/2", type, Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) {
+            trackers[i].predict(cv, process);
+            trackers[i].update(vec<2, T>(in.v3a[i].x, in.v3a[i].y), observe, noise);
+        }
+        bench::do_not_optimize(trackers.data());
+    });
+
+    std::vector<std::vector<T>> soa_columns(4 + 10 + 2, std::vector<T>(Count, T{0}));
+    kalman_soa<4, T> soa;
+    for (std::size_t i = 0; i < 4; ++i) soa.x[i] = soa_columns[i];
+    for (std::size_t i = 0; i < 10; ++i) soa.p[i] = soa_columns[4 + i];
+    for (std::size_t i = 0; i < 4; ++i) std::ranges::fill(soa.p[detail::packed_index(i, i)], T{1});
+    for (std::size_t i = 0; i < Count; ++i) {
+        soa_columns[14][i] = in.v3a[i].x;
+        soa_columns[15][i] = in.v3a[i].y;
+    }
+    const std::array<std::span<const T>, 2> measured{soa_columns[14], soa_columns[15]};
+    s.run("predict_many + update_many 4/2", type, Count, [&] {
+        predict_many(soa, cv, process);
+        bench::do_not_optimize(update_many(soa, measured, observe, noise));
+    });
+
+    //NOTE: the latency chains add element * 0 back into an input; the zero is opaque so the
+    //      chain cannot be folded away
+    const T zero = bench::opaque(T{0});
+    s.run("look_at", type, Count,
+        [&] {
+            for (std::size_t i = 0; i < Count; ++i) {
+                m4[i] = look_at(in.v3a[i] * T{5}, in.v3b[i], axis);
+            }
+            bench::do_not_optimize(m4.data());
+        },
+        [&] {
+            vec<3, T> eye = in.v3a[0] * T{5};
+            for (std::size_t i = 0; i < Count; ++i) {
+                const mat<4, 4, T> m = look_at(eye, in.v3b[0], axis);
+                eye.x += m.m03 * zero;
+            }
+            bench::do_not_optimize(eye);
+        });
+
+    s.run("perspective", type, Count,
+        [&] {
+            for (std::size_t i = 0; i < Count; ++i) {
+                m4[i] = perspective(T{1} + in.v3a[i].x * T{0.2}, T{16} / T{9}, T{0.1}, T{100});
+            }
+            bench::do_not_optimize(m4.data());
+        },
+        [&] {
+            T fovy = T{1};
+            for (std::size_t i = 0; i < Count; ++i) {
+                const mat<4, 4, T> m = perspective(fovy, T{16} / T{9}, T{0.1}, T{100});
+                fovy += m.m00 * zero;
+            }
+            bench::do_not_optimize(fovy);
+        });
+}
+
+//NOTE: cc::batch kernels per instruction set, float only; each call covers Count elements
+void batch_cases(bench::suite& s) {
+    const inputs<float> in(11);
+    std::vector<float> out(Count * 16);
+
+    const auto* v3 = reinterpret_cast<const float*>(in.v3a.data());
+    const auto* ma = reinterpret_cast<const float*>(in.m4a.data());
+    const auto* mb = reinterpret_cast<const float*>(in.m4b.data());
+    const auto* qa = reinterpret_cast<const float*>(in.qa.data());
+    const auto* qb = reinterpret_cast<const float*>(in.qb.data());
+    const float t  = 0.3f;
+
+    //NOTE: one octave of 2D simplex noise per sample
+    const noise::detail::fbm_desc noise_desc = noise::detail::make_desc(noise::kind::simplex, 2, {.octaves = 1});
+
+    //NOTE: baselines for the random fills: <random> and the one-at-a-time helpers
+    std::mt19937 mt(1);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    s.run("std::mt19937 uniform", "float", Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) out[i] = unit(mt);
+        bench::do_not_optimize(out.data());
+    });
+    random::xoshiro256pp xo(1);
+    s.run("random::uniform", "float", Count, [&] {
+        for (std::size_t i = 0; i < Count; ++i) out[i] = random::uniform(xo);
+        bench::do_not_optimize(out.data());
+    });
+    random::xoshiro256pp_x8 streams(1);
+    std::vector<float> factors(Count * 21);
+
+    //NOTE: 1000 correspondences, half of them on a homography (with noise), half random; one
+    //      thread so the rows compare across machines
+    std::vector<vec2f> src;
+    std::vector<vec2f> dst;
+    mat3f warp = mat3f::identity();
+    warp(0, 1) = 0.05f;
+    warp(0, 2) = 12.0f;
+    warp(1, 2) = -7.0f;
+    warp(2, 0) = 1e-4f;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        const vec2f p(random::uniform(xo, 0.0f, 640.0f), random::uniform(xo, 0.0f, 480.0f));
+        const vec3f q = warp * vec3f(p, 1.0f);
+        src.push_back(p);
+        dst.push_back(i % 2 == 0
+            ? vec2f(q.x / q.z + random::gaussian(xo, 0.0f, 0.3f), q.y / q.z + random::gaussian(xo, 0.0f, 0.3f))
+            : vec2f(random::uniform(xo, 0.0f, 640.0f), random::uniform(xo, 0.0f, 480.0f)));
+    }
+    s.run("vision::find_homography 1000/50%", "float", 1, [&] {
+        const auto found = vision::find_homography(src, dst, {.threshold = 2.0f, .threads = 1});
+        bench::do_not_optimize(found);
+    });
+
+    const std::array<const batch::detail::kernel_table*, 3> tables = {
+        &batch::detail::scalar_kernels(), batch::detail::sse_kernels(), batch::detail::avx2_kernels(),
+    };
+
+    for (const batch::detail::kernel_table* k : tables) {
+        //NOTE: skip tables not built in, or built for an ISA this CPU lacks
+        if (k == nullptr || (k->name == std::string_view("avx2") && batch::active_isa() != "avx2")) {
+            continue;
+        }
+
+        const std::string isa = std::string("/") + k->name;
+        s.run("batch::normalize_many" + isa, "float", Count, [&] {
+            k->normalize3(v3, out.data(), Count);
+            bench::do_not_optimize(out.data());
+        });
+        s.run("batch::transform_points" + isa, "float", Count, [&] {
+            k->transform3(ma, v3, out.data(), Count, 1.0f);
+            bench::do_not_optimize(out.data());
+        });
+        s.run("batch::multiply_matrices" + isa, "float", Count, [&] {
+            k->multiply4x4(ma, mb, out.data(), Count);
+            bench::do_not_optimize(out.data());
+        });
+        s.run("batch::slerp_many" + isa, "float", Count, [&] {
+            k->slerp_quat(qa, qb, &t, 0, out.data(), Count);
+            bench::do_not_optimize(out.data());
+        });
+        s.run("noise::fill_grid row" + isa, "float", Count, [&] {
+            k->noise_row(noise_desc, 0.5f, 0.01f, 1.25f, 0.0f, out.data(), Count);
+            bench::do_not_optimize(out.data());
+        });
+        //NOTE: the 4x4 inputs reinterpreted as 9-float matrices
+        s.run("batch::svd_many" + isa, "float", Count, [&] {
+            k->svd3(ma, factors.data(), factors.data() + Count * 9, factors.data() + Count * 12, Count);
+            bench::do_not_optimize(factors.data());
+        });
+        //NOTE: the 4x4 inputs' first column as the homography, vec3 components as coordinates
+        s.run("vision::score_homography" + isa, "float", Count, [&] {
+            const std::size_t inliers = k->score_homography(ma, v3, v3 + 1, v3 + 2, v3 + 3, Count, 0.25f, nullptr);
+            bench::do_not_optimize(inliers);
+        });
+        s.run("random::fill_uniform" + isa, "float", Count, [&] {
+            k->random_uniform(streams.state().data(), out.data(), Count, 0.0f, 1.0f);
+            bench::do_not_optimize(out.data());
+        });
+        s.run("random::fill_gaussian" + isa, "float", Count, [&] {
+            k->random_gaussian(streams.state().data(), out.data(), Count, 0.0f, 1.0f);
+            bench::do_not_optimize(out.data());
+        });
+        s.run("random::fill_unit_vectors" + isa, "float", Count, [&] {
+            k->random_unit3(streams.state().data(), out.data(), Count);
+            bench::do_not_optimize(out.data());
+        });
+    }
+}
+
+void print_usage() {
+    std::printf("usage: cc_math_bench [--filter=<substring>] [--csv] [--min-ms=<ms>] [--samples=<n>]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    cc::bench::options opts;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg.starts_with("--filter=")) {
+            opts.filter = arg.substr(9);
+        } else if (arg == "--csv") {
+            opts.csv = true;
+        } else if (arg.starts_with("--min-ms=")) {
+            opts.min_sample_ms = std::atof(argv[i] + 9);
+        } else if (arg.starts_with("--samples=")) {
+            opts.samples = std::max(1, std::atoi(argv[i] + 10));
+        } else {
+            print_usage();
+            return arg == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (!opts.csv) {
+        std::printf("header simd:");
+#if defined(CC_MATH_AVX2)
+        std::printf(" avx2");
+#endif
+#if defined(CC_MATH_FMA)
+        std::printf(" fma");
+#endif
+#if defined(CC_MATH_SSE41)
+        std::printf(" sse4.1");
+#endif
+#if defined(CC_MATH_SSE2)
+        std::printf(" sse2");
+#else
+        std::printf(" none");
+#endif
+        std::printf(", batch: %.*s\n\n", static_cast<int>(cc::batch::active_isa().size()),
+                    cc::batch::active_isa().data());
+    }
+
+    cc::bench::suite suite(opts);
+    header_cases<float>(suite);
+    header_cases<double>(suite);
+    batch_cases(suite);
+    suite.print();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "../vec/fwd.hpp"
+#include "../vec/base.hpp"
+#include "../vec/vec3.hpp"
+#include "../mat/fwd.hpp"
+#include "../mat/base.hpp"
+#include "../mat/mat3.hpp"
+#include "../mat/mat4.hpp"
+#include "../geometry/frustum.hpp"
+#include "../quat/quat.hpp"
+#include "../packing/packing.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+//NOTE: Batched kernels over many elements per call. Unlike the header-only operators, these
+//      live in cc_math and pick AVX2+FMA, SSE or scalar code once at runtime from the CPU, so
+//      they do not depend on the flags the caller is compiled with.
+//
+//      Input and output spans must have the same size. They may be the same span (in-place)
+//      but must not otherwise overlap.
+namespace cc::batch {
+
+//NOTE: out[i] = (m * vec4(in[i], 1)).xyz; the bottom row of m is ignored (affine transform)
+void transform_points(const mat<4, 4, float>& m,
+                      std::span<const vec<3, float>> in,
+                      std::span<vec<3, float>> out) noexcept;
+
+//NOTE: out[i] = (m * vec4(in[i], 0)).xyz; translation is ignored
+void transform_vectors(const mat<4, 4, float>& m,
+                       std::span<const vec<3, float>> in,
+                       std::span<vec<3, float>> out) noexcept;
+
+//NOTE: out[i] = a[i] * b[i]
+void multiply_matrices(std::span<const mat<4, 4, float>> a,
+                       std::span<const mat<4, 4, float>> b,
+                       std::span<mat<4, 4, float>> out) noexcept;
+
+//NOTE: out[i] = in[i].normalized(); zero-length vectors stay zero
+void normalize_many(std::span<const vec<3, float>> in,
+                    std::span<vec<3, float>> out) noexcept;
+
+void normalize_many(std::span<vec<3, float>> values) noexcept;
+
+//NOTE: Frustum culling over SoA bounds (e.g. SoaStorage columns), 8 elements per iteration on
+//      AVX2. visible needs (n + 63) / 64 words; bit i of word i / 64 is set when element i is
+//      (conservatively) inside, the other bits are cleared. Returns the number of visible
+//      elements.
+std::size_t cull_spheres(const frustum<float>& f,
+                         std::span<const float> x,
+                         std::span<const float> y,
+                         std::span<const float> z,
+                         std::span<const float> radius,
+                         std::span<std::uint64_t> visible) noexcept;
+
+//NOTE: boxes as center and half extents
+std::size_t cull_aabbs(const frustum<float>& f,
+                       std::span<const float> cx,
+                       std::span<const float> cy,
+                       std::span<const float> cz,
+                       std::span<const float> ex,
+                       std::span<const float> ey,
+                       std::span<const float> ez,
+                       std::span<std::uint64_t> visible) noexcept;
+
+//NOTE: Quaternion kernels for animation sampling. Inputs are unit quaternions and interpolation
+//      takes the shorter arc. slerp_many uses a trig-free polynomial (within 2e-5 rad of
+//      cc::slerp) and costs little more than nlerp_many; both take either one weight for all
+//      elements or one weight per element.
+void slerp_many(std::span<const quat<float>> a,
+                std::span<const quat<float>> b,
+                float t,
+                std::span<quat<float>> out) noexcept;
+
+void slerp_many(std::span<const quat<float>> a,
+                std::span<const quat<float>> b,
+                std::span<const float> t,
+                std::span<quat<float>> out) noexcept;
+
+void nlerp_many(std::span<const quat<float>> a,
+                std::span<const quat<float>> b,
+                float t,
+                std::span<quat<float>> out) noexcept;
+
+void nlerp_many(std::span<const quat<float>> a,
+                std::span<const quat<float>> b,
+                std::span<const float> t,
+                std::span<quat<float>> out) noexcept;
+
+//NOTE: out[i] = q.rotate(in[i]), or q[i].rotate(in[i]); q must be unit length
+void rotate_many(const quat<float>& q,
+                 std::span<const vec<3, float>> in,
+                 std::span<vec<3, float>> out) noexcept;
+
+void rotate_many(std::span<const quat<float>> q,
+                 std::span<const vec<3, float>> in,
+                 std::span<vec<3, float>> out) noexcept;
+
+//NOTE: out[i] = q[i].to_mat4()
+void quats_to_matrices(std::span<const quat<float>> q,
+                       std::span<mat<4, 4, float>> out) noexcept;
+
+//NOTE: Vertex attribute packing, bit-identical to the scalar functions in packing.hpp on every
+//      ISA. The padding w of 4-wide outputs is 0; unorm8x4 (colors) gets an alpha of 1. gfx
+//      formats: Half4, Short4Norm, UByte4Norm, Int10_10_10_2Norm and Short2Norm (octahedral).
+void pack_half4(std::span<const vec<3, float>> in,
+                std::span<std::array<half, 4>> out) noexcept;
+
+void pack_snorm16x4(std::span<const vec<3, float>> in,
+                    std::span<std::array<std::int16_t, 4>> out) noexcept;
+
+void pack_unorm8x4(std::span<const vec<3, float>> in,
+                   std::span<std::uint32_t> out) noexcept;
+
+void pack_snorm10_10_10_2(std::span<const vec<3, float>> in,
+                          std::span<std::uint32_t> out) noexcept;
+
+//NOTE: normals need not be normalized, see cc::oct_encode
+void pack_oct_snorm16(std::span<const vec<3, float>> normals,
+                      std::span<std::uint32_t> out) noexcept;
+
+//NOTE: 3x3 decompositions of many small matrices (e.g. per-cluster Kabsch, per-element
+//      deformation gradients), 4 or 8 at a time; the same algorithm as cc::svd, cc::polar and
+//      cc::eigen_symmetric in mat/decompose.hpp, see there for the conventions.
+//      m[i] = u[i] * diag(s[i]) * v[i]^T
+void svd_many(std::span<const mat<3, 3, float>> m,
+              std::span<mat<3, 3, float>> u,
+              std::span<vec<3, float>> s,
+              std::span<mat<3, 3, float>> v) noexcept;
+
+//NOTE: m[i] symmetric, m[i] = vectors[i] * diag(values[i]) * vectors[i]^T
+void eigen_symmetric_many(std::span<const mat<3, 3, float>> m,
+                          std::span<vec<3, float>> values,
+                          std::span<mat<3, 3, float>> vectors) noexcept;
+
+//NOTE: m[i] = r[i] * s[i]
+void polar_many(std::span<const mat<3, 3, float>> m,
+                std::span<mat<3, 3, float>> r,
+                std::span<mat<3, 3, float>> s) noexcept;
+
+//NOTE: instruction set the kernels were dispatched to: "avx2", "sse" or "scalar"
+[[nodiscard]] std::string_view active_isa() noexcept;
+
+} // namespace cc::batch
@@ -0,0 +1,298 @@
+#pragma once
+
+#include "../detail/arithmetic.hpp"
+#include "./constants.hpp"
+#include "./functions.hpp"
+#include "../simd/fwd.hpp"
+#include "../simd/simd.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <type_traits>
+
+//NOTE: Polynomial approximations of the common transcendental functions. Each one takes a float,
+//      a double or a cc::simd pack; the scalar versions are constexpr, so they also fill
+//      compile-time tables. Coefficients are minimax fits on the reduced range and target float
+//      accuracy; doubles run the same polynomials, so they are no more accurate than float.
+//
+//      Maximum error for float, measured over the whole supported range:
+//
+//                        precision::low      precision::high
+//      sin, cos          8e-5 abs            3e-7 abs            |x| < 2^16
+//      atan2             9e-5 rad            4e-7 rad
+//      exp               8e-5 rel            2e-7 rel            saturates outside [-87.3, 88.3]
+//      rsqrt             2e-3 rel            2e-7 rel            x > 0
+//
+//      Unlike std, NaN and infinity are not handled and signed zeros are not distinguished.
+//
+//      The functions are branch-free so that loops over arrays vectorize; that, not the scalar
+//      call, is where the speedup over std is (about 15x for float atan2 at -O3 with AVX2, barely
+//      any when the loop stays scalar). documentation.md has the measured figures.
+namespace cc::fast {
+
+enum class precision {
+    low,
+    high
+};
+
+namespace detail {
+
+template<typename V>
+struct scalar_of {
+    using type = V;
+};
+
+template<floating_point T, std::size_t W>
+struct scalar_of<simd<T, W>> {
+    using type = T;
+};
+
+template<typename V>
+using scalar_t = typename scalar_of<V>::type;
+
+template<typename V>
+concept value = floating_point<V> || simd_pack<V>;
+
+//NOTE: scalar counterparts of the cc::simd friends, so the kernels below are written once;
+//      select blends bits instead of branching, the conditions are data-dependent
+template<floating_point T>
+[[nodiscard]] constexpr T select(bool m, T a, T b) noexcept {
+    using bits = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+    const bits mask = bits{0} - static_cast<bits>(m);
+    return std::bit_cast<T>((std::bit_cast<bits>(a) & mask) | (std::bit_cast<bits>(b) & ~mask));
+}
+
+template<floating_point T>
+[[nodiscard]] constexpr T abs(T x) noexcept {
+    using bits = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+    return std::bit_cast<T>(std::bit_cast<bits>(x) & (~bits{0} >> 1));
+}
+
+template<floating_point T>
+[[nodiscard]] constexpr T madd(T a, T b, T c) noexcept {
+    return a * b + c;
+}
+
+template<floating_point T, std::size_t W>
+[[nodiscard]] simd<T, W> madd(const simd<T, W>& a, const simd<T, W>& b, const simd<T, W>& c) noexcept {
+    return fma(a, b, c);
+}
+
+//NOTE: 2^k for integral k within the normal exponent range
+template<floating_point T>
+[[nodiscard]] constexpr T exp2i(T k) noexcept {
+    if constexpr (sizeof(T) == 4) {
+        return std::bit_cast<T>(static_cast<std::uint32_t>(static_cast<std::int32_t>(k) + 127) << 23);
+    } else {
+        return std::bit_cast<T>(static_cast<std::uint64_t>(static_cast<std::int64_t>(k) + 1023) << 52);
+    }
+}
+
+template<floating_point T, std::size_t W>
+[[nodiscard]] simd<T, W> exp2i(const simd<T, W>& k) noexcept {
+    return simd<T, W>(cc::detail::simd::abi<T, W>::exp2i(k.reg()));
+}
+
+//NOTE: the hardware estimate where there is one, within 3.7e-4; otherwise (and in constant
+//      evaluation) a bit-level seed with Lomont's constants refined once, within 1.8e-3
+template<floating_point T>
+[[nodiscard]] constexpr T rsqrt_estimate(T x) noexcept {
+#if defined(CC_MATH_SSE2)
+    if !consteval {
+        if constexpr (sizeof(T) == 4) {
+            return _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+        }
+    }
+#endif
+    T y;
+    if constexpr (sizeof(T) == 4) {
+        y = std::bit_cast<T>(0x5f375a86u - (std::bit_cast<std::uint32_t>(x) >> 1));
+    } else {
+        y = std::bit_cast<T>(0x5fe6eb50c7b537a9ull - (std::bit_cast<std::uint64_t>(x) >> 1));
+    }
+    return y * (T{1.5} - T{0.5} * x * y * y);
+}
+
+template<floating_point T, std::size_t W>
+[[nodiscard]] simd<T, W> rsqrt_estimate(const simd<T, W>& x) noexcept {
+    return simd<T, W>(cc::detail::simd::abi<T, W>::rsqrt_estimate(x.reg()));
+}
+
+//NOTE: round to nearest by pushing the fraction out of the mantissa; exact for |x| < 2^22 (float)
+template<typename V>
+[[nodiscard]] constexpr V round(V x) noexcept {
+    using T = scalar_t<V>;
+    const V magic(sizeof(T) == 4 ? T{12582912.0} : T{6755399441055744.0});
+    return (x + magic) - magic;
+}
+
+template<typename V, typename... C>
+[[nodiscard]] constexpr V horner(V x, scalar_t<V> c0, C... cn) noexcept {
+    if constexpr (sizeof...(cn) == 0) {
+        return V(c0);
+    } else {
+        return madd(horner(x, cn...), x, V(c0));
+    }
+}
+
+//NOTE: x = k pi + r with r in [-pi / 2, pi / 2]; pi is split in three (Cody-Waite) with 8 and 9
+//      significant bits in the first two parts, so k * part stays exact for |k| < 2^15 without
+//      FMA. sign is (-1)^k, derived arithmetically so the scalar path has no branches.
+template<typename V>
+struct reduced {
+    V r;
+    V sign;
+};
+
+template<typename V>
+[[nodiscard]] constexpr reduced<V> reduce_pi(V x) noexcept {
+    using T = scalar_t<V>;
+    constexpr T hi  = T{3.140625};
+    constexpr T mid = T{507.0 / 524288.0};
+    constexpr T lo  = static_cast<T>(std::numbers::pi - 3.140625 - 507.0 / 524288.0);
+
+    const V k = round(x * V(std::numbers::inv_pi_v<T>));
+    const V r = madd(k, V(-lo), madd(k, V(-mid), madd(k, V(-hi), x)));
+
+    //NOTE: k / 2 - round(k / 2) is 0 for even k and +-0.5 for odd k
+    const V half_k = k * V(T{0.5});
+    return {r, V(T{1}) - V(T{4}) * abs(half_k - round(half_k))};
+}
+
+//NOTE: sin on [-pi / 2, pi / 2]
+template<precision P, typename V>
+[[nodiscard]] constexpr V sin_poly(V x) noexcept {
+    using T = scalar_t<V>;
+    const V x2 = x * x;
+    if constexpr (P == precision::low) {
+        return x * horner(x2, T{0.9996967731418842}, T{-0.16567307932686634}, T{0.007514377180238299});
+    } else {
+        return x * horner(x2, T{0.9999999765898828}, T{-0.1666664763464011}, T{0.00833289982335853},
+                          T{-0.0001980089776321234}, T{2.59048850135675e-06});
+    }
+}
+
+//NOTE: cos on [-pi / 2, pi / 2]; the constant term is pinned to 1 so cos(0) is exact
+template<precision P, typename V>
+[[nodiscard]] constexpr V cos_poly(V x) noexcept {
+    using T = scalar_t<V>;
+    const V x2 = x * x;
+    if constexpr (P == precision::low) {
+        return horner(x2, T{1}, T{-0.499935630731557}, T{0.0415070668512979}, T{-0.0012757519849069226});
+    } else {
+        return horner(x2, T{1}, T{-0.49999932293054106}, T{0.04166398945486036},
+                      T{-0.0013855927184659967}, T{2.3194386495944077e-05});
+    }
+}
+
+//NOTE: atan on [0, 1]
+template<precision P, typename V>
+[[nodiscard]] constexpr V atan_poly(V x) noexcept {
+    using T = scalar_t<V>;
+    const V x2 = x * x;
+    if constexpr (P == precision::low) {
+        return x * horner(x2, T{0.999213812570855}, T{-0.321174969310263}, T{0.1462644635953393},
+                          T{-0.03898651416383916});
+    } else {
+        return x * horner(x2, T{0.9999993355784415}, T{-0.3332986078478796}, T{0.19946565656989},
+                          T{-0.13908629580453596}, T{0.09642197410298994}, T{-0.055912327941030855},
+                          T{0.021862958714636446}, T{-0.004054567451646532});
+    }
+}
+
+//NOTE: exp on [-ln 2 / 2, ln 2 / 2], minimax in relative error
+template<precision P, typename V>
+[[nodiscard]] constexpr V exp_poly(V x) noexcept {
+    using T = scalar_t<V>;
+    if constexpr (P == precision::low) {
+        return horner(x, T{0.9999280735404956}, T{1.0001641857610948}, T{0.5049632641822398},
+                      T{0.16566842347964333});
+    } else {
+        return horner(x, T{1.0000000005541665}, T{1.0000000363231976}, T{0.49999992079816696},
+                      T{0.16666420169849686}, T{0.04166822556952568}, T{0.008374815804362865},
+                      T{0.0013836845990719037});
+    }
+}
+
+} // namespace detail
+
+template<typename V>
+struct sincos_result {
+    V sin;
+    V cos;
+};
+
+template<precision P = precision::high, typename V>
+    requires detail::value<V>
+[[nodiscard]] constexpr V sin(V x) noexcept {
+    const detail::reduced<V> k = detail::reduce_pi(x);
+    return k.sign * detail::sin_poly<P>(k.r);
+}
+
+template<precision P = precision::high, typename V>
+    requires detail::value<V>
+[[nodiscard]] constexpr V cos(V x) noexcept {
+    const detail::reduced<V> k = detail::reduce_pi(x);
+    return k.sign * detail::cos_poly<P>(k.r);
+}
+
+//NOTE: shares the range reduction between both results
+template<precision P = precision::high, typename V>
+    requires detail::value<V>
+[[nodiscard]] constexpr sincos_result<V> sincos(V x) noexcept {
+    const detail::reduced<V> k = detail::reduce_pi(x);
+    return {k.sign * detail::sin_poly<P>(k.r), k.sign * detail::cos_poly<P>(k.r)};
+}
+
+//NOTE: atan of the smaller over the larger magnitude, then mapped to the octant; atan2(0, 0) is 0
+template<precision P = precision::high, typename V>
+    requires detail::value<V>
+[[nodiscard]] constexpr V atan2(V y, V x) noexcept {
+    using T = detail::scalar_t<V>;
+    using detail::abs;
+    using detail::select;
+
+    const V ax = abs(x);
+    const V ay = abs(y);
+    const V hi = max(ax, ay);
+    const V lo = min(ax, ay);
+
+    V r = detail::atan_poly<P>(lo / select(hi > V(T{0}), hi, V(T{1})));
+    r = select(ay > ax, V(half_pi<T>) - r, r);
+    r = select(x < V(T{0}), V(pi<T>) - r, r);
+    return select(y < V(T{0}), -r, r);
+}
+
+//NOTE: 2^k * exp(f) with k = round(x / ln 2); ln 2 is split like pi in sin
+template<precision P = precision::high, typename V>
+    requires detail::value<V>
+[[nodiscard]] constexpr V exp(V x) noexcept {
+    using T = detail::scalar_t<V>;
+    constexpr T lo     = sizeof(T) == 4 ? T{-87.3} : T{-708.0};
+    constexpr T hi     = sizeof(T) == 4 ? T{88.3} : T{709.0};
+    constexpr T ln2_hi = T{0.693359375};
+    constexpr T ln2_lo = static_cast<T>(std::numbers::ln2 - 0.693359375);
+
+    const V c = min(max(x, V(lo)), V(hi));
+    const V k = detail::round(c * V(std::numbers::log2e_v<T>));
+    const V f = detail::madd(k, V(-ln2_lo), detail::madd(k, V(-ln2_hi), c));
+    return detail::exp_poly<P>(f) * detail::exp2i(k);
+}
+
+//NOTE: 1 / sqrt(x) for x > 0; high adds two Newton-Raphson steps to the estimate
+template<precision P = precision::high, typename V>
+    requires detail::value<V>
+[[nodiscard]] constexpr V rsqrt(V x) noexcept {
+    using T = detail::scalar_t<V>;
+    V y = detail::rsqrt_estimate(x);
+    if constexpr (P == precision::high) {
+        const V half_x = x * V(T{0.5});
+        y = y * (V(T{1.5}) - half_x * y * y);
+        y = y * (V(T{1.5}) - half_x * y * y);
+    }
+    return y;
+}
+
+} // namespace cc::fast
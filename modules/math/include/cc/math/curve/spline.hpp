@@ -0,0 +1,379 @@
+#pragma once
+
+#include "../detail/arithmetic.hpp"
+#include "../common/functions.hpp"
+#include "../common/constants.hpp"
+#include "../vec/base.hpp"
+#include "../vec/vec2.hpp"          // IWYU pragma: keep
+#include "../vec/vec3.hpp"          // IWYU pragma: keep
+#include "../vec/vec4.hpp"          // IWYU pragma: keep
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+//NOTE: Cubic curves over vec2/3/4: Bezier, Hermite and Catmull-Rom segments, all stored in the
+//      power basis so evaluation is one Horner chain and dense sampling is forward differencing
+//      (three adds per point and component). spline<N, T> chains segments with the global
+//      parameter u in [0, size()]; arc_length_table maps distance along the curve back to u,
+//      and closest_point() projects a point onto the curve.
+namespace cc {
+
+namespace detail {
+
+//NOTE: samples between exact re-evaluations in forward differencing; the accumulated error
+//      grows with the run length, restarting keeps it within a few ulps of the curve's extent
+inline constexpr std::size_t forward_difference_run = 64;
+
+} // namespace detail
+
+template<std::size_t N, floating_point T>
+struct cubic_segment {
+    using point = vec<N, T>;
+
+    //NOTE: p(t) = c[0] + c[1] t + c[2] t^2 + c[3] t^3, t in [0, 1]
+    std::array<point, 4> c{};
+
+    [[nodiscard]] static constexpr cubic_segment bezier(const point& p0, const point& p1,
+                                                        const point& p2, const point& p3) noexcept {
+        return {{p0, (p1 - p0) * T{3}, (p0 - p1 * T{2} + p2) * T{3}, p3 - p0 + (p1 - p2) * T{3}}};
+    }
+
+    //NOTE: from p0 with tangent m0 to p1 with tangent m1 (derivatives with respect to t)
+    [[nodiscard]] static constexpr cubic_segment hermite(const point& p0, const point& m0,
+                                                         const point& p1, const point& m1) noexcept {
+        return {{p0, m0, (p1 - p0) * T{3} - m0 * T{2} - m1, (p0 - p1) * T{2} + m0 + m1}};
+    }
+
+    //NOTE: the span from p1 to p2. alpha picks the knot spacing: 0 uniform, 0.5 centripetal
+    //      (no cusps or self-intersections within a segment), 1 chordal. Tangents follow Barry
+    //      and Goldman's pyramid, rescaled to the [0, 1] parameter of the segment
+    [[nodiscard]] static cubic_segment catmull_rom(const point& p0, const point& p1, const point& p2,
+                                                   const point& p3, T alpha = T{0.5}) noexcept {
+        const auto knot = [alpha](const point& a, const point& b) {
+            return max(pow((b - a).length_squared(), alpha * T{0.5}), epsilon<T>);
+        };
+        const T d01 = knot(p0, p1);
+        const T d12 = knot(p1, p2);
+        const T d23 = knot(p2, p3);
+        const point m1 = ((p1 - p0) / d01 - (p2 - p0) / (d01 + d12)) * d12 + (p2 - p1);
+        const point m2 = ((p3 - p2) / d23 - (p3 - p1) / (d12 + d23)) * d12 + (p2 - p1);
+        return hermite(p1, m1, p2, m2);
+    }
+
+    [[nodiscard]] constexpr point evaluate(T t) const noexcept {
+        return ((c[3] * t + c[2]) * t + c[1]) * t + c[0];
+    }
+
+    [[nodiscard]] constexpr point derivative(T t) const noexcept {
+        return (c[3] * (T{3} * t) + c[2] * T{2}) * t + c[1];
+    }
+
+    [[nodiscard]] constexpr point second_derivative(T t) const noexcept {
+        return c[3] * (T{6} * t) + c[2] * T{2};
+    }
+
+    //NOTE: out[i] = evaluate(t0 + i * step), by forward differencing
+    constexpr void sample(T t0, T step, std::span<point> out) const noexcept {
+        for (std::size_t first = 0; first < out.size(); first += detail::forward_difference_run) {
+            const std::size_t last = std::min(first + detail::forward_difference_run, out.size());
+            const T t = t0 + static_cast<T>(first) * step;
+
+            //NOTE: the polynomial re-centred on t: p(t + x) = p + d1 x + b2 x^2 + c3 x^3
+            const T h2 = step * step;
+            const T h3 = h2 * step;
+            const point b2 = c[3] * (T{3} * t) + c[2];
+            point p = evaluate(t);
+            point d1 = derivative(t) * step + b2 * h2 + c[3] * h3;
+            point d2 = b2 * (T{2} * h2) + c[3] * (T{6} * h3);
+            const point d3 = c[3] * (T{6} * h3);
+            for (std::size_t i = first; i < last; ++i) {
+                out[i] = p;
+                p += d1;
+                d1 += d2;
+                d2 += d3;
+            }
+        }
+    }
+
+    //NOTE: out.size() points evenly spaced in t over [0, 1]
+    constexpr void sample(std::span<point> out) const noexcept {
+        const T step = out.size() > 1 ? T{1} / static_cast<T>(out.size() - 1) : T{0};
+        sample(T{0}, step, out);
+    }
+};
+
+template<std::size_t N, floating_point T>
+class spline {
+public:
+    using point   = vec<N, T>;
+    using segment = cubic_segment<N, T>;
+
+    spline() = default;
+
+    explicit spline(std::vector<segment> segments) noexcept : segments_(std::move(segments)) {}
+
+    //NOTE: through every point, with phantom end points mirrored so the curve starts and ends
+    //      heading at its neighbours; at least 2 points
+    [[nodiscard]] static spline catmull_rom(std::span<const point> points, T alpha = T{0.5}) {
+        assert(points.size() >= 2);
+        const std::size_t n = points.size();
+        const auto at = [&](std::ptrdiff_t i) -> point {
+            if (i < 0) {
+                return points[0] * T{2} - points[1];
+            }
+            if (static_cast<std::size_t>(i) >= n) {
+                return points[n - 1] * T{2} - points[n - 2];
+            }
+            return points[static_cast<std::size_t>(i)];
+        };
+
+        std::vector<segment> segments;
+        segments.reserve(n - 1);
+        for (std::ptrdiff_t i = 0; i + 1 < static_cast<std::ptrdiff_t>(n); ++i) {
+            segments.push_back(segment::catmull_rom(at(i - 1), at(i), at(i + 1), at(i + 2), alpha));
+        }
+        return spline(std::move(segments));
+    }
+
+    //NOTE: 3k + 1 control points; consecutive segments share their end points
+    [[nodiscard]] static spline bezier(std::span<const point> control) {
+        assert(control.size() >= 4 && (control.size() - 1) % 3 == 0);
+        std::vector<segment> segments;
+        segments.reserve((control.size() - 1) / 3);
+        for (std::size_t i = 0; i + 3 < control.size(); i += 3) {
+            segments.push_back(segment::bezier(control[i], control[i + 1], control[i + 2], control[i + 3]));
+        }
+        return spline(std::move(segments));
+    }
+
+    //NOTE: one tangent per point, in units of the per-segment parameter
+    [[nodiscard]] static spline hermite(std::span<const point> points, std::span<const point> tangents) {
+        assert(points.size() >= 2 && tangents.size() == points.size());
+        std::vector<segment> segments;
+        segments.reserve(points.size() - 1);
+        for (std::size_t i = 0; i + 1 < points.size(); ++i) {
+            segments.push_back(segment::hermite(points[i], tangents[i], points[i + 1], tangents[i + 1]));
+        }
+        return spline(std::move(segments));
+    }
+
+    [[nodiscard]] std::span<const segment> segments() const noexcept { return segments_; }
+    [[nodiscard]] std::size_t size() const noexcept { return segments_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return segments_.empty(); }
+
+    //NOTE: u in [0, size()]; segment i covers [i, i + 1], u outside is clamped
+    [[nodiscard]] point evaluate(T u) const noexcept {
+        const auto [i, t] = locate(u);
+        return segments_[i].evaluate(t);
+    }
+
+    [[nodiscard]] point derivative(T u) const noexcept {
+        const auto [i, t] = locate(u);
+        return segments_[i].derivative(t);
+    }
+
+    //NOTE: out.size() points evenly spaced in u over [0, size()], forward differenced per segment
+    void sample(std::span<point> out) const noexcept {
+        assert(!empty());
+        if (out.size() < 2) {
+            if (!out.empty()) {
+                out[0] = segments_[0].evaluate(T{0});
+            }
+            return;
+        }
+
+        const std::size_t intervals = out.size() - 1;
+        const std::size_t count = size();
+        const T step = static_cast<T>(count) / static_cast<T>(intervals);
+        std::size_t first = 0;
+        for (std::size_t s = 0; s < count; ++s) {
+            //NOTE: samples i with i * count / intervals in [s, s + 1); the last segment takes u = size()
+            const std::size_t last = s + 1 == count ? out.size() : ((s + 1) * intervals + count - 1) / count;
+            if (last > first) {
+                const T t0 = static_cast<T>(first) * step - static_cast<T>(s);
+                segments_[s].sample(t0, step, out.subspan(first, last - first));
+            }
+            first = last;
+        }
+    }
+
+private:
+    [[nodiscard]] std::pair<std::size_t, T> locate(T u) const noexcept {
+        assert(!empty());
+        const T last = static_cast<T>(size());
+        u = clamp(u, T{0}, last);
+        const std::size_t i = std::min(static_cast<std::size_t>(u), size() - 1);
+        return {i, u - static_cast<T>(i)};
+    }
+
+    std::vector<segment> segments_;
+};
+
+//NOTE: cumulative arc length at evenly spaced u (Gauss-Legendre on each step), inverted with a
+//      monotone cubic in s whose end slopes are the inverse speeds, so parameter() needs neither
+//      the curve nor iteration. The error falls with the fourth power of the step count: on a
+//      smooth centripetal path u is within about 2e-4 of the exact inverse at 16 steps per
+//      segment and 1e-6 at 64
+template<std::size_t N, floating_point T>
+class arc_length_table {
+public:
+    using point = vec<N, T>;
+
+    explicit arc_length_table(const spline<N, T>& curve, std::size_t steps_per_segment = 16)
+        : step_(T{1} / static_cast<T>(steps_per_segment)) {
+        assert(!curve.empty() && steps_per_segment > 0);
+        //NOTE: 3-point Gauss-Legendre nodes and weights on [0, 1]
+        const T offset = sqrt(T{0.15});
+        const std::array<T, 3> nodes{T{0.5} - offset, T{0.5}, T{0.5} + offset};
+        const std::array<T, 3> weights{T{5} / T{18}, T{8} / T{18}, T{5} / T{18}};
+
+        const std::size_t count = curve.size() * steps_per_segment;
+        lengths_.reserve(count + 1);
+        speeds_.reserve(count * 2);
+        T total = T{0};
+        for (const cubic_segment<N, T>& segment : curve.segments()) {
+            for (std::size_t k = 0; k < steps_per_segment; ++k) {
+                const T t = static_cast<T>(k) * step_;
+                lengths_.push_back(total);
+                speeds_.push_back(segment.derivative(t).length());
+                speeds_.push_back(segment.derivative(t + step_).length());
+                T piece = T{0};
+                for (std::size_t g = 0; g < 3; ++g) {
+                    piece += weights[g] * segment.derivative(t + nodes[g] * step_).length();
+                }
+                total += piece * step_;
+            }
+        }
+        lengths_.push_back(total);
+    }
+
+    [[nodiscard]] T length() const noexcept { return lengths_.back(); }
+
+    //NOTE: the u at which the arc length from the start reaches s; s is clamped to [0, length()]
+    [[nodiscard]] T parameter(T s) const noexcept {
+        s = clamp(s, T{0}, length());
+        const auto it = std::upper_bound(lengths_.begin(), lengths_.end(), s);
+        const std::size_t k = std::min(static_cast<std::size_t>(it - lengths_.begin()), lengths_.size() - 1) - 1;
+        const T u0 = static_cast<T>(k) * step_;
+        const T ds = lengths_[k + 1] - lengths_[k];
+        if (!(ds > T{0})) {
+            return u0;
+        }
+
+        //NOTE: cubic Hermite u(s) with du/ds = 1 / speed at the ends, capped at three times the
+        //      secant (Fritsch-Carlson) so u stays monotone through near-cusps
+        const T x = (s - lengths_[k]) / ds;
+        const T limit = T{3} * step_;
+        const T v0 = speeds_[k * 2];
+        const T v1 = speeds_[k * 2 + 1];
+        const T m0 = v0 * limit > ds ? ds / v0 : limit;
+        const T m1 = v1 * limit > ds ? ds / v1 : limit;
+        const T x2 = x * x;
+        const T x3 = x2 * x;
+        return u0 + (x3 - T{2} * x2 + x) * m0 + (T{3} * x2 - T{2} * x3) * step_ + (x3 - x2) * m1;
+    }
+
+    //NOTE: out.size() points evenly spaced along the curve, from its start to its end
+    void sample(const spline<N, T>& curve, std::span<point> out) const noexcept {
+        const T spacing = out.size() > 1 ? length() / static_cast<T>(out.size() - 1) : T{0};
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            out[i] = curve.evaluate(parameter(static_cast<T>(i) * spacing));
+        }
+    }
+
+private:
+    T step_;
+    std::vector<T> lengths_;
+    //NOTE: |p'| at both ends of each step; the speed jumps at the joins of non-uniform
+    //      Catmull-Rom and of Hermite segments with mismatched tangents
+    std::vector<T> speeds_;
+};
+
+template<std::size_t N, floating_point T>
+struct curve_point {
+    T         parameter;
+    vec<N, T> point;
+    T         distance2;
+};
+
+namespace detail {
+
+//NOTE: squared distance from q to the bounding box of the segment's Bezier control points, a
+//      lower bound for its distance to the curve (convex hull property)
+template<std::size_t N, floating_point T>
+[[nodiscard]] constexpr T hull_distance2(const cubic_segment<N, T>& segment, const vec<N, T>& q) noexcept {
+    const vec<N, T> b0 = segment.c[0];
+    const vec<N, T> b1 = b0 + segment.c[1] / T{3};
+    const vec<N, T> b2 = b1 + (segment.c[1] + segment.c[2]) / T{3};
+    const vec<N, T> b3 = b0 + segment.c[1] + segment.c[2] + segment.c[3];
+    T d2 = T{0};
+    for (std::size_t i = 0; i < N; ++i) {
+        const T lo = min(min(b0[i], b1[i]), min(b2[i], b3[i]));
+        const T hi = max(max(b0[i], b1[i]), max(b2[i], b3[i]));
+        const T d = max(max(lo - q[i], q[i] - hi), T{0});
+        d2 += d * d;
+    }
+    return d2;
+}
+
+} // namespace detail
+
+//NOTE: the point of the curve nearest to q: per segment, the best of 9 evenly spaced samples
+//      refined by Newton steps on (p(t) - q) . p'(t) = 0 within [0, 1]; segments whose control
+//      points are all farther than the best so far are skipped. A segment whose curve passes
+//      near q twice between samples can report the farther foot point
+template<std::size_t N, floating_point T>
+[[nodiscard]] curve_point<N, T> closest_point(const spline<N, T>& curve, const vec<N, T>& q) noexcept {
+    assert(!curve.empty());
+    constexpr std::size_t Samples = 9;
+    constexpr int NewtonSteps = 4;
+
+    curve_point<N, T> best{T{0}, curve.segments()[0].c[0], (curve.segments()[0].c[0] - q).length_squared()};
+    std::array<vec<N, T>, Samples> coarse;
+    for (std::size_t s = 0; s < curve.size(); ++s) {
+        const cubic_segment<N, T>& segment = curve.segments()[s];
+        if (detail::hull_distance2(segment, q) >= best.distance2) {
+            continue;
+        }
+        segment.sample(coarse);
+        std::size_t nearest = 0;
+        T nearest2 = (coarse[0] - q).length_squared();
+        for (std::size_t i = 1; i < Samples; ++i) {
+            const T d2 = (coarse[i] - q).length_squared();
+            if (d2 < nearest2) {
+                nearest = i;
+                nearest2 = d2;
+            }
+        }
+
+        T t = static_cast<T>(nearest) / static_cast<T>(Samples - 1);
+        for (int step = 0; step < NewtonSteps; ++step) {
+            const vec<N, T> e  = segment.evaluate(t) - q;
+            const vec<N, T> d  = segment.derivative(t);
+            const T slope = d.length_squared() + e.dot(segment.second_derivative(t));
+            if (!(slope > T{0})) {
+                break;
+            }
+            t = clamp(t - e.dot(d) / slope, T{0}, T{1});
+        }
+
+        const vec<N, T> p = segment.evaluate(t);
+        const T d2 = (p - q).length_squared();
+        if (d2 < nearest2) {
+            nearest2 = d2;
+        } else {
+            t = static_cast<T>(nearest) / static_cast<T>(Samples - 1);
+        }
+        if (nearest2 < best.distance2) {
+            best = {static_cast<T>(s) + t, segment.evaluate(t), nearest2};
+        }
+    }
+    return best;
+}
+
+} // namespace cc
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+//NOTE: Lane types for the kernels that are written once and instantiated both in the headers and
+//      in the cc::batch kernel TUs (noise/lattice.hpp, random/sampling.hpp). A lane provides a
+//      float type f, a uint32 type u, a mask type m and the operations below as static members;
+//      f and u also support the usual arithmetic and bitwise operators. The ISA TUs define their
+//      own lanes in an anonymous namespace, so no template is ever instantiated with the same
+//      arguments under different compiler flags; they must not use scalar_lane.
+//
+//      basic_scalar_lane<double> pairs double with uint64; it serves the kernels that also run on
+//      mat3d and friends and is never instantiated in the ISA TUs either.
+namespace cc::detail {
+
+template<typename F>
+struct basic_scalar_lane {
+    using f = F;
+    using u = std::conditional_t<sizeof(F) == 4, std::uint32_t, std::uint64_t>;
+    using m = bool;
+    using s = std::conditional_t<sizeof(F) == 4, std::int32_t, std::int64_t>;
+
+    [[nodiscard]] static f floor(f x) noexcept { return std::floor(x); }
+    [[nodiscard]] static f sqrt(f x) noexcept { return std::sqrt(x); }
+    [[nodiscard]] static f max(f a, f b) noexcept { return a < b ? b : a; }
+
+    //NOTE: two's complement of the (integral) value
+    [[nodiscard]] static u to_u(f x) noexcept { return static_cast<u>(static_cast<s>(x)); }
+    //NOTE: for values below 2^31
+    [[nodiscard]] static f to_f(u x) noexcept { return static_cast<f>(static_cast<s>(x)); }
+    [[nodiscard]] static u as_u(f x) noexcept { return std::bit_cast<u>(x); }
+    [[nodiscard]] static f as_f(u x) noexcept { return std::bit_cast<f>(x); }
+
+    [[nodiscard]] static m gt(f a, f b) noexcept { return a > b; }
+    [[nodiscard]] static m ge(f a, f b) noexcept { return a >= b; }
+    //NOTE: for values below 2^31
+    [[nodiscard]] static m lt(u a, u b) noexcept { return a < b; }
+    //NOTE: b is a single bit
+    [[nodiscard]] static m bit(u a, u b) noexcept { return (a & b) != 0; }
+
+    [[nodiscard]] static m mask_and(m a, m b) noexcept { return a && b; }
+    [[nodiscard]] static m mask_or(m a, m b) noexcept { return a || b; }
+    [[nodiscard]] static m mask_not(m a) noexcept { return !a; }
+
+    //NOTE: blends bits instead of branching, the conditions are data-dependent
+    [[nodiscard]] static u select(m c, u a, u b) noexcept {
+        const u mask = u{0} - static_cast<u>(c);
+        return (a & mask) | (b & ~mask);
+    }
+    [[nodiscard]] static f select(m c, f a, f b) noexcept {
+        return std::bit_cast<f>(select(c, std::bit_cast<u>(a), std::bit_cast<u>(b)));
+    }
+};
+
+using scalar_lane = basic_scalar_lane<float>;
+
+} // namespace cc::detail
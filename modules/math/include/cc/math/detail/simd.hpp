@@ -0,0 +1,420 @@
+#pragma once
+
+#include <concepts>
+
+//NOTE: Compile-time SIMD selection. Paths follow the flags the including TU is built with
+//      (-msse4.1, -mavx2, /arch:AVX2, ...); define CC_MATH_NO_SIMD to force the scalar code.
+#if !defined(CC_MATH_NO_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define CC_MATH_SSE2 1
+    #endif
+    #if defined(__SSE4_1__) || (defined(_MSC_VER) && defined(__AVX__))
+        #define CC_MATH_SSE41 1
+    #endif
+    #if defined(__AVX__)
+        #define CC_MATH_AVX 1
+    #endif
+    #if defined(__AVX2__)
+        #define CC_MATH_AVX2 1
+    #endif
+    #if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))
+        #define CC_MATH_FMA 1
+    #endif
+#endif
+
+#if defined(CC_MATH_AVX)
+    #include <immintrin.h>
+#elif defined(CC_MATH_SSE41)
+    #include <smmintrin.h>
+#elif defined(CC_MATH_SSE2)
+    #include <emmintrin.h>
+#endif
+
+namespace cc::detail::simd {
+
+//NOTE: which element types have a 4-wide register path (float: SSE, double: AVX)
+template<typename T>
+inline constexpr bool has_x4 =
+#if defined(CC_MATH_SSE2)
+    std::same_as<T, float> ||
+#endif
+#if defined(CC_MATH_AVX)
+    std::same_as<T, double> ||
+#endif
+    false;
+
+//NOTE: deleted generic overloads keep the kernel names declared when a path is compiled out;
+//      callers only reach them through branches discarded by `if constexpr (has_x4<T>)`.
+template<typename T> void add4(const T*, const T*, T*) = delete;
+template<typename T> void sub4(const T*, const T*, T*) = delete;
+template<typename T> void mul4(const T*, const T*, T*) = delete;
+template<typename T> void div4(const T*, const T*, T*) = delete;
+template<typename T> void scale4(const T*, T, T*) = delete;
+template<typename T> void divs4(const T*, T, T*) = delete;
+template<typename T> void madd4(const T*, const T*, const T*, T*) = delete;
+template<typename T> void madds4(const T*, T, const T*, T*) = delete;
+template<typename T> T dot4(const T*, const T*) = delete;
+template<typename T> void mul_mat4(const T*, const T*, T*) = delete;
+template<typename T> void mul_mat4_vec4(const T*, const T*, T*) = delete;
+template<typename T> void transpose_mat4(const T*, T*) = delete;
+template<typename T> bool inverse_mat4(const T*, T*) = delete;
+template<typename T> bool inverse_affine_mat4(const T*, T*) = delete;
+template<typename T> void inverse_rigid_mat4(const T*, T*) = delete;
+
+//NOTE: all pointers below must be aligned to 4 * sizeof(T); vec<4, T> and mat<4, 4, T> are.
+
+#if defined(CC_MATH_SSE2)
+
+[[nodiscard]] inline __m128 madd(__m128 a, __m128 b, __m128 c) noexcept {
+#if defined(CC_MATH_FMA)
+    return _mm_fmadd_ps(a, b, c);
+#else
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+template<int Lane>
+[[nodiscard]] inline __m128 splat(__m128 v) noexcept {
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(Lane, Lane, Lane, Lane));
+}
+
+inline void add4(const float* a, const float* b, float* out) noexcept {
+    _mm_store_ps(out, _mm_add_ps(_mm_load_ps(a), _mm_load_ps(b)));
+}
+
+inline void sub4(const float* a, const float* b, float* out) noexcept {
+    _mm_store_ps(out, _mm_sub_ps(_mm_load_ps(a), _mm_load_ps(b)));
+}
+
+inline void mul4(const float* a, const float* b, float* out) noexcept {
+    _mm_store_ps(out, _mm_mul_ps(_mm_load_ps(a), _mm_load_ps(b)));
+}
+
+inline void div4(const float* a, const float* b, float* out) noexcept {
+    _mm_store_ps(out, _mm_div_ps(_mm_load_ps(a), _mm_load_ps(b)));
+}
+
+inline void scale4(const float* a, float s, float* out) noexcept {
+    _mm_store_ps(out, _mm_mul_ps(_mm_load_ps(a), _mm_set1_ps(s)));
+}
+
+inline void divs4(const float* a, float s, float* out) noexcept {
+    _mm_store_ps(out, _mm_div_ps(_mm_load_ps(a), _mm_set1_ps(s)));
+}
+
+//NOTE: out = a * b + c, one rounding when built with FMA
+inline void madd4(const float* a, const float* b, const float* c, float* out) noexcept {
+    _mm_store_ps(out, madd(_mm_load_ps(a), _mm_load_ps(b), _mm_load_ps(c)));
+}
+
+inline void madds4(const float* a, float s, const float* c, float* out) noexcept {
+    _mm_store_ps(out, madd(_mm_load_ps(a), _mm_set1_ps(s), _mm_load_ps(c)));
+}
+
+[[nodiscard]] inline float dot4(const float* a, const float* b) noexcept {
+#if defined(CC_MATH_SSE41)
+    return _mm_cvtss_f32(_mm_dp_ps(_mm_load_ps(a), _mm_load_ps(b), 0xF1));
+#else
+    const __m128 m  = _mm_mul_ps(_mm_load_ps(a), _mm_load_ps(b));
+    const __m128 s1 = _mm_add_ps(m, _mm_movehl_ps(m, m));
+    const __m128 s2 = _mm_add_ss(s1, _mm_shuffle_ps(s1, s1, _MM_SHUFFLE(1, 1, 1, 1)));
+    return _mm_cvtss_f32(s2);
+#endif
+}
+
+[[nodiscard]] inline __m128 combine4(__m128 a0, __m128 a1, __m128 a2, __m128 a3, __m128 w) noexcept {
+    __m128 r = _mm_mul_ps(a0, splat<0>(w));
+    r = madd(a1, splat<1>(w), r);
+    r = madd(a2, splat<2>(w), r);
+    return madd(a3, splat<3>(w), r);
+}
+
+//NOTE: column-major: out.col[j] = sum_k a.col[k] * b(k, j); all columns are computed before
+//      any store so out may alias a or b
+inline void mul_mat4(const float* a, const float* b, float* out) noexcept {
+    const __m128 a0 = _mm_load_ps(a);
+    const __m128 a1 = _mm_load_ps(a + 4);
+    const __m128 a2 = _mm_load_ps(a + 8);
+    const __m128 a3 = _mm_load_ps(a + 12);
+
+    const __m128 r0 = combine4(a0, a1, a2, a3, _mm_load_ps(b));
+    const __m128 r1 = combine4(a0, a1, a2, a3, _mm_load_ps(b + 4));
+    const __m128 r2 = combine4(a0, a1, a2, a3, _mm_load_ps(b + 8));
+    const __m128 r3 = combine4(a0, a1, a2, a3, _mm_load_ps(b + 12));
+
+    _mm_store_ps(out, r0);
+    _mm_store_ps(out + 4, r1);
+    _mm_store_ps(out + 8, r2);
+    _mm_store_ps(out + 12, r3);
+}
+
+//NOTE: v is broadcast per element instead of loaded as a vector: it is usually built from
+//      scalars right before the call, and a 16-byte load of it would stall on store forwarding
+inline void mul_mat4_vec4(const float* m, const float* v, float* out) noexcept {
+    __m128 r = _mm_mul_ps(_mm_load_ps(m), _mm_set1_ps(v[0]));
+    r = madd(_mm_load_ps(m + 4),  _mm_set1_ps(v[1]), r);
+    r = madd(_mm_load_ps(m + 8),  _mm_set1_ps(v[2]), r);
+    r = madd(_mm_load_ps(m + 12), _mm_set1_ps(v[3]), r);
+    _mm_store_ps(out, r);
+}
+
+inline void transpose_mat4(const float* m, float* out) noexcept {
+    __m128 c0 = _mm_load_ps(m);
+    __m128 c1 = _mm_load_ps(m + 4);
+    __m128 c2 = _mm_load_ps(m + 8);
+    __m128 c3 = _mm_load_ps(m + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    _mm_store_ps(out, c0);
+    _mm_store_ps(out + 4, c1);
+    _mm_store_ps(out + 8, c2);
+    _mm_store_ps(out + 12, c3);
+}
+
+template<int X, int Y, int Z, int W>
+[[nodiscard]] inline __m128 swizzle(__m128 v) noexcept {
+    return _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(v), _MM_SHUFFLE(W, Z, Y, X)));
+}
+
+template<int X, int Y, int Z, int W>
+[[nodiscard]] inline __m128 shuffle(__m128 a, __m128 b) noexcept {
+    return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+}
+
+//NOTE: 2x2 blocks packed as (m00, m01, m10, m11): a * b, adj(a) * b and a * adj(b)
+[[nodiscard]] inline __m128 mat2_mul(__m128 a, __m128 b) noexcept {
+    return _mm_add_ps(_mm_mul_ps(a, swizzle<0, 3, 0, 3>(b)),
+                      _mm_mul_ps(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+}
+
+[[nodiscard]] inline __m128 mat2_adj_mul(__m128 a, __m128 b) noexcept {
+    return _mm_sub_ps(_mm_mul_ps(swizzle<3, 3, 0, 0>(a), b),
+                      _mm_mul_ps(swizzle<1, 1, 2, 2>(a), swizzle<2, 3, 0, 1>(b)));
+}
+
+[[nodiscard]] inline __m128 mat2_mul_adj(__m128 a, __m128 b) noexcept {
+    return _mm_sub_ps(_mm_mul_ps(a, swizzle<3, 0, 3, 0>(b)),
+                      _mm_mul_ps(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+}
+
+//NOTE: block-wise inverse over the four 2x2 sub-matrices. Works on columns as if they were
+//      rows, which is fine since inverse(transpose(m)) == transpose(inverse(m)).
+//      Returns false and leaves out untouched when |det| <= epsilon.
+inline bool inverse_mat4(const float* m, float* out) noexcept {
+    const __m128 c0 = _mm_load_ps(m);
+    const __m128 c1 = _mm_load_ps(m + 4);
+    const __m128 c2 = _mm_load_ps(m + 8);
+    const __m128 c3 = _mm_load_ps(m + 12);
+
+    const __m128 a = _mm_movelh_ps(c0, c1);
+    const __m128 b = _mm_movehl_ps(c1, c0);
+    const __m128 c = _mm_movelh_ps(c2, c3);
+    const __m128 d = _mm_movehl_ps(c3, c2);
+
+    //NOTE: (|A|, |B|, |C|, |D|)
+    const __m128 det_sub = _mm_sub_ps(
+        _mm_mul_ps(shuffle<0, 2, 0, 2>(c0, c2), shuffle<1, 3, 1, 3>(c1, c3)),
+        _mm_mul_ps(shuffle<1, 3, 1, 3>(c0, c2), shuffle<0, 2, 0, 2>(c1, c3)));
+    const __m128 det_a = splat<0>(det_sub);
+    const __m128 det_b = splat<1>(det_sub);
+    const __m128 det_c = splat<2>(det_sub);
+    const __m128 det_d = splat<3>(det_sub);
+
+    const __m128 d_c = mat2_adj_mul(d, c);
+    const __m128 a_b = mat2_adj_mul(a, b);
+
+    __m128 x = _mm_sub_ps(_mm_mul_ps(det_d, a), mat2_mul(b, d_c));
+    __m128 w = _mm_sub_ps(_mm_mul_ps(det_a, d), mat2_mul(c, a_b));
+    __m128 y = _mm_sub_ps(_mm_mul_ps(det_b, c), mat2_mul_adj(d, a_b));
+    __m128 z = _mm_sub_ps(_mm_mul_ps(det_c, b), mat2_mul_adj(a, d_c));
+
+    //NOTE: |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+    __m128 tr = _mm_mul_ps(a_b, swizzle<0, 2, 1, 3>(d_c));
+    tr = _mm_add_ps(tr, _mm_movehl_ps(tr, tr));
+    tr = _mm_add_ss(tr, splat<1>(tr));
+    const float det = _mm_cvtss_f32(det_a) * _mm_cvtss_f32(det_d) +
+                      _mm_cvtss_f32(det_b) * _mm_cvtss_f32(det_c) - _mm_cvtss_f32(tr);
+    if (!(det > 1.19209290e-7f || det < -1.19209290e-7f)) {
+        return false;
+    }
+
+    const __m128 r_det = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), _mm_set1_ps(det));
+    x = _mm_mul_ps(x, r_det);
+    y = _mm_mul_ps(y, r_det);
+    z = _mm_mul_ps(z, r_det);
+    w = _mm_mul_ps(w, r_det);
+
+    _mm_store_ps(out,      shuffle<3, 1, 3, 1>(x, y));
+    _mm_store_ps(out + 4,  shuffle<2, 0, 2, 0>(x, y));
+    _mm_store_ps(out + 8,  shuffle<3, 1, 3, 1>(z, w));
+    _mm_store_ps(out + 12, shuffle<2, 0, 2, 0>(z, w));
+    return true;
+}
+
+[[nodiscard]] inline __m128 cross3(__m128 a, __m128 b) noexcept {
+    const __m128 r = _mm_sub_ps(_mm_mul_ps(a, swizzle<1, 2, 0, 3>(b)),
+                                _mm_mul_ps(swizzle<1, 2, 0, 3>(a), b));
+    return swizzle<1, 2, 0, 3>(r);
+}
+
+//NOTE: [A | t]^-1 = [A^-1 | -A^-1 t]; rows of A^-1 are (c1 x c2, c2 x c0, c0 x c1) / det.
+//      Assumes a (0, 0, 0, 1) bottom row; returns false when |det| <= epsilon.
+inline bool inverse_affine_mat4(const float* m, float* out) noexcept {
+    const __m128 mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+    const __m128 c0 = _mm_and_ps(_mm_load_ps(m), mask);
+    const __m128 c1 = _mm_and_ps(_mm_load_ps(m + 4), mask);
+    const __m128 c2 = _mm_and_ps(_mm_load_ps(m + 8), mask);
+    const __m128 t  = _mm_load_ps(m + 12);
+
+    __m128 r0 = cross3(c1, c2);
+    __m128 r1 = cross3(c2, c0);
+    __m128 r2 = cross3(c0, c1);
+    __m128 r3 = _mm_setzero_ps();
+
+    __m128 d = _mm_mul_ps(c0, r0);
+    d = _mm_add_ps(d, _mm_movehl_ps(d, d));
+    d = _mm_add_ss(d, splat<1>(d));
+    const float det = _mm_cvtss_f32(d);
+    if (!(det > 1.19209290e-7f || det < -1.19209290e-7f)) {
+        return false;
+    }
+
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    const __m128 inv_det = _mm_set1_ps(1.0f / det);
+    r0 = _mm_mul_ps(r0, inv_det);
+    r1 = _mm_mul_ps(r1, inv_det);
+    r2 = _mm_mul_ps(r2, inv_det);
+
+    __m128 nt = _mm_mul_ps(r0, splat<0>(t));
+    nt = madd(r1, splat<1>(t), nt);
+    nt = madd(r2, splat<2>(t), nt);
+    nt = _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), nt);
+
+    _mm_store_ps(out, r0);
+    _mm_store_ps(out + 4, r1);
+    _mm_store_ps(out + 8, r2);
+    _mm_store_ps(out + 12, nt);
+    return true;
+}
+
+//NOTE: [R | t]^-1 = [R^T | -R^T t] for orthonormal R
+inline void inverse_rigid_mat4(const float* m, float* out) noexcept {
+    __m128 c0 = _mm_load_ps(m);
+    __m128 c1 = _mm_load_ps(m + 4);
+    __m128 c2 = _mm_load_ps(m + 8);
+    __m128 c3 = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+    const __m128 t = _mm_load_ps(m + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+    __m128 nt = _mm_mul_ps(c0, splat<0>(t));
+    nt = madd(c1, splat<1>(t), nt);
+    nt = madd(c2, splat<2>(t), nt);
+    nt = _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), nt);
+
+    _mm_store_ps(out, c0);
+    _mm_store_ps(out + 4, c1);
+    _mm_store_ps(out + 8, c2);
+    _mm_store_ps(out + 12, nt);
+}
+
+#endif // CC_MATH_SSE2
+
+#if defined(CC_MATH_AVX)
+
+[[nodiscard]] inline __m256d madd(__m256d a, __m256d b, __m256d c) noexcept {
+#if defined(CC_MATH_FMA)
+    return _mm256_fmadd_pd(a, b, c);
+#else
+    return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+}
+
+inline void add4(const double* a, const double* b, double* out) noexcept {
+    _mm256_store_pd(out, _mm256_add_pd(_mm256_load_pd(a), _mm256_load_pd(b)));
+}
+
+inline void sub4(const double* a, const double* b, double* out) noexcept {
+    _mm256_store_pd(out, _mm256_sub_pd(_mm256_load_pd(a), _mm256_load_pd(b)));
+}
+
+inline void mul4(const double* a, const double* b, double* out) noexcept {
+    _mm256_store_pd(out, _mm256_mul_pd(_mm256_load_pd(a), _mm256_load_pd(b)));
+}
+
+inline void div4(const double* a, const double* b, double* out) noexcept {
+    _mm256_store_pd(out, _mm256_div_pd(_mm256_load_pd(a), _mm256_load_pd(b)));
+}
+
+inline void scale4(const double* a, double s, double* out) noexcept {
+    _mm256_store_pd(out, _mm256_mul_pd(_mm256_load_pd(a), _mm256_set1_pd(s)));
+}
+
+inline void divs4(const double* a, double s, double* out) noexcept {
+    _mm256_store_pd(out, _mm256_div_pd(_mm256_load_pd(a), _mm256_set1_pd(s)));
+}
+
+inline void madd4(const double* a, const double* b, const double* c, double* out) noexcept {
+    _mm256_store_pd(out, madd(_mm256_load_pd(a), _mm256_load_pd(b), _mm256_load_pd(c)));
+}
+
+inline void madds4(const double* a, double s, const double* c, double* out) noexcept {
+    _mm256_store_pd(out, madd(_mm256_load_pd(a), _mm256_set1_pd(s), _mm256_load_pd(c)));
+}
+
+[[nodiscard]] inline double dot4(const double* a, const double* b) noexcept {
+    const __m256d m  = _mm256_mul_pd(_mm256_load_pd(a), _mm256_load_pd(b));
+    const __m128d lo = _mm256_castpd256_pd128(m);
+    const __m128d hi = _mm256_extractf128_pd(m, 1);
+    const __m128d s  = _mm_add_pd(lo, hi);
+    return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+}
+
+[[nodiscard]] inline __m256d combine4(__m256d a0, __m256d a1, __m256d a2, __m256d a3,
+                                      const double* w) noexcept {
+    __m256d r = _mm256_mul_pd(a0, _mm256_broadcast_sd(w));
+    r = madd(a1, _mm256_broadcast_sd(w + 1), r);
+    r = madd(a2, _mm256_broadcast_sd(w + 2), r);
+    return madd(a3, _mm256_broadcast_sd(w + 3), r);
+}
+
+inline void mul_mat4(const double* a, const double* b, double* out) noexcept {
+    const __m256d a0 = _mm256_load_pd(a);
+    const __m256d a1 = _mm256_load_pd(a + 4);
+    const __m256d a2 = _mm256_load_pd(a + 8);
+    const __m256d a3 = _mm256_load_pd(a + 12);
+
+    const __m256d r0 = combine4(a0, a1, a2, a3, b);
+    const __m256d r1 = combine4(a0, a1, a2, a3, b + 4);
+    const __m256d r2 = combine4(a0, a1, a2, a3, b + 8);
+    const __m256d r3 = combine4(a0, a1, a2, a3, b + 12);
+
+    _mm256_store_pd(out, r0);
+    _mm256_store_pd(out + 4, r1);
+    _mm256_store_pd(out + 8, r2);
+    _mm256_store_pd(out + 12, r3);
+}
+
+inline void mul_mat4_vec4(const double* m, const double* v, double* out) noexcept {
+    _mm256_store_pd(out, combine4(_mm256_load_pd(m), _mm256_load_pd(m + 4), _mm256_load_pd(m + 8),
+                                  _mm256_load_pd(m + 12), v));
+}
+
+inline void transpose_mat4(const double* m, double* out) noexcept {
+    const __m256d c0 = _mm256_load_pd(m);
+    const __m256d c1 = _mm256_load_pd(m + 4);
+    const __m256d c2 = _mm256_load_pd(m + 8);
+    const __m256d c3 = _mm256_load_pd(m + 12);
+
+    const __m256d t0 = _mm256_unpacklo_pd(c0, c1);
+    const __m256d t1 = _mm256_unpackhi_pd(c0, c1);
+    const __m256d t2 = _mm256_unpacklo_pd(c2, c3);
+    const __m256d t3 = _mm256_unpackhi_pd(c2, c3);
+
+    _mm256_store_pd(out,      _mm256_permute2f128_pd(t0, t2, 0x20));
+    _mm256_store_pd(out + 4,  _mm256_permute2f128_pd(t1, t3, 0x20));
+    _mm256_store_pd(out + 8,  _mm256_permute2f128_pd(t0, t2, 0x31));
+    _mm256_store_pd(out + 12, _mm256_permute2f128_pd(t1, t3, 0x31));
+}
+
+#endif // CC_MATH_AVX
+
+} // namespace cc::detail::simd
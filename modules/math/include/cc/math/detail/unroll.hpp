@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+//NOTE: Compile-time loop unrolling for fixed-size kernels. Indices are either
+//      std::integral_constant<std::size_t, I> (unrolled) or plain std::size_t (runtime loop);
+//      both convert to std::size_t, so loop bodies are written once as generic lambdas. A range
+//      is unrolled only when both bounds are constants, so a runtime outer index turns every
+//      nested range into an ordinary loop as well.
+namespace cc::detail {
+
+inline constexpr std::size_t max_unrolled = 8;
+
+template<std::size_t I>
+inline constexpr std::integral_constant<std::size_t, I> index_c{};
+
+template<typename T>
+inline constexpr bool is_index_c = false;
+
+template<std::size_t I>
+inline constexpr bool is_index_c<std::integral_constant<std::size_t, I>> = true;
+
+//NOTE: bounds of a loop over [0, N): constants up to max_unrolled, runtime values beyond
+template<std::size_t N>
+[[nodiscard]] constexpr auto loop_begin() noexcept {
+    if constexpr (N <= max_unrolled) {
+        return index_c<0>;
+    } else {
+        return std::size_t{0};
+    }
+}
+
+template<std::size_t N>
+[[nodiscard]] constexpr auto loop_end() noexcept {
+    if constexpr (N <= max_unrolled) {
+        return index_c<N>;
+    } else {
+        return N;
+    }
+}
+
+//NOTE: i + 1, keeping it a constant when i is one
+template<typename I>
+[[nodiscard]] constexpr auto next_index(I i) noexcept {
+    if constexpr (is_index_c<I>) {
+        return index_c<I::value + 1>;
+    } else {
+        return static_cast<std::size_t>(i) + 1;
+    }
+}
+
+//NOTE: f(i) for i in [begin, end)
+template<typename B, typename E, typename F>
+constexpr void unrolled_for(B begin, E end, F&& f) {
+    if constexpr (is_index_c<B> && is_index_c<E>) {
+        if constexpr (B::value < E::value) {
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                (f(index_c<B::value + I>), ...);
+            }(std::make_index_sequence<E::value - B::value>{});
+        }
+    } else {
+        for (std::size_t i = begin; i < static_cast<std::size_t>(end); ++i) {
+            f(i);
+        }
+    }
+}
+
+//NOTE: f(i) for i in [begin, end), descending
+template<typename B, typename E, typename F>
+constexpr void unrolled_for_reverse(B begin, E end, F&& f) {
+    if constexpr (is_index_c<B> && is_index_c<E>) {
+        if constexpr (B::value < E::value) {
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                (f(index_c<E::value - 1 - I>), ...);
+            }(std::make_index_sequence<E::value - B::value>{});
+        }
+    } else {
+        for (std::size_t i = end; i-- > static_cast<std::size_t>(begin);) {
+            f(i);
+        }
+    }
+}
+
+} // namespace cc::detail
@@ -0,0 +1,508 @@
+#pragma once
+
+#include "../detail/arithmetic.hpp"
+#include "../common/constants.hpp"
+#include "../common/functions.hpp"
+#include "../vec/base.hpp"
+#include "../vec/vec2.hpp"              // IWYU pragma: keep
+#include "../vec/vec3.hpp"              // IWYU pragma: keep
+#include "../vec/vec4.hpp"              // IWYU pragma: keep
+#include "../mat/base.hpp"
+#include "../mat/solve.hpp"
+#include "../interop/op.hpp"
+#include "../simd/simd.hpp"
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+//NOTE: Linear and extended Kalman filters for tracking, sized at compile time and free of heap
+//      allocation. kalman_filter holds one state and covariance in fixed-size mats; the model
+//      (transition f, process noise q, observation h, measurement noise r) is passed per call so
+//      one filter type serves varying time steps. predict_many and update_many advance many
+//      filters that share one model, stored SoA, several per simd register.
+//
+//      The update factors the innovation covariance s = h * p * h^T + r with Cholesky and
+//      subtracts g^T * g with g = l^-1 * h * p, so p stays exactly symmetric and no inverse is
+//      formed. A measurement whose s is not positive definite is rejected and leaves the filter
+//      as it was.
+namespace cc {
+
+namespace detail {
+
+//NOTE: measurements are plain scalars for one-dimensional sensors (vec<1, T> does not exist)
+template<std::size_t N, floating_point T>
+struct kalman_vector_type {
+    using type = vec<N, T>;
+};
+
+template<floating_point T>
+struct kalman_vector_type<1, T> {
+    using type = T;
+};
+
+template<std::size_t N, floating_point T>
+using kalman_vector = typename kalman_vector_type<N, T>::type;
+
+template<std::size_t N, floating_point T>
+[[nodiscard]] constexpr mat<N, 1, T> to_column(const kalman_vector<N, T>& v) noexcept {
+    mat<N, 1, T> c;
+    if constexpr (N > 1) {
+        for (std::size_t i = 0; i < N; ++i) {
+            c(i, 0) = v[i];
+        }
+    } else {
+        c(0, 0) = v;
+    }
+    return c;
+}
+
+//NOTE: l^-1 * b for the Cholesky factor l
+template<std::size_t N, std::size_t K, floating_point T>
+[[nodiscard]] constexpr mat<N, K, T> forward_substitute(const cholesky_factors<N, T>& c, mat<N, K, T> b) noexcept {
+    std::array<T, N> inv_diagonal;
+    unrolled_for(loop_begin<N>(), loop_end<N>(), [&](auto i) {
+        inv_diagonal[i] = T{1} / c.l(i, i);
+    });
+    for (std::size_t col = 0; col < K; ++col) {
+        unrolled_for(loop_begin<N>(), loop_end<N>(), [&](auto i) {
+            T sum = b(i, col);
+            unrolled_for(loop_begin<N>(), i, [&](auto j) {
+                sum -= c.l(i, j) * b(j, col);
+            });
+            b(i, col) = sum * inv_diagonal[i];
+        });
+    }
+    return b;
+}
+
+} // namespace detail
+
+template<std::size_t StateDim, std::size_t MeasDim, floating_point T>
+requires (StateDim >= 2 && MeasDim >= 1)
+class kalman_filter {
+public:
+    static constexpr std::size_t state_dim       = StateDim;
+    static constexpr std::size_t measurement_dim = MeasDim;
+
+    using value_type       = T;
+    using state_type       = vec<StateDim, T>;
+    using measurement_type = detail::kalman_vector<MeasDim, T>;
+    using covariance_type  = mat<StateDim, StateDim, T>;
+    using transition_type  = mat<StateDim, StateDim, T>;
+    using observation_type = mat<MeasDim, StateDim, T>;
+    using noise_type       = mat<MeasDim, MeasDim, T>;
+
+    //NOTE: zero state, identity covariance
+    constexpr kalman_filter() noexcept = default;
+
+    constexpr kalman_filter(const state_type& x, const covariance_type& p) noexcept
+        : x_(x), p_(p) {}
+
+    [[nodiscard]] constexpr const state_type& state() const noexcept {
+        return x_;
+    }
+
+    [[nodiscard]] constexpr const covariance_type& covariance() const noexcept {
+        return p_;
+    }
+
+    constexpr void reset(const state_type& x, const covariance_type& p) noexcept {
+        x_ = x;
+        p_ = p;
+    }
+
+    //NOTE: x = f * x, p = f * p * f^T + q
+    constexpr void predict(const transition_type& f, const covariance_type& q) noexcept {
+        x_ = f * x_;
+        propagate(f, q);
+    }
+
+    //NOTE: extended: x = fx(x) with jacobian the derivative of fx at the current (prior) state
+    template<typename Fn>
+    requires std::is_invocable_r_v<state_type, Fn, const state_type&>
+    constexpr void predict(Fn&& fx, const transition_type& jacobian, const covariance_type& q) {
+        x_ = std::forward<Fn>(fx)(std::as_const(x_));
+        propagate(jacobian, q);
+    }
+
+    //NOTE: false (and no change) when h * p * h^T + r is not positive definite
+    bool update(const measurement_type& z, const observation_type& h, const noise_type& r) noexcept {
+        return correct(detail::to_column<MeasDim, T>(z) - h * to_column(x_), h, r);
+    }
+
+    //NOTE: extended: hx(x) predicts the measurement, jacobian is its derivative at the current
+    //      state
+    template<typename Fn>
+    requires std::is_invocable_r_v<measurement_type, Fn, const state_type&>
+    bool update(const measurement_type& z, Fn&& hx, const observation_type& jacobian, const noise_type& r) {
+        const measurement_type predicted = std::forward<Fn>(hx)(std::as_const(x_));
+        return correct(detail::to_column<MeasDim, T>(z) - detail::to_column<MeasDim, T>(predicted), jacobian, r);
+    }
+
+    //NOTE: squared Mahalanobis distance of z from the predicted measurement, for gating
+    //      measurement-to-track association (compare against a chi-square quantile with MeasDim
+    //      degrees of freedom)
+    [[nodiscard]] std::optional<T> distance2(const measurement_type& z,
+                                             const observation_type& h,
+                                             const noise_type& r) const noexcept {
+        const auto c = cholesky(h * p_ * h.transpose() + r);
+        if (!c) {
+            return std::nullopt;
+        }
+        const mat<MeasDim, 1, T> v = detail::forward_substitute(*c, detail::to_column<MeasDim, T>(z) - h * to_column(x_));
+        T d2 = T{0};
+        for (std::size_t i = 0; i < MeasDim; ++i) {
+            d2 += v(i, 0) * v(i, 0);
+        }
+        return d2;
+    }
+
+private:
+    [[nodiscard]] static constexpr mat<StateDim, 1, T> to_column(const state_type& x) noexcept {
+        return detail::to_column<StateDim, T>(x);
+    }
+
+    constexpr void propagate(const transition_type& f, const covariance_type& q) noexcept {
+        const covariance_type p = f * p_ * f.transpose() + q;
+        for (std::size_t j = 0; j < StateDim; ++j) {
+            for (std::size_t i = j; i < StateDim; ++i) {
+                const T v = (p(i, j) + p(j, i)) * T{0.5};
+                p_(i, j) = v;
+                p_(j, i) = v;
+            }
+        }
+    }
+
+    bool correct(const mat<MeasDim, 1, T>& y, const observation_type& h, const noise_type& r) noexcept {
+        const mat<MeasDim, StateDim, T> hp = h * p_;
+        const auto c = cholesky(hp * h.transpose() + r);
+        if (!c) {
+            return false;
+        }
+
+        //NOTE: k * y = g^T * v and k * h * p = g^T * g
+        const mat<MeasDim, StateDim, T> g = detail::forward_substitute(*c, hp);
+        const mat<MeasDim, 1, T> v = detail::forward_substitute(*c, y);
+        for (std::size_t i = 0; i < StateDim; ++i) {
+            T dx = T{0};
+            for (std::size_t m = 0; m < MeasDim; ++m) {
+                dx += g(m, i) * v(m, 0);
+            }
+            x_[i] += dx;
+        }
+        p_ -= g.transpose() * g;
+        return true;
+    }
+
+    state_type      x_{};
+    covariance_type p_ = covariance_type::identity();
+};
+
+//NOTE: Many filters with one shared model, one array per state component and per entry of the
+//      lower triangle of the covariance (SoaStorage columns, for instance): x[i][k] is component
+//      i of filter k and p[detail::packed_index(i, j)][k] is entry (i, j), j <= i, of its
+//      covariance. All spans have the same size.
+template<std::size_t StateDim, floating_point T>
+struct kalman_soa {
+    static constexpr std::size_t covariance_size = StateDim * (StateDim + 1) / 2;
+
+    std::array<std::span<T>, StateDim>        x;
+    std::array<std::span<T>, covariance_size> p;
+
+    [[nodiscard]] constexpr std::size_t size() const noexcept {
+        return x[0].size();
+    }
+};
+
+namespace detail {
+
+[[nodiscard]] constexpr std::size_t packed_index(std::size_t i, std::size_t j) noexcept {
+    return i >= j ? i * (i + 1) / 2 + j : j * (j + 1) / 2 + i;
+}
+
+//NOTE: the widest simd the header is compiled for; double has no simd abi and runs one filter
+//      per group
+template<floating_point T>
+inline constexpr std::size_t kalman_lanes =
+#if defined(CC_MATH_AVX)
+    std::is_same_v<T, float> ? 8 : 1;
+#elif defined(CC_MATH_SSE2)
+    std::is_same_v<T, float> ? 4 : 1;
+#else
+    1;
+#endif
+
+//NOTE: W filters, one per lane. Zero entries of the model are multiplied like any other; testing
+//      them costs more than the multiply-adds it saves once the branches split the unrolled code
+template<std::size_t S, floating_point T, std::size_t W>
+struct kalman_group {
+    using pack = cc::simd<T, W>;
+    static constexpr std::size_t covariance_size = S * (S + 1) / 2;
+
+    std::array<pack, S>               x;
+    std::array<pack, covariance_size> p;
+
+    //NOTE: loops over [0, N) and [0, i], unrolled (with constant packed indices) up to 8
+    template<std::size_t N, typename F>
+    static void repeat(F&& f) noexcept {
+        unrolled_for(loop_begin<N>(), loop_end<N>(), f);
+    }
+
+    template<std::size_t N, typename I, typename F>
+    static void repeat_through(I i, F&& f) noexcept {
+        unrolled_for(loop_begin<N>(), next_index(i), f);
+    }
+
+    void predict(const mat<S, S, T>& f, const mat<S, S, T>& q) noexcept {
+        std::array<pack, S> fx;
+        repeat<S>([&](auto i) {
+            pack sum(T{0});
+            repeat<S>([&](auto k) {
+                sum += pack(f(i, k)) * x[k];
+            });
+            fx[i] = sum;
+        });
+        x = fx;
+
+        std::array<pack, S * S> fp;   // f * p, row-major
+        repeat<S>([&](auto i) {
+            repeat<S>([&](auto j) {
+                pack sum(T{0});
+                repeat<S>([&](auto k) {
+                    sum += pack(f(i, k)) * p[packed_index(k, j)];
+                });
+                fp[i * S + j] = sum;
+            });
+        });
+        repeat<S>([&](auto i) {
+            repeat_through<S>(i, [&](auto j) {
+                pack sum(q(i, j));
+                repeat<S>([&](auto k) {
+                    sum += fp[i * S + k] * pack(f(j, k));
+                });
+                p[packed_index(i, j)] = sum;
+            });
+        });
+    }
+
+    //NOTE: returns the lanes that were updated; the others keep their state
+    template<std::size_t M>
+    typename pack::mask_type update(const std::array<pack, M>& z,
+                                    const mat<M, S, T>& h,
+                                    const mat<M, M, T>& r) noexcept {
+        std::array<pack, M> v;
+        std::array<pack, M * S> g;   // h * p, then l^-1 * h * p; row-major
+        repeat<M>([&](auto m) {
+            pack hx(T{0});
+            repeat<S>([&](auto k) {
+                hx += pack(h(m, k)) * x[k];
+            });
+            v[m] = z[m] - hx;
+            repeat<S>([&](auto j) {
+                pack sum(T{0});
+                repeat<S>([&](auto k) {
+                    sum += pack(h(m, k)) * p[packed_index(k, j)];
+                });
+                g[m * S + j] = sum;
+            });
+        });
+
+        //NOTE: Cholesky of s = h * p * h^T + r, lane by lane; failing lanes continue on a
+        //      clamped pivot and are masked out at the end
+        std::array<pack, M * (M + 1) / 2> l;
+        pack largest(T{0});
+        repeat<M>([&](auto a) {
+            repeat_through<M>(a, [&](auto b) {
+                pack sum(r(a, b));
+                repeat<S>([&](auto k) {
+                    sum += g[a * S + k] * pack(h(b, k));
+                });
+                l[packed_index(a, b)] = sum;
+            });
+            largest = max(largest, abs(l[packed_index(a, a)]));
+        });
+
+        const pack tolerance = largest * pack(static_cast<T>(M) * epsilon<T>);
+        const pack smallest = tolerance + pack(std::numeric_limits<T>::min());
+        typename pack::mask_type valid(true);
+        std::array<pack, M> inv_diagonal;
+        repeat<M>([&](auto j) {
+            pack d = l[packed_index(j, j)];
+            unrolled_for(loop_begin<M>(), j, [&](auto k) {
+                d -= l[packed_index(j, k)] * l[packed_index(j, k)];
+            });
+            valid = valid && (d > tolerance);
+            const pack diagonal = sqrt(max(d, smallest));
+            inv_diagonal[j] = pack(T{1}) / diagonal;
+            l[packed_index(j, j)] = diagonal;
+            unrolled_for(next_index(j), loop_end<M>(), [&](auto i) {
+                pack sum = l[packed_index(i, j)];
+                unrolled_for(loop_begin<M>(), j, [&](auto k) {
+                    sum -= l[packed_index(i, k)] * l[packed_index(j, k)];
+                });
+                l[packed_index(i, j)] = sum * inv_diagonal[j];
+            });
+        });
+
+        repeat<M>([&](auto i) {
+            unrolled_for(loop_begin<M>(), i, [&](auto k) {
+                v[i] -= l[packed_index(i, k)] * v[k];
+                repeat<S>([&](auto j) {
+                    g[i * S + j] -= l[packed_index(i, k)] * g[k * S + j];
+                });
+            });
+            v[i] *= inv_diagonal[i];
+            repeat<S>([&](auto j) {
+                g[i * S + j] *= inv_diagonal[i];
+            });
+        });
+
+        repeat<S>([&](auto i) {
+            pack dx(T{0});
+            repeat<M>([&](auto m) {
+                dx += g[m * S + i] * v[m];
+            });
+            x[i] = select(valid, x[i] + dx, x[i]);
+            repeat_through<S>(i, [&](auto j) {
+                pack dp(T{0});
+                repeat<M>([&](auto m) {
+                    dp += g[m * S + i] * g[m * S + j];
+                });
+                pack& pij = p[packed_index(i, j)];
+                pij = select(valid, pij - dp, pij);
+            });
+        });
+        return valid;
+    }
+
+    void load(const kalman_soa<S, T>& f, std::size_t k) noexcept {
+        for (std::size_t i = 0; i < S; ++i) {
+            x[i] = pack::loadu(f.x[i].data() + k);
+        }
+        for (std::size_t i = 0; i < covariance_size; ++i) {
+            p[i] = pack::loadu(f.p[i].data() + k);
+        }
+    }
+
+    void store(const kalman_soa<S, T>& f, std::size_t k) const noexcept {
+        for (std::size_t i = 0; i < S; ++i) {
+            x[i].storeu(f.x[i].data() + k);
+        }
+        for (std::size_t i = 0; i < covariance_size; ++i) {
+            p[i].storeu(f.p[i].data() + k);
+        }
+    }
+
+    //NOTE: the last n < W filters; padding lanes get a zero state and identity covariance
+    void load_partial(const kalman_soa<S, T>& f, std::size_t k, std::size_t n) noexcept {
+        alignas(W * sizeof(T)) T lanes[W];
+        for (std::size_t i = 0; i < S; ++i) {
+            for (std::size_t lane = 0; lane < W; ++lane) {
+                lanes[lane] = lane < n ? f.x[i][k + lane] : T{0};
+            }
+            x[i] = pack::load(lanes);
+        }
+        for (std::size_t i = 0; i < S; ++i) {
+            for (std::size_t j = 0; j <= i; ++j) {
+                const std::span<T> column = f.p[packed_index(i, j)];
+                for (std::size_t lane = 0; lane < W; ++lane) {
+                    lanes[lane] = lane < n ? column[k + lane] : T(i == j ? 1 : 0);
+                }
+                p[packed_index(i, j)] = pack::load(lanes);
+            }
+        }
+    }
+
+    void store_partial(const kalman_soa<S, T>& f, std::size_t k, std::size_t n) const noexcept {
+        alignas(W * sizeof(T)) T lanes[W];
+        for (std::size_t i = 0; i < S; ++i) {
+            x[i].store(lanes);
+            for (std::size_t lane = 0; lane < n; ++lane) {
+                f.x[i][k + lane] = lanes[lane];
+            }
+        }
+        for (std::size_t i = 0; i < covariance_size; ++i) {
+            p[i].store(lanes);
+            for (std::size_t lane = 0; lane < n; ++lane) {
+                f.p[i][k + lane] = lanes[lane];
+            }
+        }
+    }
+};
+
+template<std::size_t M, floating_point T, std::size_t W>
+[[nodiscard]] std::array<cc::simd<T, W>, M> load_measurements(const std::array<std::span<const T>, M>& z,
+                                                          std::size_t k,
+                                                          std::size_t n) noexcept {
+    std::array<cc::simd<T, W>, M> r;
+    for (std::size_t m = 0; m < M; ++m) {
+        if (n == W) {
+            r[m] = cc::simd<T, W>::loadu(z[m].data() + k);
+        } else {
+            alignas(W * sizeof(T)) T lanes[W] = {};
+            for (std::size_t lane = 0; lane < n; ++lane) {
+                lanes[lane] = z[m][k + lane];
+            }
+            r[m] = cc::simd<T, W>::load(lanes);
+        }
+    }
+    return r;
+}
+
+} // namespace detail
+
+//NOTE: kalman_filter::predict on every filter of the batch
+template<std::size_t S, floating_point T, std::size_t W = detail::kalman_lanes<T>>
+void predict_many(const kalman_soa<S, T>& filters, const mat<S, S, T>& f, const mat<S, S, T>& q) noexcept {
+    const std::size_t n = filters.size();
+    detail::kalman_group<S, T, W> group;
+    std::size_t k = 0;
+    for (; k + W <= n; k += W) {
+        group.load(filters, k);
+        group.predict(f, q);
+        group.store(filters, k);
+    }
+    if (k < n) {
+        group.load_partial(filters, k, n - k);
+        group.predict(f, q);
+        group.store_partial(filters, k, n - k);
+    }
+}
+
+//NOTE: kalman_filter::update on every filter of the batch, z[m][k] being component m of the
+//      measurement for filter k. Returns the number of filters updated; the rest had an
+//      innovation covariance that is not positive definite and were left as they were
+template<std::size_t S, std::size_t M, floating_point T, std::size_t W = detail::kalman_lanes<T>>
+std::size_t update_many(const kalman_soa<S, T>& filters,
+                        const std::array<std::span<const T>, M>& z,
+                        const mat<M, S, T>& h,
+                        const mat<M, M, T>& r) noexcept {
+    const std::size_t n = filters.size();
+    detail::kalman_group<S, T, W> group;
+    std::size_t updated = 0;
+    std::size_t k = 0;
+    for (; k + W <= n; k += W) {
+        assert(z[0].size() >= k + W);
+        group.load(filters, k);
+        updated += static_cast<std::size_t>(std::popcount(group.update(detail::load_measurements<M, T, W>(z, k, W), h, r).bits()));
+        group.store(filters, k);
+    }
+    if (k < n) {
+        const std::size_t rest = n - k;
+        group.load_partial(filters, k, rest);
+        const std::uint32_t bits = group.update(detail::load_measurements<M, T, W>(z, k, rest), h, r).bits();
+        updated += static_cast<std::size_t>(std::popcount(bits & ((1u << rest) - 1u)));
+        group.store_partial(filters, k, rest);
+    }
+    return updated;
+}
+
+} // namespace cc
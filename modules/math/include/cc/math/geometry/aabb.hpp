@@ -0,0 +1,88 @@
+#pragma once
+
+#include "../detail/arithmetic.hpp"
+#include "../common/functions.hpp"
+#include "../common/constants.hpp"
+#include "../vec/base.hpp"
+#include "../vec/vec3.hpp"           // IWYU pragma: keep
+
+namespace cc {
+
+template<floating_point T>
+struct aabb {
+    using value_type = T;
+
+    vec<3, T> min{};
+    vec<3, T> max{};
+
+    constexpr aabb() noexcept = default;
+
+    constexpr aabb(const vec<3, T>& min_, const vec<3, T>& max_) noexcept
+        : min(min_), max(max_) {}
+
+    //NOTE: inverted box that any expand()/merge() replaces
+    [[nodiscard]] static constexpr aabb empty() noexcept {
+        return aabb(vec<3, T>(infinity<T>), vec<3, T>(-infinity<T>));
+    }
+
+    [[nodiscard]] static constexpr aabb from_center_extents(const vec<3, T>& center, const vec<3, T>& extents) noexcept {
+        return aabb(center - extents, center + extents);
+    }
+
+    [[nodiscard]] constexpr bool is_empty() const noexcept {
+        return min.x > max.x || min.y > max.y || min.z > max.z;
+    }
+
+    [[nodiscard]] constexpr vec<3, T> center() const noexcept {
+        return (min + max) * T{0.5};
+    }
+
+    //NOTE: half size
+    [[nodiscard]] constexpr vec<3, T> extents() const noexcept {
+        return (max - min) * T{0.5};
+    }
+
+    [[nodiscard]] constexpr vec<3, T> size() const noexcept {
+        return max - min;
+    }
+
+    [[nodiscard]] constexpr T surface_area() const noexcept {
+        const vec<3, T> s = size();
+        return T{2} * (s.x * s.y + s.y * s.z + s.z * s.x);
+    }
+
+    //NOTE: index of the longest axis
+    [[nodiscard]] constexpr int max_axis() const noexcept {
+        const vec<3, T> s = size();
+        if (s.x >= s.y && s.x >= s.z) return 0;
+        return s.y >= s.z ? 1 : 2;
+    }
+
+    constexpr aabb& expand(const vec<3, T>& p) noexcept {
+        min = {cc::min(min.x, p.x), cc::min(min.y, p.y), cc::min(min.z, p.z)};
+        max = {cc::max(max.x, p.x), cc::max(max.y, p.y), cc::max(max.z, p.z)};
+        return *this;
+    }
+
+    constexpr aabb& expand(const aabb& other) noexcept {
+        min = {cc::min(min.x, other.min.x), cc::min(min.y, other.min.y), cc::min(min.z, other.min.z)};
+        max = {cc::max(max.x, other.max.x), cc::max(max.y, other.max.y), cc::max(max.z, other.max.z)};
+        return *this;
+    }
+
+    [[nodiscard]] friend constexpr aabb merge(aabb a, const aabb& b) noexcept {
+        return a.expand(b);
+    }
+
+    [[nodiscard]] constexpr bool contains(const vec<3, T>& p) const noexcept {
+        return p.x >= min.x && p.x <= max.x &&
+               p.y >= min.y && p.y <= max.y &&
+               p.z >= min.z && p.z <= max.z;
+    }
+
+    [[nodiscard]] constexpr vec<3, T> closest_point(const vec<3, T>& p) const noexcept {
+        return {clamp(p.x, min.x, max.x), clamp(p.y, min.y, max.y), clamp(p.z, min.z, max.z)};
+    }
+};
+
+} // namespace cc
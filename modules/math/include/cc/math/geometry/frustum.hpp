@@ -0,0 +1,87 @@
+#pragma once
+
+#include "plane.hpp"
+#include "../detail/arithmetic.hpp"
+#include "../common/functions.hpp"
+#include "../vec/base.hpp"
+#include "../vec/vec3.hpp"           // IWYU pragma: keep
+#include "../mat/mat4.hpp"           // IWYU pragma: keep
+
+#include <array>
+#include <cstddef>
+
+namespace cc {
+
+//NOTE: six inward-facing, normalized planes. A point is inside when every distance is >= 0.
+template<floating_point T>
+struct frustum {
+    using value_type = T;
+
+    enum side : std::size_t {
+        left,
+        right,
+        bottom,
+        top,
+        z_near,
+        z_far,
+        count
+    };
+
+    std::array<plane<T>, count> planes{};
+
+    //NOTE: Gribb-Hartmann extraction for OpenGL clip space (-w <= x, y, z <= w), i.e. the
+    //      matrices built by perspective()/ortho(). Pass projection * view (Camera::GetViewProjection)
+    //      for world-space planes, or the projection alone for view-space planes.
+    [[nodiscard]] static frustum from_matrix(const mat<4, 4, T>& m) noexcept {
+        //NOTE: row 3 +/- row r
+        const auto extract = [&](std::size_t r, T sign) {
+            return plane<T>(m(3, 0) + sign * m(r, 0),
+                            m(3, 1) + sign * m(r, 1),
+                            m(3, 2) + sign * m(r, 2),
+                            m(3, 3) + sign * m(r, 3)).normalized();
+        };
+
+        frustum f;
+        f.planes[left]   = extract(0, T{1});
+        f.planes[right]  = extract(0, T{-1});
+        f.planes[bottom] = extract(1, T{1});
+        f.planes[top]    = extract(1, T{-1});
+        f.planes[z_near] = extract(2, T{1});
+        f.planes[z_far]  = extract(2, T{-1});
+        return f;
+    }
+
+    [[nodiscard]] constexpr bool contains(const vec<3, T>& p) const noexcept {
+        for (const plane<T>& pl : planes) {
+            if (pl.distance(p) < T{0}) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //NOTE: conservative: may report spheres near the corners as visible
+    [[nodiscard]] constexpr bool intersects_sphere(const vec<3, T>& center, T radius) const noexcept {
+        for (const plane<T>& pl : planes) {
+            if (pl.distance(center) < -radius) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //NOTE: box given as center and half extents; conservative like intersects_sphere
+    [[nodiscard]] constexpr bool intersects_aabb(const vec<3, T>& center, const vec<3, T>& extents) const noexcept {
+        for (const plane<T>& pl : planes) {
+            const T r = extents.x * abs(pl.normal.x) +
+                        extents.y * abs(pl.normal.y) +
+                        extents.z * abs(pl.normal.z);
+            if (pl.distance(center) < -r) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+} // namespace cc
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "aabb.hpp"
+#include "frustum.hpp"
+#include "plane.hpp"
+#include "ray.hpp"
+#include "sphere.hpp"
+#include "triangle.hpp"
+#include "../detail/arithmetic.hpp"
+#include "../common/functions.hpp"
+#include "../common/constants.hpp"
+
+#include <optional>
+
+namespace cc {
+
+//NOTE: t along the ray plus barycentrics (point = a + u * (b - a) + v * (c - a)) for triangles
+template<floating_point T>
+struct ray_hit {
+    T t{0};
+    T u{0};
+    T v{0};
+};
+
+//NOTE: ray queries return the nearest hit distance in [t_min, t_max], or nullopt
+
+//NOTE: slab test with a precomputed inv_direction (ray::inv_direction()), for BVH traversal
+template<floating_point T>
+[[nodiscard]] constexpr std::optional<T> intersect(const vec<3, T>& origin, const vec<3, T>& inv_direction,
+                                                   const aabb<T>& box,
+                                                   T t_min = T{0}, T t_max = infinity<T>) noexcept {
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+        T t0 = (box.min[axis] - origin[axis]) * inv_direction[axis];
+        T t1 = (box.max[axis] - origin[axis]) * inv_direction[axis];
+        if (t0 > t1) {
+            const T tmp = t0;
+            t0 = t1;
+            t1 = tmp;
+        }
+        t_min = t0 > t_min ? t0 : t_min;
+        t_max = t1 < t_max ? t1 : t_max;
+        if (t_max < t_min) {
+            return std::nullopt;
+        }
+    }
+    return t_min;
+}
+
+template<floating_point T>
+[[nodiscard]] constexpr std::optional<T> intersect(const ray<T>& r, const aabb<T>& box,
+                                                   T t_min = T{0}, T t_max = infinity<T>) noexcept {
+    return intersect(r.origin, r.inv_direction(), box, t_min, t_max);
+}
+
+//NOTE: Moller-Trumbore, two-sided. det scales with |e1| |e2| |direction|, so the parallel test
+//      is relative to that product (compared squared to avoid the square roots); a fixed
+//      threshold would miss every triangle below a few millimetres.
+template<floating_point T>
+[[nodiscard]] constexpr std::optional<ray_hit<T>> intersect(const ray<T>& r, const triangle<T>& tri,
+                                                            T t_min = T{0}, T t_max = infinity<T>) noexcept {
+    const vec<3, T> e1 = tri.b - tri.a;
+    const vec<3, T> e2 = tri.c - tri.a;
+    const vec<3, T> p  = r.direction.cross(e2);
+    const T det = e1.dot(p);
+    const T scale = e1.length_squared() * e2.length_squared() * r.direction.length_squared();
+    if (!(det * det > epsilon<T> * epsilon<T> * scale)) {
+        return std::nullopt;
+    }
+
+    const T inv_det = T{1} / det;
+    const vec<3, T> s = r.origin - tri.a;
+    const T u = s.dot(p) * inv_det;
+    if (u < T{0} || u > T{1}) {
+        return std::nullopt;
+    }
+
+    const vec<3, T> q = s.cross(e1);
+    const T v = r.direction.dot(q) * inv_det;
+    if (v < T{0} || u + v > T{1}) {
+        return std::nullopt;
+    }
+
+    const T t = e2.dot(q) * inv_det;
+    if (t < t_min || t > t_max) {
+        return std::nullopt;
+    }
+    return ray_hit<T>{t, u, v};
+}
+
+template<floating_point T>
+[[nodiscard]] std::optional<T> intersect(const ray<T>& r, const sphere<T>& s,
+                                         T t_min = T{0}, T t_max = infinity<T>) noexcept {
+    const vec<3, T> oc = r.origin - s.center;
+    const T a = r.direction.length_squared();
+    const T b = oc.dot(r.direction);
+    const T c = oc.length_squared() - s.radius * s.radius;
+    const T disc = b * b - a * c;
+    if (disc < T{0} || a <= T{0}) {
+        return std::nullopt;
+    }
+
+    const T root = sqrt(disc);
+    T t = (-b - root) / a;
+    if (t < t_min) {
+        t = (-b + root) / a;
+    }
+    if (t < t_min || t > t_max) {
+        return std::nullopt;
+    }
+    return t;
+}
+
+//NOTE: the parallel test is relative to |normal| |direction|, neither of which need be normalized
+template<floating_point T>
+[[nodiscard]] constexpr std::optional<T> intersect(const ray<T>& r, const plane<T>& pl,
+                                                   T t_min = T{0}, T t_max = infinity<T>) noexcept {
+    const T denom = pl.normal.dot(r.direction);
+    const T scale = pl.normal.length_squared() * r.direction.length_squared();
+    if (!(denom * denom > epsilon<T> * epsilon<T> * scale)) {
+        return std::nullopt;
+    }
+    const T t = -pl.distance(r.origin) / denom;
+    if (t < t_min || t > t_max) {
+        return std::nullopt;
+    }
+    return t;
+}
+
+//NOTE: overlap tests
+
+template<floating_point T>
+[[nodiscard]] constexpr bool intersects(const aabb<T>& a, const aabb<T>& b) noexcept {
+    return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+           a.min.y <= b.max.y && a.max.y >= b.min.y &&
+           a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+template<floating_point T>
+[[nodiscard]] constexpr bool intersects(const sphere<T>& a, const sphere<T>& b) noexcept {
+    const T r = a.radius + b.radius;
+    return (a.center - b.center).length_squared() <= r * r;
+}
+
+template<floating_point T>
+[[nodiscard]] constexpr bool intersects(const sphere<T>& s, const aabb<T>& box) noexcept {
+    return (box.closest_point(s.center) - s.center).length_squared() <= s.radius * s.radius;
+}
+
+template<floating_point T>
+[[nodiscard]] constexpr bool intersects(const aabb<T>& box, const sphere<T>& s) noexcept {
+    return intersects(s, box);
+}
+
+template<floating_point T>
+[[nodiscard]] constexpr bool intersects(const frustum<T>& f, const sphere<T>& s) noexcept {
+    return f.intersects_sphere(s.center, s.radius);
+}
+
+template<floating_point T>
+[[nodiscard]] constexpr bool intersects(const frustum<T>& f, const aabb<T>& box) noexcept {
+    return f.intersects_aabb(box.center(), box.extents());
+}
+
+} // namespace cc
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "aabb.hpp"
+#include "ray.hpp"
+#include "triangle.hpp"
+#include "../detail/arithmetic.hpp"
+#include "../common/constants.hpp"
+#include "../simd/simd.hpp"
+#include "../vec/vec3_wide.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <span>
+
+namespace cc {
+
+//NOTE: W rays in SoA form, tested together against one primitive. Lanes are independent, so
+//      coherent rays (camera, picking, shadow rays of a tile) cost about as much as one ray.
+template<floating_point T, std::size_t W>
+struct ray_packet {
+    using pack_type = simd<T, W>;
+    using mask_type = simd_mask<T, W>;
+    using vec_type  = vec<3, pack_type>;
+
+    vec_type origin;
+    vec_type direction;
+    vec_type inv_direction;
+
+    ray_packet() noexcept = default;
+
+    ray_packet(const vec_type& origin_, const vec_type& direction_) noexcept
+        : origin(origin_),
+          direction(direction_),
+          inv_direction(pack_type(T{1}) / direction_.x,
+                        pack_type(T{1}) / direction_.y,
+                        pack_type(T{1}) / direction_.z) {}
+
+    [[nodiscard]] static ray_packet from_rays(std::span<const ray<T>> rays) noexcept {
+        assert(rays.size() == W);
+        alignas(W * sizeof(T)) T o[3][W];
+        alignas(W * sizeof(T)) T d[3][W];
+        for (std::size_t i = 0; i < W; ++i) {
+            for (std::size_t axis = 0; axis < 3; ++axis) {
+                o[axis][i] = rays[i].origin[axis];
+                d[axis][i] = rays[i].direction[axis];
+            }
+        }
+        return ray_packet(vec_type::load(o[0], o[1], o[2]), vec_type::load(d[0], d[1], d[2]));
+    }
+
+    [[nodiscard]] ray<T> lane(std::size_t i) const noexcept {
+        return ray<T>(origin.lane(i), direction.lane(i));
+    }
+};
+
+//NOTE: per-lane hit flags and distances; u, v are only filled by triangle tests
+template<floating_point T, std::size_t W>
+struct packet_hit {
+    simd_mask<T, W> mask;
+    simd<T, W> t;
+    simd<T, W> u;
+    simd<T, W> v;
+};
+
+//NOTE: slab test of every lane against one box; t_max is per lane so a packet can keep its
+//      closest hits while walking a BVH
+template<floating_point T, std::size_t W>
+[[nodiscard]] packet_hit<T, W> intersect(const ray_packet<T, W>& rp, const aabb<T>& box,
+                                         simd<T, W> t_min = simd<T, W>(T{0}),
+                                         simd<T, W> t_max = simd<T, W>(infinity<T>)) noexcept {
+    using pack = simd<T, W>;
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+        const pack t0 = (pack(box.min[axis]) - rp.origin[axis]) * rp.inv_direction[axis];
+        const pack t1 = (pack(box.max[axis]) - rp.origin[axis]) * rp.inv_direction[axis];
+        t_min = max(t_min, min(t0, t1));
+        t_max = min(t_max, max(t0, t1));
+    }
+    return {t_min <= t_max, t_min, pack{}, pack{}};
+}
+
+//NOTE: Moller-Trumbore across lanes, two-sided; same results as the scalar version per lane,
+//      including the parallel test relative to |e1| |e2| |direction|
+template<floating_point T, std::size_t W>
+[[nodiscard]] packet_hit<T, W> intersect(const ray_packet<T, W>& rp, const triangle<T>& tri,
+                                         simd<T, W> t_min = simd<T, W>(T{0}),
+                                         simd<T, W> t_max = simd<T, W>(infinity<T>)) noexcept {
+    using pack = simd<T, W>;
+    using wide = vec<3, pack>;
+
+    const wide e1(tri.b - tri.a);
+    const wide e2(tri.c - tri.a);
+    const wide p = rp.direction.cross(e2);
+    const pack det = e1.dot(p);
+    const pack scale = pack((tri.b - tri.a).length_squared() * (tri.c - tri.a).length_squared()) *
+                       rp.direction.length_squared();
+
+    const pack inv_det = pack(T{1}) / det;
+    const wide s = rp.origin - wide(tri.a);
+    const pack u = s.dot(p) * inv_det;
+    const wide q = s.cross(e1);
+    const pack v = rp.direction.dot(q) * inv_det;
+    const pack t = e2.dot(q) * inv_det;
+
+    const pack zero{};
+    const pack one(T{1});
+    const auto hit = det * det > pack(epsilon<T> * epsilon<T>) * scale &&
+                     u >= zero && u <= one &&
+                     v >= zero && u + v <= one &&
+                     t >= t_min && t <= t_max;
+    return {hit, t, u, v};
+}
+
+} // namespace cc
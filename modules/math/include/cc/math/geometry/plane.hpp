@@ -0,0 +1,45 @@
+#pragma once
+
+#include "../detail/arithmetic.hpp"
+#include "../common/functions.hpp"
+#include "../vec/base.hpp"
+#include "../vec/vec3.hpp"           // IWYU pragma: keep
+
+namespace cc {
+
+//NOTE: points p with dot(normal, p) + d == 0; positive distances are on the normal's side
+template<floating_point T>
+struct plane {
+    using value_type = T;
+
+    vec<3, T> normal{T{0}, T{1}, T{0}};
+    T d{0};
+
+    constexpr plane() noexcept = default;
+
+    constexpr plane(const vec<3, T>& normal_, T d_) noexcept
+        : normal(normal_), d(d_) {}
+
+    constexpr plane(T a, T b, T c, T d_) noexcept
+        : normal(a, b, c), d(d_) {}
+
+    [[nodiscard]] static constexpr plane from_point_normal(const vec<3, T>& point, const vec<3, T>& n) noexcept {
+        return plane(n, -n.dot(point));
+    }
+
+    //NOTE: signed distance; exact only for normalized planes
+    [[nodiscard]] constexpr T distance(const vec<3, T>& p) const noexcept {
+        return normal.dot(p) + d;
+    }
+
+    [[nodiscard]] plane normalized() const noexcept {
+        const T len = normal.length();
+        if (len <= epsilon<T>) {
+            return *this;
+        }
+        const T inv = T{1} / len;
+        return plane(normal * inv, d * inv);
+    }
+};
+
+} // namespace cc
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "../detail/arithmetic.hpp"
+#include "../vec/base.hpp"
+#include "../vec/vec3.hpp"           // IWYU pragma: keep
+
+namespace cc {
+
+//NOTE: direction need not be normalized; hit distances are in units of |direction|
+template<floating_point T>
+struct ray {
+    using value_type = T;
+
+    vec<3, T> origin{};
+    vec<3, T> direction{T{0}, T{0}, T{-1}};
+
+    constexpr ray() noexcept = default;
+
+    constexpr ray(const vec<3, T>& origin_, const vec<3, T>& direction_) noexcept
+        : origin(origin_), direction(direction_) {}
+
+    [[nodiscard]] constexpr vec<3, T> at(T t) const noexcept {
+        return origin + direction * t;
+    }
+
+    //NOTE: 1 / direction for repeated slab tests; zero components become +-inf, which the
+    //      slab test handles
+    [[nodiscard]] constexpr vec<3, T> inv_direction() const noexcept {
+        return {T{1} / direction.x, T{1} / direction.y, T{1} / direction.z};
+    }
+};
+
+} // namespace cc
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "../detail/arithmetic.hpp"
+#include "../vec/base.hpp"
+#include "../vec/vec3.hpp"           // IWYU pragma: keep
+
+namespace cc {
+
+template<floating_point T>
+struct sphere {
+    using value_type = T;
+
+    vec<3, T> center{};
+    T radius{0};
+
+    constexpr sphere() noexcept = default;
+
+    constexpr sphere(const vec<3, T>& center_, T radius_) noexcept
+        : center(center_), radius(radius_) {}
+
+    [[nodiscard]] constexpr bool contains(const vec<3, T>& p) const noexcept {
+        return (p - center).length_squared() <= radius * radius;
+    }
+};
+
+} // namespace cc
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "../detail/arithmetic.hpp"
+#include "../vec/base.hpp"
+#include "../vec/vec3.hpp"           // IWYU pragma: keep
+
+namespace cc {
+
+//NOTE: counter-clockwise winding faces along normal()
+template<floating_point T>
+struct triangle {
+    using value_type = T;
+
+    vec<3, T> a{};
+    vec<3, T> b{};
+    vec<3, T> c{};
+
+    constexpr triangle() noexcept = default;
+
+    constexpr triangle(const vec<3, T>& a_, const vec<3, T>& b_, const vec<3, T>& c_) noexcept
+        : a(a_), b(b_), c(c_) {}
+
+    [[nodiscard]] vec<3, T> normal() const noexcept {
+        return (b - a).cross(c - a).normalized();
+    }
+
+    [[nodiscard]] T area() const noexcept {
+        return (b - a).cross(c - a).length() * T{0.5};
+    }
+
+    [[nodiscard]] constexpr vec<3, T> centroid() const noexcept {
+        return (a + b + c) / T{3};
+    }
+
+    //NOTE: point = a + u * (b - a) + v * (c - a)
+    [[nodiscard]] constexpr vec<3, T> at(T u, T v) const noexcept {
+        return a + (b - a) * u + (c - a) * v;
+    }
+};
+
+} // namespace cc
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "./op.hpp"
+#include "../detail/arithmetic.hpp"
+#include "../detail/simd.hpp"
+#include "../vec/base.hpp"
+#include "../vec/vec2.hpp"          // IWYU pragma: keep
+#include "../vec/vec3.hpp"          // IWYU pragma: keep
+#include "../vec/vec4.hpp"          // IWYU pragma: keep
+#include "../mat/base.hpp"
+
+#include <cstddef>
+
+//NOTE: Fused forms of common expressions. Chains of vec operators already compile to one
+//      register operation per step (the vec types are aggregates, every temporary stays in a
+//      register at -O2), so there is no expression-template layer. What the operators cannot
+//      do is reorder or fuse: a * s + b rounds twice, and m1 * m2 * v builds the full matrix
+//      product because operator* is left-associative. These functions do the fused thing.
+namespace cc {
+
+//NOTE: a * s + b; a single multiply-add per register for vec4f/vec4d, rounded once where the
+//      target has FMA
+template<std::size_t N, arithmetic T>
+[[nodiscard]] constexpr vec<N, T> fma(const vec<N, T>& a, T s, const vec<N, T>& b) noexcept {
+    if constexpr (N == 4) {
+        if !consteval {
+            if constexpr (detail::simd::has_x4<T>) {
+                vec<4, T> result;
+                detail::simd::madds4(a.data(), s, b.data(), result.data());
+                return result;
+            }
+        }
+    }
+    return a * s + b;
+}
+
+//NOTE: a * m + b, componentwise
+template<std::size_t N, arithmetic T>
+[[nodiscard]] constexpr vec<N, T> fma(const vec<N, T>& a, const vec<N, T>& m, const vec<N, T>& b) noexcept {
+    if constexpr (N == 4) {
+        if !consteval {
+            if constexpr (detail::simd::has_x4<T>) {
+                vec<4, T> result;
+                detail::simd::madd4(a.data(), m.data(), b.data(), result.data());
+                return result;
+            }
+        }
+    }
+    return a * m + b;
+}
+
+//NOTE: a at t = 0, b at t = 1; one subtract and one multiply-add
+template<std::size_t N, floating_point T>
+[[nodiscard]] constexpr vec<N, T> lerp(const vec<N, T>& a, const vec<N, T>& b, T t) noexcept {
+    return fma(b - a, t, a);
+}
+
+template<std::size_t N, arithmetic T>
+[[nodiscard]] constexpr vec<N, T> mul(const vec<N, T>& v) noexcept {
+    return v;
+}
+
+//NOTE: mul(m1, m2, ..., v) = m1 * (m2 * (... * v)): one matrix-vector product per matrix
+//      instead of the matrix products m1 * m2 * v evaluates first (32 against 80 multiply-adds
+//      for two 4x4 matrices). Worth it when the matrices change per call; a product reused
+//      for many vectors is cheaper to build once
+template<std::size_t R, std::size_t C, arithmetic T, typename... Rest>
+    requires (sizeof...(Rest) > 0)
+[[nodiscard]] constexpr auto mul(const mat<R, C, T>& m, const Rest&... rest) noexcept {
+    return m * mul(rest...);
+}
+
+} // namespace cc
@@ -3,6 +3,7 @@
 #include "../mat/fwd.hpp"
 #include "../vec/fwd.hpp"
 #include "../detail/arithmetic.hpp"
+#include "../detail/simd.hpp"
 #include <cstddef>
 
 namespace cc {
@@ -20,6 +21,23 @@ template<std::size_t Rows, std::size_t Cols, arithmetic T>
     return result;
 }
 
+//NOTE: 4x4 * vec4 is the transform hot path: one broadcast-multiply-add per column
+template<arithmetic T>
+[[nodiscard]] constexpr vec<4, T> operator*(const mat<4, 4, T>& m, const vec<4, T>& v) noexcept {
+    if !consteval {
+        if constexpr (detail::simd::has_x4<T>) {
+            vec<4, T> result{};
+            detail::simd::mul_mat4_vec4(m.data(), v.data(), result.data());
+            return result;
+        }
+    }
+    vec<4, T> result{};
+    for (std::size_t i = 0; i < 4; ++i) {
+        result[i] = m(i, 0) * v[0] + m(i, 1) * v[1] + m(i, 2) * v[2] + m(i, 3) * v[3];
+    }
+    return result;
+}
+
 template<std::size_t Rows, std::size_t Cols, arithmetic T>
 [[nodiscard]] constexpr vec<Cols, T> operator*(const vec<Rows, T>& v, const mat<Rows, Cols, T>& m) noexcept {
     vec<Cols, T> result{};
@@ -0,0 +1,180 @@
+#pragma once
+
+#include "../detail/arithmetic.hpp"
+#include "../common/functions.hpp"   // IWYU pragma: keep
+#include "../vec/base.hpp"
+#include "../vec/vec3.hpp"           // IWYU pragma: keep
+#include "../mat/mat3.hpp"           // IWYU pragma: keep
+#include "../mat/mat4.hpp"           // IWYU pragma: keep
+#include "../mat/decompose.hpp"
+#include "../quat/quat.hpp"
+
+#include <type_traits>
+
+//NOTE: Translation, rotation and scale kept apart (40 bytes as floats, against 64 for a mat4) so
+//      hierarchies, animation and replication can compose and blend them without building
+//      matrices; to_mat4() at upload time. Points map as translation + rotation * (scale * p),
+//      i.e. the matrix translate(t) * rotation.to_mat4() * scale(s). rotation is expected to be
+//      a unit quaternion.
+//
+//      A TRS cannot hold shear, which a parent with non-uniform scale produces on a rotated
+//      child: operator* and inverse() are exact when the scale involved is uniform (or the
+//      rotations are axis aligned) and otherwise keep the per-axis scale as game engines do.
+namespace cc {
+
+namespace detail {
+
+//NOTE: q * v * q^-1 for unit q without building the product quaternions: v + 2w(q x v) + 2q x (q x v)
+template<floating_point T>
+[[nodiscard]] constexpr vec<3, T> rotate_unit(const quat<T>& q, const vec<3, T>& v) noexcept {
+    const vec<3, T> u(q.x, q.y, q.z);
+    const vec<3, T> c = u.cross(v) * T{2};
+    return v + c * q.w + u.cross(c);
+}
+
+} // namespace detail
+
+template<floating_point T>
+struct transform3 {
+    using value_type = T;
+
+    vec<3, T> translation{};
+    quat<T> rotation{};
+    vec<3, T> scale{T{1}, T{1}, T{1}};
+
+    constexpr transform3() noexcept = default;
+
+    constexpr transform3(const vec<3, T>& translation_, const quat<T>& rotation_,
+                         const vec<3, T>& scale_ = vec<3, T>(T{1}, T{1}, T{1})) noexcept
+        : translation(translation_), rotation(rotation_), scale(scale_) {}
+
+    [[nodiscard]] static constexpr transform3 identity() noexcept {
+        return transform3();
+    }
+
+    [[nodiscard]] constexpr vec<3, T> transform_point(const vec<3, T>& p) const noexcept {
+        return translation + detail::rotate_unit(rotation, scale * p);
+    }
+
+    [[nodiscard]] constexpr vec<3, T> transform_vector(const vec<3, T>& v) const noexcept {
+        return detail::rotate_unit(rotation, scale * v);
+    }
+
+    //NOTE: exact for uniform scale; otherwise the scale is inverted per axis in place
+    [[nodiscard]] constexpr transform3 inverse() const noexcept {
+        const quat<T> r = rotation.conjugate();
+        const vec<3, T> s = vec<3, T>(T{1}, T{1}, T{1}) / scale;
+        return transform3(s * detail::rotate_unit(r, -translation), r, s);
+    }
+
+    [[nodiscard]] constexpr mat<4, 4, T> to_mat4() const noexcept {
+        const T xx = rotation.x * rotation.x;
+        const T yy = rotation.y * rotation.y;
+        const T zz = rotation.z * rotation.z;
+        const T xy = rotation.x * rotation.y;
+        const T xz = rotation.x * rotation.z;
+        const T yz = rotation.y * rotation.z;
+        const T wx = rotation.w * rotation.x;
+        const T wy = rotation.w * rotation.y;
+        const T wz = rotation.w * rotation.z;
+        const T sx = scale[0];
+        const T sy = scale[1];
+        const T sz = scale[2];
+
+        return mat<4, 4, T>(layout::rowm,
+                            (T{1} - T{2} * (yy + zz)) * sx, T{2} * (xy - wz) * sy,          T{2} * (xz + wy) * sz,          translation[0],
+                            T{2} * (xy + wz) * sx,          (T{1} - T{2} * (xx + zz)) * sy, T{2} * (yz - wx) * sz,          translation[1],
+                            T{2} * (xz - wy) * sx,          T{2} * (yz + wx) * sy,          (T{1} - T{2} * (xx + yy)) * sz, translation[2],
+                            T{0},                           T{0},                           T{0},                           T{1});
+    }
+
+    //NOTE: a * b applies b first, like the matrices: (a * b).to_mat4() == a.to_mat4() * b.to_mat4()
+    //      within the limits above
+    [[nodiscard]] friend constexpr transform3 operator*(const transform3& a, const transform3& b) noexcept {
+        return transform3(a.transform_point(b.translation), a.rotation * b.rotation, a.scale * b.scale);
+    }
+
+    constexpr transform3& operator*=(const transform3& rhs) noexcept {
+        *this = *this * rhs;
+        return *this;
+    }
+};
+
+template<floating_point T>
+[[nodiscard]] constexpr bool operator==(const transform3<T>& a, const transform3<T>& b) noexcept {
+    return a.translation == b.translation && a.rotation == b.rotation && a.scale == b.scale;
+}
+
+template<floating_point T>
+[[nodiscard]] constexpr bool operator!=(const transform3<T>& a, const transform3<T>& b) noexcept {
+    return !(a == b);
+}
+
+//NOTE: componentwise blend for animation; translation and scale linearly, rotation by slerp
+//      along the shorter arc
+template<floating_point T>
+[[nodiscard]] inline transform3<T> lerp(const transform3<T>& a, const transform3<T>& b, T t) noexcept {
+    return transform3<T>(a.translation + (b.translation - a.translation) * t,
+                         slerp(a.rotation, b.rotation, t),
+                         a.scale + (b.scale - a.scale) * t);
+}
+
+//NOTE: the TRS nearest to an affine m (the last row is ignored). Scale is the length of each
+//      basis column, negated on x when m mirrors; the rotation is the polar factor of the
+//      normalized columns, so shear and rounding are projected out. A zero-scale axis leaves
+//      the rotation undetermined, and it is the identity then. Exact round trip for to_mat4()
+//      of a transform without zero scale.
+template<floating_point T>
+[[nodiscard]] inline transform3<T> decompose(const mat<4, 4, T>& m) noexcept {
+    mat<3, 3, T> a;
+    for (std::size_t c = 0; c < 3; ++c) {
+        for (std::size_t r = 0; r < 3; ++r) {
+            a(r, c) = m(r, c);
+        }
+    }
+
+    vec<3, T> s;
+    for (std::size_t c = 0; c < 3; ++c) {
+        s[c] = sqrt(a(0, c) * a(0, c) + a(1, c) * a(1, c) + a(2, c) * a(2, c));
+    }
+    if (det(a) < T{0}) {
+        s[0] = -s[0];
+    }
+
+    const vec<3, T> translation(m(0, 3), m(1, 3), m(2, 3));
+
+    //NOTE: also catches an all-zero basis, where the tolerance itself is zero
+    const T tolerance = max(max(abs(s[0]), abs(s[1])), abs(s[2])) * epsilon<T> * T{16};
+    for (std::size_t c = 0; c < 3; ++c) {
+        if (!(abs(s[c]) > tolerance)) {
+            return transform3<T>(translation, quat<T>::identity(), s);
+        }
+    }
+
+    for (std::size_t c = 0; c < 3; ++c) {
+        const T inv = T{1} / s[c];
+        for (std::size_t r = 0; r < 3; ++r) {
+            a(r, c) *= inv;
+        }
+    }
+
+    //NOTE: the polar decomposition only when the columns are not already orthonormal
+    T skew = T{0};
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = i; j < 3; ++j) {
+            T d = a(0, i) * a(0, j) + a(1, i) * a(1, j) + a(2, i) * a(2, j);
+            d -= i == j ? T{1} : T{0};
+            skew = max(skew, abs(d));
+        }
+    }
+    if (skew > T{64} * epsilon<T>) {
+        a = polar(a).r;
+    }
+
+    return transform3<T>(translation, quat<T>::from_mat3(a).normalized(), s);
+}
+
+static_assert(std::is_trivially_copyable_v<transform3<float>>);
+static_assert(sizeof(transform3<float>) == 40);
+
+} // namespace cc
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "./jacobi3.hpp"
+#include "../detail/arithmetic.hpp"
+#include "../vec/base.hpp"
+#include "../vec/vec3.hpp"          // IWYU pragma: keep
+#include "../mat/mat3.hpp"          // IWYU pragma: keep
+
+//NOTE: 3x3 SVD, symmetric eigendecomposition and polar decomposition for mat3f and mat3d, the
+//      building blocks of point-set registration (Kabsch), deformation gradients and covariance
+//      analysis. All three run a fixed instruction sequence without data-dependent branches (see
+//      mat/jacobi3.hpp); cc::batch::svd_many and friends run the same code on 4 or 8 matrices at
+//      once. Reconstruction errors stay below 1e-5 (float) and 1e-14 (double) relative to the
+//      largest singular value or eigenvalue; u, v and the eigenvectors are orthonormal to 2e-6
+//      and 3e-15.
+namespace cc {
+
+//NOTE: a = u * diag(s) * v^T; u and v are rotations and |s.x| >= |s.y| >= |s.z|. s.x and s.y are
+//      non-negative, s.z carries the sign of det(a), so a reflection never leaks into u or v
+template<floating_point T>
+struct svd_result {
+    mat<3, 3, T> u;
+    vec<3, T>    s;
+    mat<3, 3, T> v;
+};
+
+//NOTE: a = vectors * diag(values) * vectors^T; values descending, the columns of vectors are the
+//      matching unit eigenvectors and form a rotation
+template<floating_point T>
+struct eigen_result {
+    vec<3, T>    values;
+    mat<3, 3, T> vectors;
+};
+
+//NOTE: a = r * s with r a rotation and s symmetric; s is positive semi-definite unless
+//      det(a) < 0, in which case it has one negative eigenvalue
+template<floating_point T>
+struct polar_result {
+    mat<3, 3, T> r;
+    mat<3, 3, T> s;
+};
+
+namespace detail {
+
+template<floating_point T>
+using decompose_lane = basic_scalar_lane<T>;
+
+template<floating_point T>
+[[nodiscard]] inline jacobi3::mat3<decompose_lane<T>> to_lanes(const mat<3, 3, T>& m) noexcept {
+    jacobi3::mat3<decompose_lane<T>> r;
+    for (int i = 0; i < 9; ++i) {
+        r.e[i] = m.data()[i];
+    }
+    return r;
+}
+
+template<floating_point T>
+[[nodiscard]] inline mat<3, 3, T> from_lanes(const jacobi3::mat3<decompose_lane<T>>& m) noexcept {
+    mat<3, 3, T> r;
+    for (int i = 0; i < 9; ++i) {
+        r.data()[i] = m.e[i];
+    }
+    return r;
+}
+
+} // namespace detail
+
+template<floating_point T>
+[[nodiscard]] inline svd_result<T> svd(const mat<3, 3, T>& a) noexcept {
+    using lane = detail::decompose_lane<T>;
+    detail::jacobi3::mat3<lane> u;
+    detail::jacobi3::mat3<lane> v;
+    T s[3];
+    detail::jacobi3::svd<lane>(detail::to_lanes(a), u, s, v);
+    return {detail::from_lanes(u), vec<3, T>(s[0], s[1], s[2]), detail::from_lanes(v)};
+}
+
+//NOTE: a must be symmetric; only its lower triangle is read
+template<floating_point T>
+[[nodiscard]] inline eigen_result<T> eigen_symmetric(const mat<3, 3, T>& a) noexcept {
+    using lane = detail::decompose_lane<T>;
+    detail::jacobi3::mat3<lane> v;
+    T values[3];
+    detail::jacobi3::eigen_symmetric<lane>(detail::to_lanes(a), values, v);
+    return {vec<3, T>(values[0], values[1], values[2]), detail::from_lanes(v)};
+}
+
+template<floating_point T>
+[[nodiscard]] inline polar_result<T> polar(const mat<3, 3, T>& a) noexcept {
+    using lane = detail::decompose_lane<T>;
+    detail::jacobi3::mat3<lane> r;
+    detail::jacobi3::mat3<lane> s;
+    detail::jacobi3::polar<lane>(detail::to_lanes(a), r, s);
+    return {detail::from_lanes(r), detail::from_lanes(s)};
+}
+
+} // namespace cc
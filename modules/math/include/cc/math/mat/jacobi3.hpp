@@ -0,0 +1,274 @@
+#pragma once
+
+#include "../detail/lane.hpp"
+
+#include <type_traits>
+
+//NOTE: Lane-generic 3x3 decompositions (see detail/lane.hpp) shared by mat/decompose.hpp and the
+//      cc::batch kernel TUs. The SVD follows McAdams et al., "Computing the Singular Value
+//      Decomposition of 3x3 matrices with minimal branching and elementary floating point
+//      operations" (2011): Jacobi eigenanalysis of A^T A with approximate Givens rotations and a
+//      fixed number of sweeps, a sort by conditional swaps, then a Givens QR of A V. Every
+//      branch is a select, so all lanes run the same instructions.
+namespace cc::detail::jacobi3 {
+
+template<typename L>
+using f_t = typename L::f;
+
+template<typename L>
+using m_t = typename L::m;
+
+//NOTE: column-major like cc::mat, a(r, c) = e[c * 3 + r]
+template<typename L>
+struct mat3 {
+    f_t<L> e[9];
+
+    [[nodiscard]] f_t<L>& operator()(int r, int c) noexcept { return e[c * 3 + r]; }
+    [[nodiscard]] const f_t<L>& operator()(int r, int c) const noexcept { return e[c * 3 + r]; }
+};
+
+//NOTE: the lower triangle of a symmetric matrix
+template<typename L>
+struct sym3 {
+    f_t<L> s11, s21, s22, s31, s32, s33;
+};
+
+//NOTE: McAdams et al. stop after 4 sweeps; over random matrices that leaves outliers with a
+//      relative error near 1e-2, 6 sweeps bring the worst case to 1e-5 and double needs 8
+template<typename L>
+inline constexpr int sweeps = sizeof(f_t<L>) == sizeof(double) ? 8 : 6;
+
+template<typename L>
+inline void cond_swap(m_t<L> c, f_t<L>& x, f_t<L>& y) noexcept {
+    const f_t<L> t = x;
+    x = L::select(c, y, x);
+    y = L::select(c, t, y);
+}
+
+//NOTE: swaps and negates one side, so swapping two columns of a rotation keeps it a rotation
+template<typename L>
+inline void cond_neg_swap(m_t<L> c, f_t<L>& x, f_t<L>& y) noexcept {
+    const f_t<L> t = -x;
+    x = L::select(c, y, x);
+    y = L::select(c, t, y);
+}
+
+template<typename L>
+inline void cond_neg_swap_cols(m_t<L> c, mat3<L>& a, int i, int j) noexcept {
+    for (int r = 0; r < 3; ++r) {
+        cond_neg_swap<L>(c, a(r, i), a(r, j));
+    }
+}
+
+template<typename L>
+[[nodiscard]] inline mat3<L> multiply(const mat3<L>& a, const mat3<L>& b) noexcept {
+    mat3<L> r;
+    for (int c = 0; c < 3; ++c) {
+        for (int i = 0; i < 3; ++i) {
+            r(i, c) = a(i, 0) * b(0, c) + a(i, 1) * b(1, c) + a(i, 2) * b(2, c);
+        }
+    }
+    return r;
+}
+
+//NOTE: a * diag(d) * b^T
+template<typename L>
+[[nodiscard]] inline mat3<L> multiply_diag_transpose(const mat3<L>& a, const f_t<L>* d, const mat3<L>& b) noexcept {
+    mat3<L> r;
+    for (int c = 0; c < 3; ++c) {
+        for (int i = 0; i < 3; ++i) {
+            r(i, c) = a(i, 0) * d[0] * b(c, 0) + a(i, 1) * d[1] * b(c, 1) + a(i, 2) * d[2] * b(c, 2);
+        }
+    }
+    return r;
+}
+
+//NOTE: one approximate Givens conjugation S = Q^T S Q in the (X, Y) plane, accumulated into the
+//      quaternion q = (x, y, z, w); S is then cycled so the next call works on the next pair
+template<typename L, int X, int Y, int Z>
+inline void conjugate(sym3<L>& s, f_t<L> (&q)[4]) noexcept {
+    using F = f_t<L>;
+    using T = std::conditional_t<sizeof(F) == sizeof(double), double, float>;    // SIMD lanes are float
+    constexpr double sqrt_gamma = 2.414213562373095;    // sqrt(3 + 2 sqrt(2))
+    constexpr double negligible = sizeof(F) == sizeof(double) ? 1e-20 : 1e-10;
+    constexpr double cstar      = 0.9238795325112867;   // cos(pi / 8)
+    constexpr double sstar      = 0.3826834323650898;   // sin(pi / 8)
+
+    //NOTE: off-diagonals that no longer matter are dropped instead of rotated further; past that
+    //      point their products would be denormal, which is slower than the whole sweep
+    F ch = F(2.0f) * (s.s11 - s.s22);
+    F sh = s.s21;
+    const F scale = L::max(s.s11, -s.s11) + L::max(s.s22, -s.s22);
+    sh = L::select(L::gt(L::max(sh, -sh), F(static_cast<T>(negligible)) * scale), sh, F(0.0f));
+    const m_t<L> exact = L::gt(L::max(ch, -ch), F(static_cast<T>(sqrt_gamma)) * L::max(sh, -sh));
+    const F w = F(1.0f) / L::sqrt(ch * ch + sh * sh);
+    ch = L::select(exact, w * ch, F(static_cast<T>(cstar)));
+    sh = L::select(exact, w * sh, F(static_cast<T>(sstar)));
+
+    const F a = ch * ch - sh * sh;
+    const F b = F(2.0f) * sh * ch;
+
+    const sym3<L> t = s;
+    const F s11 = a * (a * t.s11 + b * t.s21) + b * (a * t.s21 + b * t.s22);
+    const F s21 = a * (a * t.s21 - b * t.s11) + b * (a * t.s22 - b * t.s21);
+    const F s22 = a * (a * t.s22 - b * t.s21) - b * (a * t.s21 - b * t.s11);
+    const F s31 = a * t.s31 + b * t.s32;
+    const F s32 = a * t.s32 - b * t.s31;
+
+    const F qx = q[X] * sh;
+    const F qy = q[Y] * sh;
+    const F qz = q[Z] * sh;
+    sh = sh * q[3];
+    for (F& v : q) {
+        v = v * ch;
+    }
+    q[Z] = q[Z] + sh;
+    q[3] = q[3] - qz;
+    q[X] = q[X] + qy;
+    q[Y] = q[Y] - qx;
+
+    s = {s22, s32, t.s33, s21, s31, s11};
+}
+
+//NOTE: S = V D V^T; on return s holds D on its diagonal and v is a rotation
+template<typename L>
+inline void eigenanalysis(sym3<L>& s, mat3<L>& v) noexcept {
+    using F = f_t<L>;
+    F q[4] = {F(0.0f), F(0.0f), F(0.0f), F(1.0f)};
+    for (int i = 0; i < sweeps<L>; ++i) {
+        conjugate<L, 0, 1, 2>(s, q);
+        conjugate<L, 1, 2, 0>(s, q);
+        conjugate<L, 2, 0, 1>(s, q);
+    }
+
+    const F n = F(1.0f) / L::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    const F x = q[0] * n;
+    const F y = q[1] * n;
+    const F z = q[2] * n;
+    const F w = q[3] * n;
+    v(0, 0) = F(1.0f) - F(2.0f) * (y * y + z * z);
+    v(0, 1) = F(2.0f) * (x * y - w * z);
+    v(0, 2) = F(2.0f) * (x * z + w * y);
+    v(1, 0) = F(2.0f) * (x * y + w * z);
+    v(1, 1) = F(1.0f) - F(2.0f) * (x * x + z * z);
+    v(1, 2) = F(2.0f) * (y * z - w * x);
+    v(2, 0) = F(2.0f) * (x * z - w * y);
+    v(2, 1) = F(2.0f) * (y * z + w * x);
+    v(2, 2) = F(1.0f) - F(2.0f) * (x * x + y * y);
+}
+
+//NOTE: Givens rotation (c, s) that zeroes a2 against the pivot a1, returned as
+//      c^2 - s^2 and 2 c s; the guard only matters when both are (nearly) zero
+template<typename L>
+inline void qr_givens(f_t<L> a1, f_t<L> a2, f_t<L>& cos_out, f_t<L>& sin_out) noexcept {
+    using F = f_t<L>;
+    const F eps = F(1e-18f);
+    const F rho = L::sqrt(a1 * a1 + a2 * a2);
+    F sh = L::select(L::gt(rho, eps), a2, F(0.0f));
+    F ch = L::max(a1, -a1) + L::max(rho, eps);
+    cond_swap<L>(L::gt(F(0.0f), a1), sh, ch);
+    const F w = F(1.0f) / L::sqrt(ch * ch + sh * sh);
+    ch = ch * w;
+    sh = sh * w;
+    cos_out = ch * ch - sh * sh;
+    sin_out = F(2.0f) * ch * sh;
+}
+
+//NOTE: rows i and j of a become c * a_i + s * a_j and c * a_j - s * a_i
+template<typename L>
+inline void rotate_rows(mat3<L>& a, int i, int j, f_t<L> c, f_t<L> s) noexcept {
+    for (int k = 0; k < 3; ++k) {
+        const f_t<L> ai = a(i, k);
+        const f_t<L> aj = a(j, k);
+        a(i, k) = c * ai + s * aj;
+        a(j, k) = c * aj - s * ai;
+    }
+}
+
+//NOTE: B = U R with U a rotation; b is overwritten with R
+template<typename L>
+inline void qr(mat3<L>& b, mat3<L>& u) noexcept {
+    using F = f_t<L>;
+    F c1, s1, c2, s2, c3, s3;
+    qr_givens<L>(b(0, 0), b(1, 0), c1, s1);
+    rotate_rows<L>(b, 0, 1, c1, s1);
+    qr_givens<L>(b(0, 0), b(2, 0), c2, s2);
+    rotate_rows<L>(b, 0, 2, c2, s2);
+    qr_givens<L>(b(1, 1), b(2, 1), c3, s3);
+    rotate_rows<L>(b, 1, 2, c3, s3);
+
+    //NOTE: U = Q1 Q2 Q3, multiplied out
+    u(0, 0) = c1 * c2;
+    u(1, 0) = s1 * c2;
+    u(2, 0) = s2;
+    u(0, 1) = -(s1 * c3) - c1 * s2 * s3;
+    u(1, 1) = c1 * c3 - s1 * s2 * s3;
+    u(2, 1) = c2 * s3;
+    u(0, 2) = s1 * s3 - c1 * s2 * c3;
+    u(1, 2) = -(c1 * s3) - s1 * s2 * c3;
+    u(2, 2) = c2 * c3;
+}
+
+//NOTE: A = U diag(s) V^T with U and V rotations and |s0| >= |s1| >= |s2|; s0 and s1 are
+//      non-negative, s2 is negative when det(A) < 0
+template<typename L>
+inline void svd(const mat3<L>& a, mat3<L>& u, f_t<L> (&s)[3], mat3<L>& v) noexcept {
+    using F = f_t<L>;
+    const auto dot = [&](int i, int j) {
+        return a(0, i) * a(0, j) + a(1, i) * a(1, j) + a(2, i) * a(2, j);
+    };
+    sym3<L> ata{dot(0, 0), dot(1, 0), dot(1, 1), dot(2, 0), dot(2, 1), dot(2, 2)};
+    eigenanalysis<L>(ata, v);
+
+    mat3<L> b = multiply<L>(a, v);
+    F rho[3];
+    for (int c = 0; c < 3; ++c) {
+        rho[c] = b(0, c) * b(0, c) + b(1, c) * b(1, c) + b(2, c) * b(2, c);
+    }
+    constexpr int pairs[3][2] = {{0, 1}, {0, 2}, {1, 2}};
+    for (const auto& p : pairs) {
+        const m_t<L> c = L::gt(rho[p[1]], rho[p[0]]);
+        cond_neg_swap_cols<L>(c, b, p[0], p[1]);
+        cond_neg_swap_cols<L>(c, v, p[0], p[1]);
+        cond_swap<L>(c, rho[p[0]], rho[p[1]]);
+    }
+
+    qr<L>(b, u);
+    s[0] = b(0, 0);
+    s[1] = b(1, 1);
+    s[2] = b(2, 2);
+}
+
+//NOTE: S = V diag(values) V^T for symmetric S (only the lower triangle is read), values in
+//      descending order and V a rotation
+template<typename L>
+inline void eigen_symmetric(const mat3<L>& a, f_t<L> (&values)[3], mat3<L>& v) noexcept {
+    sym3<L> s{a(0, 0), a(1, 0), a(1, 1), a(2, 0), a(2, 1), a(2, 2)};
+    eigenanalysis<L>(s, v);
+    values[0] = s.s11;
+    values[1] = s.s22;
+    values[2] = s.s33;
+
+    constexpr int pairs[3][2] = {{0, 1}, {0, 2}, {1, 2}};
+    for (const auto& p : pairs) {
+        const m_t<L> c = L::gt(values[p[1]], values[p[0]]);
+        cond_neg_swap_cols<L>(c, v, p[0], p[1]);
+        cond_swap<L>(c, values[p[0]], values[p[1]]);
+    }
+}
+
+//NOTE: A = R S with R = U V^T a rotation and S = V diag(s) V^T symmetric; S has a negative
+//      eigenvalue when det(A) < 0
+template<typename L>
+inline void polar(const mat3<L>& a, mat3<L>& r, mat3<L>& s) noexcept {
+    using F = f_t<L>;
+    mat3<L> u;
+    mat3<L> v;
+    F sigma[3];
+    svd<L>(a, u, sigma, v);
+    const F one[3] = {F(1.0f), F(1.0f), F(1.0f)};
+    r = multiply_diag_transpose<L>(u, one, v);
+    s = multiply_diag_transpose<L>(v, sigma, v);
+}
+
+} // namespace cc::detail::jacobi3
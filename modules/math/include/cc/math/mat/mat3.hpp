@@ -166,7 +166,7 @@ public:
     }
 
     [[nodiscard]] constexpr mat transpose() const noexcept {
-        return mat(layout::colm,
+        return mat(layout::rowm,
                    m00, m10, m20,
                    m01, m11, m21,
                    m02, m12, m22);
@@ -2,16 +2,20 @@
 
 #include "fwd.hpp"
 #include "../detail/arithmetic.hpp"
+#include "../detail/simd.hpp"
 #include "../common/functions.hpp"
 
 #include <array>
 #include <cassert>
+#include <concepts>
 #include <cstddef>
 
 namespace cc {
 
+//NOTE: columns are aligned so mat4f/mat4d load each column as one __m128/__m256d; constant
+//      evaluation always takes the scalar path.
 template<arithmetic T>
-class mat<4, 4, T> {
+class alignas(4 * sizeof(T)) mat<4, 4, T> {
 public:
     static constexpr std::size_t rows = 4;
     static constexpr std::size_t cols = 4;
@@ -136,32 +140,46 @@ public:
         return *this;
     }
 
-    [[nodiscard]] friend constexpr mat operator+(mat a, const mat& b) noexcept {
-        a += b;
-        return a;
+    //NOTE: operands by reference: mat<4, 4, double> is 32-byte aligned, and passing it by value
+    //      draws GCC's -Wpsabi note on targets without AVX
+    [[nodiscard]] friend constexpr mat operator+(const mat& a, const mat& b) noexcept {
+        mat result = a;
+        result += b;
+        return result;
     }
 
-    [[nodiscard]] friend constexpr mat operator-(mat a, const mat& b) noexcept {
-        a -= b;
-        return a;
+    [[nodiscard]] friend constexpr mat operator-(const mat& a, const mat& b) noexcept {
+        mat result = a;
+        result -= b;
+        return result;
     }
 
-    [[nodiscard]] friend constexpr mat operator*(mat a, T s) noexcept {
-        a *= s;
-        return a;
+    [[nodiscard]] friend constexpr mat operator*(const mat& a, T s) noexcept {
+        mat result = a;
+        result *= s;
+        return result;
     }
 
-    [[nodiscard]] friend constexpr mat operator*(T s, mat a) noexcept {
-        a *= s;
-        return a;
+    [[nodiscard]] friend constexpr mat operator*(T s, const mat& a) noexcept {
+        mat result = a;
+        result *= s;
+        return result;
     }
 
-    [[nodiscard]] friend constexpr mat operator/(mat a, T s) noexcept {
-        a /= s;
-        return a;
+    [[nodiscard]] friend constexpr mat operator/(const mat& a, T s) noexcept {
+        mat result = a;
+        result /= s;
+        return result;
     }
 
     [[nodiscard]] friend constexpr mat operator*(const mat& a, const mat& b) noexcept {
+        if !consteval {
+            if constexpr (detail::simd::has_x4<T>) {
+                mat result;
+                detail::simd::mul_mat4(a.data(), b.data(), result.data());
+                return result;
+            }
+        }
         return mat(layout::rowm,
                    a.m00 * b.m00 + a.m01 * b.m10 + a.m02 * b.m20 + a.m03 * b.m30,
                    a.m00 * b.m01 + a.m01 * b.m11 + a.m02 * b.m21 + a.m03 * b.m31,
@@ -185,7 +203,14 @@ public:
     }
 
     [[nodiscard]] constexpr mat transpose() const noexcept {
-        return mat(layout::colm,
+        if !consteval {
+            if constexpr (detail::simd::has_x4<T>) {
+                mat result;
+                detail::simd::transpose_mat4(data(), result.data());
+                return result;
+            }
+        }
+        return mat(layout::rowm,
                    m00, m10, m20, m30,
                    m01, m11, m21, m31,
                    m02, m12, m22, m32,
@@ -232,6 +257,14 @@ public:
     }
 
     [[nodiscard]] mat inverse() const noexcept requires floating_point<T> {
+        if constexpr (std::same_as<T, float> && detail::simd::has_x4<T>) {
+            mat result;
+            if (!detail::simd::inverse_mat4(data(), result.data())) {
+                return identity();
+            }
+            return result;
+        }
+
         const T a0 = m00 * m11 - m01 * m10;
         const T a1 = m00 * m12 - m02 * m10;
         const T a2 = m00 * m13 - m03 * m10;
@@ -273,6 +306,61 @@ public:
                    (-m30 * a3 + m31 * a1 - m32 * a0) * inv_det,
                    ( m20 * a3 - m21 * a1 + m22 * a0) * inv_det);
     }
+
+    //NOTE: for matrices whose bottom row is (0, 0, 0, 1), e.g. translate * rotate * scale;
+    //      [A | t]^-1 = [A^-1 | -A^-1 t], with A^-1 built from cross products of A's columns
+    [[nodiscard]] mat inverse_affine() const noexcept requires floating_point<T> {
+        if constexpr (std::same_as<T, float> && detail::simd::has_x4<T>) {
+            mat result;
+            if (!detail::simd::inverse_affine_mat4(data(), result.data())) {
+                return identity();
+            }
+            return result;
+        }
+
+        //NOTE: rows of A^-1 are (c1 x c2, c2 x c0, c0 x c1) / det
+        const T r00 = m11 * m22 - m21 * m12;
+        const T r01 = m21 * m02 - m01 * m22;
+        const T r02 = m01 * m12 - m11 * m02;
+        const T r10 = m12 * m20 - m22 * m10;
+        const T r11 = m22 * m00 - m02 * m20;
+        const T r12 = m02 * m10 - m12 * m00;
+        const T r20 = m10 * m21 - m20 * m11;
+        const T r21 = m20 * m01 - m00 * m21;
+        const T r22 = m00 * m11 - m10 * m01;
+
+        const T d = m00 * r00 + m10 * r01 + m20 * r02;
+        if (abs(d) <= epsilon<T>) {
+            return identity();
+        }
+
+        const T inv_det = T{1} / d;
+        const T i00 = r00 * inv_det, i01 = r01 * inv_det, i02 = r02 * inv_det;
+        const T i10 = r10 * inv_det, i11 = r11 * inv_det, i12 = r12 * inv_det;
+        const T i20 = r20 * inv_det, i21 = r21 * inv_det, i22 = r22 * inv_det;
+
+        return mat(layout::rowm,
+                   i00, i01, i02, -(i00 * m03 + i01 * m13 + i02 * m23),
+                   i10, i11, i12, -(i10 * m03 + i11 * m13 + i12 * m23),
+                   i20, i21, i22, -(i20 * m03 + i21 * m13 + i22 * m23),
+                   T{0}, T{0}, T{0}, T{1});
+    }
+
+    //NOTE: for rotation + translation only (orthonormal upper 3x3, no scale);
+    //      [R | t]^-1 = [R^T | -R^T t]
+    [[nodiscard]] mat inverse_rigid() const noexcept requires floating_point<T> {
+        if constexpr (std::same_as<T, float> && detail::simd::has_x4<T>) {
+            mat result;
+            detail::simd::inverse_rigid_mat4(data(), result.data());
+            return result;
+        }
+
+        return mat(layout::rowm,
+                   m00, m10, m20, -(m00 * m03 + m10 * m13 + m20 * m23),
+                   m01, m11, m21, -(m01 * m03 + m11 * m13 + m21 * m23),
+                   m02, m12, m22, -(m02 * m03 + m12 * m13 + m22 * m23),
+                   T{0}, T{0}, T{0}, T{1});
+    }
 };
 
 } // namespace cc
@@ -0,0 +1,348 @@
+#pragma once
+
+#include "./base.hpp"
+#include "./mat3.hpp"                   // IWYU pragma: keep
+#include "./mat4.hpp"                   // IWYU pragma: keep
+#include "../detail/arithmetic.hpp"
+#include "../detail/unroll.hpp"
+#include "../common/constants.hpp"
+#include "../common/functions.hpp"
+#include "../vec/base.hpp"
+#include "../vec/vec2.hpp"              // IWYU pragma: keep
+#include "../vec/vec3.hpp"              // IWYU pragma: keep
+#include "../vec/vec4.hpp"              // IWYU pragma: keep
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+//NOTE: Dense solvers for small fixed-size systems (IK Jacobians, calibration, local fits): LU with
+//      partial pivoting, Cholesky and Householder QR, plus least squares on top of QR. Everything
+//      is sized at compile time and lives on the stack; up to 8 rows and columns every loop is
+//      unrolled (detail/unroll.hpp), so a 4x4 solve is straight-line code.
+//
+//      Factorizations return std::nullopt instead of dividing by a vanishing pivot: LU when the
+//      matrix is singular, Cholesky when it is not symmetric positive definite and QR when the
+//      columns are linearly dependent, all judged against n * epsilon times the largest entry.
+//      Factor once and call solve() per right-hand side when the matrix is reused.
+namespace cc {
+
+//NOTE: p * a = l * u with l unit lower triangular; both share lu, l below the diagonal (its unit
+//      diagonal is implied) and u on and above it. Row i of p * a is row perm[i] of a
+template<std::size_t N, floating_point T>
+struct lu_factors {
+    mat<N, N, T>               lu;
+    std::array<std::size_t, N> perm;
+    T                          sign;   // det(p), +1 or -1
+};
+
+//NOTE: a = l * l^T with l lower triangular and a positive diagonal; the upper triangle is zero
+template<std::size_t N, floating_point T>
+struct cholesky_factors {
+    mat<N, N, T> l;
+};
+
+//NOTE: a = q * r with q = h_0 * ... * h_(C-1), h_k = I - tau[k] * v_k * v_k^T. r is on and above
+//      the diagonal of qr, v_k below it in column k (with v_k[k] = 1 implied)
+template<std::size_t R, std::size_t C, floating_point T>
+requires (R >= C)
+struct qr_factors {
+    mat<R, C, T>     qr;
+    std::array<T, C> tau;
+};
+
+namespace detail {
+
+//NOTE: pivots at or below this are treated as zero
+template<std::size_t R, std::size_t C, floating_point T>
+[[nodiscard]] constexpr T pivot_tolerance(const mat<R, C, T>& a) noexcept {
+    T largest = T{0};
+    for (std::size_t c = 0; c < C; ++c) {
+        for (std::size_t r = 0; r < R; ++r) {
+            largest = std::max(largest, abs(a(r, c)));
+        }
+    }
+    return static_cast<T>(std::max(R, C)) * epsilon<T> * largest;
+}
+
+} // namespace detail
+
+template<std::size_t N, floating_point T>
+[[nodiscard]] constexpr std::optional<lu_factors<N, T>> lu(const mat<N, N, T>& a) noexcept {
+    lu_factors<N, T> f{a, {}, T{1}};
+    const T tolerance = detail::pivot_tolerance(a);
+    bool singular = false;
+
+    detail::unrolled_for(detail::loop_begin<N>(), detail::loop_end<N>(), [&](auto i) {
+        f.perm[i] = i;
+    });
+
+    detail::unrolled_for(detail::loop_begin<N>(), detail::loop_end<N>(), [&](auto k) {
+        if (singular) {
+            return;
+        }
+
+        std::size_t pivot = k;
+        T largest = abs(f.lu(k, k));
+        detail::unrolled_for(detail::next_index(k), detail::loop_end<N>(), [&](auto r) {
+            const T v = abs(f.lu(r, k));
+            if (v > largest) {
+                largest = v;
+                pivot = r;
+            }
+        });
+
+        if (!(largest > tolerance)) {
+            singular = true;
+            return;
+        }
+
+        if (pivot != k) {
+            detail::unrolled_for(detail::loop_begin<N>(), detail::loop_end<N>(), [&](auto c) {
+                const T tmp = f.lu(k, c);
+                f.lu(k, c) = f.lu(pivot, c);
+                f.lu(pivot, c) = tmp;
+            });
+            std::swap(f.perm[k], f.perm[pivot]);
+            f.sign = -f.sign;
+        }
+
+        const T inv_pivot = T{1} / f.lu(k, k);
+        detail::unrolled_for(detail::next_index(k), detail::loop_end<N>(), [&](auto r) {
+            const T l = f.lu(r, k) * inv_pivot;
+            f.lu(r, k) = l;
+            detail::unrolled_for(detail::next_index(k), detail::loop_end<N>(), [&](auto c) {
+                f.lu(r, c) -= l * f.lu(k, c);
+            });
+        });
+    });
+
+    if (singular) {
+        return std::nullopt;
+    }
+    return f;
+}
+
+template<std::size_t N, floating_point T>
+[[nodiscard]] constexpr vec<N, T> solve(const lu_factors<N, T>& f, const vec<N, T>& b) noexcept {
+    //NOTE: the reciprocals are independent of each other, dividing inside the substitution would
+    //      put every division on its dependency chain
+    std::array<T, N> inv_diagonal;
+    detail::unrolled_for(detail::loop_begin<N>(), detail::loop_end<N>(), [&](auto i) {
+        inv_diagonal[i] = T{1} / f.lu(i, i);
+    });
+
+    vec<N, T> x;
+    detail::unrolled_for(detail::loop_begin<N>(), detail::loop_end<N>(), [&](auto i) {
+        T sum = b[f.perm[i]];
+        detail::unrolled_for(detail::loop_begin<N>(), i, [&](auto j) {
+            sum -= f.lu(i, j) * x[j];
+        });
+        x[i] = sum;
+    });
+    detail::unrolled_for_reverse(detail::loop_begin<N>(), detail::loop_end<N>(), [&](auto i) {
+        T sum = x[i];
+        detail::unrolled_for(detail::next_index(i), detail::loop_end<N>(), [&](auto j) {
+            sum -= f.lu(i, j) * x[j];
+        });
+        x[i] = sum * inv_diagonal[i];
+    });
+    return x;
+}
+
+//NOTE: one solve per column of b
+template<std::size_t N, std::size_t K, floating_point T>
+[[nodiscard]] constexpr mat<N, K, T> solve(const lu_factors<N, T>& f, const mat<N, K, T>& b) noexcept {
+    mat<N, K, T> x;
+    for (std::size_t c = 0; c < K; ++c) {
+        vec<N, T> column;
+        for (std::size_t r = 0; r < N; ++r) {
+            column[r] = b(r, c);
+        }
+        column = solve(f, column);
+        for (std::size_t r = 0; r < N; ++r) {
+            x(r, c) = column[r];
+        }
+    }
+    return x;
+}
+
+template<std::size_t N, floating_point T>
+[[nodiscard]] constexpr T det(const lu_factors<N, T>& f) noexcept {
+    T d = f.sign;
+    detail::unrolled_for(detail::loop_begin<N>(), detail::loop_end<N>(), [&](auto i) {
+        d *= f.lu(i, i);
+    });
+    return d;
+}
+
+//NOTE: a must be symmetric; only its lower triangle is read
+template<std::size_t N, floating_point T>
+[[nodiscard]] inline std::optional<cholesky_factors<N, T>> cholesky(const mat<N, N, T>& a) noexcept {
+    cholesky_factors<N, T> f{mat<N, N, T>(T{0})};
+    const T tolerance = detail::pivot_tolerance(a);
+    bool indefinite = false;
+
+    detail::unrolled_for(detail::loop_begin<N>(), detail::loop_end<N>(), [&](auto j) {
+        if (indefinite) {
+            return;
+        }
+
+        T d = a(j, j);
+        detail::unrolled_for(detail::loop_begin<N>(), j, [&](auto k) {
+            d -= f.l(j, k) * f.l(j, k);
+        });
+        if (!(d > tolerance)) {
+            indefinite = true;
+            return;
+        }
+
+        const T diagonal = sqrt(d);
+        const T inv_diagonal = T{1} / diagonal;
+        f.l(j, j) = diagonal;
+        detail::unrolled_for(detail::next_index(j), detail::loop_end<N>(), [&](auto i) {
+            T sum = a(i, j);
+            detail::unrolled_for(detail::loop_begin<N>(), j, [&](auto k) {
+                sum -= f.l(i, k) * f.l(j, k);
+            });
+            f.l(i, j) = sum * inv_diagonal;
+        });
+    });
+
+    if (indefinite) {
+        return std::nullopt;
+    }
+    return f;
+}
+
+template<std::size_t N, floating_point T>
+[[nodiscard]] constexpr vec<N, T> solve(const cholesky_factors<N, T>& f, const vec<N, T>& b) noexcept {
+    std::array<T, N> inv_diagonal;
+    detail::unrolled_for(detail::loop_begin<N>(), detail::loop_end<N>(), [&](auto i) {
+        inv_diagonal[i] = T{1} / f.l(i, i);
+    });
+
+    vec<N, T> x;
+    detail::unrolled_for(detail::loop_begin<N>(), detail::loop_end<N>(), [&](auto i) {
+        T sum = b[i];
+        detail::unrolled_for(detail::loop_begin<N>(), i, [&](auto j) {
+            sum -= f.l(i, j) * x[j];
+        });
+        x[i] = sum * inv_diagonal[i];
+    });
+    detail::unrolled_for_reverse(detail::loop_begin<N>(), detail::loop_end<N>(), [&](auto i) {
+        T sum = x[i];
+        detail::unrolled_for(detail::next_index(i), detail::loop_end<N>(), [&](auto j) {
+            sum -= f.l(j, i) * x[j];
+        });
+        x[i] = sum * inv_diagonal[i];
+    });
+    return x;
+}
+
+template<std::size_t R, std::size_t C, floating_point T>
+requires (R >= C)
+[[nodiscard]] inline std::optional<qr_factors<R, C, T>> qr(const mat<R, C, T>& a) noexcept {
+    qr_factors<R, C, T> f{a, {}};
+    const T tolerance = detail::pivot_tolerance(a);
+    bool deficient = false;
+
+    detail::unrolled_for(detail::loop_begin<C>(), detail::loop_end<C>(), [&](auto k) {
+        if (deficient) {
+            return;
+        }
+
+        T norm2 = T{0};
+        detail::unrolled_for(k, detail::loop_end<R>(), [&](auto r) {
+            norm2 += f.qr(r, k) * f.qr(r, k);
+        });
+        const T norm = sqrt(norm2);
+        if (!(norm > tolerance)) {
+            deficient = true;
+            return;
+        }
+
+        //NOTE: reflect x onto alpha * e_k with the sign that avoids cancellation in x_k - alpha
+        const T x0 = f.qr(k, k);
+        const T alpha = x0 >= T{0} ? -norm : norm;
+        const T inv_v0 = T{1} / (x0 - alpha);
+        f.tau[k] = (alpha - x0) / alpha;
+        f.qr(k, k) = alpha;
+        detail::unrolled_for(detail::next_index(k), detail::loop_end<R>(), [&](auto r) {
+            f.qr(r, k) *= inv_v0;
+        });
+
+        detail::unrolled_for(detail::next_index(k), detail::loop_end<C>(), [&](auto c) {
+            T w = f.qr(k, c);
+            detail::unrolled_for(detail::next_index(k), detail::loop_end<R>(), [&](auto r) {
+                w += f.qr(r, k) * f.qr(r, c);
+            });
+            w *= f.tau[k];
+            f.qr(k, c) -= w;
+            detail::unrolled_for(detail::next_index(k), detail::loop_end<R>(), [&](auto r) {
+                f.qr(r, c) -= w * f.qr(r, k);
+            });
+        });
+    });
+
+    if (deficient) {
+        return std::nullopt;
+    }
+    return f;
+}
+
+//NOTE: x minimizing |a * x - b|; the exact solution when R == C
+template<std::size_t R, std::size_t C, floating_point T>
+[[nodiscard]] constexpr vec<C, T> solve(const qr_factors<R, C, T>& f, vec<R, T> b) noexcept {
+    //NOTE: b = q^T * b
+    detail::unrolled_for(detail::loop_begin<C>(), detail::loop_end<C>(), [&](auto k) {
+        T w = b[k];
+        detail::unrolled_for(detail::next_index(k), detail::loop_end<R>(), [&](auto r) {
+            w += f.qr(r, k) * b[r];
+        });
+        w *= f.tau[k];
+        b[k] -= w;
+        detail::unrolled_for(detail::next_index(k), detail::loop_end<R>(), [&](auto r) {
+            b[r] -= w * f.qr(r, k);
+        });
+    });
+
+    std::array<T, C> inv_diagonal;
+    detail::unrolled_for(detail::loop_begin<C>(), detail::loop_end<C>(), [&](auto i) {
+        inv_diagonal[i] = T{1} / f.qr(i, i);
+    });
+
+    vec<C, T> x;
+    detail::unrolled_for_reverse(detail::loop_begin<C>(), detail::loop_end<C>(), [&](auto i) {
+        T sum = b[i];
+        detail::unrolled_for(detail::next_index(i), detail::loop_end<C>(), [&](auto j) {
+            sum -= f.qr(i, j) * x[j];
+        });
+        x[i] = sum * inv_diagonal[i];
+    });
+    return x;
+}
+
+//NOTE: one-shot helpers; std::nullopt under the same conditions as lu() and qr()
+template<std::size_t N, floating_point T>
+[[nodiscard]] constexpr std::optional<vec<N, T>> solve(const mat<N, N, T>& a, const vec<N, T>& b) noexcept {
+    const auto f = lu(a);
+    if (!f) {
+        return std::nullopt;
+    }
+    return solve(*f, b);
+}
+
+template<std::size_t R, std::size_t C, floating_point T>
+requires (R >= C)
+[[nodiscard]] inline std::optional<vec<C, T>> least_squares(const mat<R, C, T>& a, const vec<R, T>& b) noexcept {
+    const auto f = qr(a);
+    if (!f) {
+        return std::nullopt;
+    }
+    return solve(*f, b);
+}
+
+} // namespace cc
@@ -14,17 +14,49 @@
 #include "vec/vec4.hpp"
 #include "vec/format.hpp"
 
+#include "simd/fwd.hpp"
+#include "simd/simd.hpp"
+#include "common/fast.hpp"
+#include "vec/vec3_wide.hpp"
+
 #include "mat/fwd.hpp"
 #include "mat/base.hpp"
 #include "mat/mat3.hpp"
 #include "mat/mat4.hpp"
+#include "mat/decompose.hpp"
+#include "mat/solve.hpp"
 #include "mat/format.hpp"
 
 #include "quat/fwd.hpp"
 #include "quat/quat.hpp"
 
 #include "interop/op.hpp"
+#include "interop/fused.hpp"
 #include "interop/transform.hpp"
+#include "interop/transform3.hpp"
+
+#include "geometry/plane.hpp"
+#include "geometry/frustum.hpp"
+#include "geometry/aabb.hpp"
+#include "geometry/sphere.hpp"
+#include "geometry/ray.hpp"
+#include "geometry/triangle.hpp"
+#include "geometry/intersect.hpp"
+#include "geometry/packet.hpp"
+
+#include "packing/packing.hpp"
+
+#include "noise/noise.hpp"
+
+#include "random/random.hpp"
+
+#include "curve/spline.hpp"
+
+#include "filter/kalman.hpp"
+
+#include "vision/estimate.hpp"
+
+#include "batch/batch.hpp"
 // IWYU pragma: end_exports
 
 #include <type_traits>
@@ -69,9 +101,32 @@ using mat2d = mat2<double>;
 using mat3d = mat3_t<double>;
 using mat4d = mat4_t<double>;
 
+using floatx4 = simd<float, 4>;
+using floatx8 = simd<float, 8>;
+
+using vec3x4f = vec<3, floatx4>;
+using vec3x8f = vec<3, floatx8>;
+
+using planef    = plane<float>;
+using frustumf  = frustum<float>;
+using aabb3f    = aabb<float>;
+using spheref   = sphere<float>;
+using rayf      = ray<float>;
+using trianglef = triangle<float>;
+
+using ray_packet4f = ray_packet<float, 4>;
+using ray_packet8f = ray_packet<float, 8>;
+
 using quatf = quat<float>;
 using quatd = quat<double>;
 
+using transform3f = transform3<float>;
+using transform3d = transform3<double>;
+
+using spline2f = spline<2, float>;
+using spline3f = spline<3, float>;
+using spline4f = spline<4, float>;
+
 //NOTE: layout guarantees
 static_assert(std::is_trivially_copyable_v<vec<2, float>>);
 static_assert(std::is_trivially_copyable_v<vec<3, float>>);
@@ -0,0 +1,443 @@
+#pragma once
+
+#include "../detail/lane.hpp"
+
+#include <cstdint>
+
+//NOTE: Lane-generic noise kernels (see detail/lane.hpp), shared by cc/math/noise/noise.hpp (one
+//      float at a time) and the cc::batch kernel TUs (4 or 8 floats per register).
+//
+//      Lattice gradients come from an integer hash of the cell coordinates and the seed (no
+//      permutation table), which vectorizes without gathers.
+namespace cc::noise {
+
+enum class kind : std::uint32_t {
+    perlin,
+    simplex,
+    value
+};
+
+namespace detail {
+
+inline constexpr std::uint32_t prime_x = 501125321u;
+inline constexpr std::uint32_t prime_y = 1136930381u;
+inline constexpr std::uint32_t prime_z = 1720413743u;
+inline constexpr std::uint32_t prime_w = 1066037191u;
+
+//NOTE: per-octave seed step, decorrelates the octaves of fbm
+inline constexpr std::uint32_t octave_seed_step = 0x9e3779b9u;
+
+//NOTE: 1 / peak magnitude of the raw sums, found by hill climbing from random starts, so the
+//      outputs span [-1, 1]
+inline constexpr float perlin2_scale  = 0.66174f;
+inline constexpr float perlin3_scale  = 1.0f;
+inline constexpr float perlin4_scale  = 0.83964f;
+inline constexpr float simplex2_scale = 45.228f;
+inline constexpr float simplex3_scale = 76.864f;
+inline constexpr float simplex4_scale = 62.775f;
+
+//NOTE: dims is 2, 3 or 4; unused coordinates are ignored
+struct fbm_desc {
+    kind          type;
+    std::uint32_t dims;
+    std::uint32_t octaves;
+    std::uint32_t seed;
+    float         frequency;
+    float         lacunarity;
+    float         gain;
+};
+
+using cc::detail::scalar_lane;
+
+template<typename L>
+using f_t = typename L::f;
+
+template<typename L>
+using u_t = typename L::u;
+
+template<typename L>
+[[nodiscard]] inline u_t<L> finish_hash(u_t<L> h) noexcept {
+    h = h * u_t<L>(0x27d4eb2du);
+    return h ^ (h >> 15);
+}
+
+template<typename L>
+[[nodiscard]] inline f_t<L> fade(f_t<L> t) noexcept {
+    return t * t * t * (t * (t * f_t<L>(6.0f) - f_t<L>(15.0f)) + f_t<L>(10.0f));
+}
+
+template<typename L>
+[[nodiscard]] inline f_t<L> lerp(f_t<L> a, f_t<L> b, f_t<L> t) noexcept {
+    return a + t * (b - a);
+}
+
+//NOTE: corner value in [-1, 1) for value noise
+template<typename L>
+[[nodiscard]] inline f_t<L> lattice_value(u_t<L> h) noexcept {
+    return L::to_f(h >> 8) * f_t<L>(2.0f / 16777216.0f) - f_t<L>(1.0f);
+}
+
+//NOTE: gradients (+-1, +-2) and (+-2, +-1) (Gustavson)
+template<typename L>
+[[nodiscard]] inline f_t<L> grad2(u_t<L> h, f_t<L> x, f_t<L> y) noexcept {
+    const auto axis = L::lt(h & u_t<L>(7u), u_t<L>(4u));
+    const f_t<L> a = L::select(axis, x, y);
+    const f_t<L> b = L::select(axis, y, x) * f_t<L>(2.0f);
+    return L::select(L::bit(h, u_t<L>(1u)), -a, a) + L::select(L::bit(h, u_t<L>(2u)), -b, b);
+}
+
+//NOTE: the 12 cube edge midpoints, four of them twice (Perlin, "Improving Noise")
+template<typename L>
+[[nodiscard]] inline f_t<L> grad3(u_t<L> h, f_t<L> x, f_t<L> y, f_t<L> z) noexcept {
+    const u_t<L> g = h & u_t<L>(15u);
+    const f_t<L> a = L::select(L::lt(g, u_t<L>(8u)), x, y);
+    //NOTE: g is 12 or 14 exactly when bits 2 and 3 are set and g is even
+    const auto x_edge = L::mask_and(L::mask_not(L::lt(g, u_t<L>(12u))), L::mask_not(L::bit(g, u_t<L>(1u))));
+    const f_t<L> b = L::select(L::lt(g, u_t<L>(4u)), y, L::select(x_edge, x, z));
+    return L::select(L::bit(h, u_t<L>(1u)), -a, a) + L::select(L::bit(h, u_t<L>(2u)), -b, b);
+}
+
+//NOTE: the 32 edge midpoints of the 4D hypercube (Gustavson)
+template<typename L>
+[[nodiscard]] inline f_t<L> grad4(u_t<L> h, f_t<L> x, f_t<L> y, f_t<L> z, f_t<L> w) noexcept {
+    const u_t<L> g = h & u_t<L>(31u);
+    const f_t<L> a = L::select(L::lt(g, u_t<L>(24u)), x, y);
+    const f_t<L> b = L::select(L::lt(g, u_t<L>(16u)), y, z);
+    const f_t<L> c = L::select(L::lt(g, u_t<L>(8u)), z, w);
+    return L::select(L::bit(h, u_t<L>(1u)), -a, a) + L::select(L::bit(h, u_t<L>(2u)), -b, b)
+         + L::select(L::bit(h, u_t<L>(4u)), -c, c);
+}
+
+//NOTE: Perlin gradient noise, quintic fade between the 2^n cell corners
+template<typename L>
+[[nodiscard]] inline f_t<L> perlin2(f_t<L> x, f_t<L> y, u_t<L> seed) noexcept {
+    using F = f_t<L>;
+    using U = u_t<L>;
+    const F x0 = L::floor(x);
+    const F y0 = L::floor(y);
+    const F fx = x - x0;
+    const F fy = y - y0;
+
+    const U xp = L::to_u(x0) * U(prime_x);
+    const U yp = L::to_u(y0) * U(prime_y);
+    const U xq = xp + U(prime_x);
+    const U yq = yp + U(prime_y);
+    const U s  = seed;
+
+    const F n00 = grad2<L>(finish_hash<L>(s ^ xp ^ yp), fx, fy);
+    const F n10 = grad2<L>(finish_hash<L>(s ^ xq ^ yp), fx - F(1.0f), fy);
+    const F n01 = grad2<L>(finish_hash<L>(s ^ xp ^ yq), fx, fy - F(1.0f));
+    const F n11 = grad2<L>(finish_hash<L>(s ^ xq ^ yq), fx - F(1.0f), fy - F(1.0f));
+
+    const F u = fade<L>(fx);
+    return lerp<L>(lerp<L>(n00, n10, u), lerp<L>(n01, n11, u), fade<L>(fy)) * F(perlin2_scale);
+}
+
+template<typename L>
+[[nodiscard]] inline f_t<L> perlin3(f_t<L> x, f_t<L> y, f_t<L> z, u_t<L> seed) noexcept {
+    using F = f_t<L>;
+    using U = u_t<L>;
+    const F x0 = L::floor(x);
+    const F y0 = L::floor(y);
+    const F z0 = L::floor(z);
+    const F fx = x - x0;
+    const F fy = y - y0;
+    const F fz = z - z0;
+    const F gx = fx - F(1.0f);
+    const F gy = fy - F(1.0f);
+    const F gz = fz - F(1.0f);
+
+    const U xp = L::to_u(x0) * U(prime_x);
+    const U yp = L::to_u(y0) * U(prime_y);
+    const U zp = L::to_u(z0) * U(prime_z);
+    const U xq = xp + U(prime_x);
+    const U yq = yp + U(prime_y);
+    const U zq = zp + U(prime_z);
+    const U sp = seed ^ zp;
+    const U sq = seed ^ zq;
+
+    const F u = fade<L>(fx);
+    const F v = fade<L>(fy);
+    const F n0 = lerp<L>(lerp<L>(grad3<L>(finish_hash<L>(sp ^ xp ^ yp), fx, fy, fz),
+                                 grad3<L>(finish_hash<L>(sp ^ xq ^ yp), gx, fy, fz), u),
+                         lerp<L>(grad3<L>(finish_hash<L>(sp ^ xp ^ yq), fx, gy, fz),
+                                 grad3<L>(finish_hash<L>(sp ^ xq ^ yq), gx, gy, fz), u), v);
+    const F n1 = lerp<L>(lerp<L>(grad3<L>(finish_hash<L>(sq ^ xp ^ yp), fx, fy, gz),
+                                 grad3<L>(finish_hash<L>(sq ^ xq ^ yp), gx, fy, gz), u),
+                         lerp<L>(grad3<L>(finish_hash<L>(sq ^ xp ^ yq), fx, gy, gz),
+                                 grad3<L>(finish_hash<L>(sq ^ xq ^ yq), gx, gy, gz), u), v);
+    return lerp<L>(n0, n1, fade<L>(fz)) * F(perlin3_scale);
+}
+
+template<typename L>
+[[nodiscard]] inline f_t<L> perlin4(f_t<L> x, f_t<L> y, f_t<L> z, f_t<L> w, u_t<L> seed) noexcept {
+    using F = f_t<L>;
+    using U = u_t<L>;
+    const F x0 = L::floor(x);
+    const F y0 = L::floor(y);
+    const F z0 = L::floor(z);
+    const F w0 = L::floor(w);
+    const F f[2][4] = {
+        {x - x0, y - y0, z - z0, w - w0},
+        {x - x0 - F(1.0f), y - y0 - F(1.0f), z - z0 - F(1.0f), w - w0 - F(1.0f)},
+    };
+
+    const U xp[2] = {L::to_u(x0) * U(prime_x), L::to_u(x0) * U(prime_x) + U(prime_x)};
+    const U yp[2] = {L::to_u(y0) * U(prime_y), L::to_u(y0) * U(prime_y) + U(prime_y)};
+    const U zp[2] = {L::to_u(z0) * U(prime_z), L::to_u(z0) * U(prime_z) + U(prime_z)};
+    const U wp[2] = {L::to_u(w0) * U(prime_w), L::to_u(w0) * U(prime_w) + U(prime_w)};
+
+    const F u = fade<L>(f[0][0]);
+    const F v = fade<L>(f[0][1]);
+    const F t = fade<L>(f[0][2]);
+
+    //NOTE: corner (i, j, k, l) sits at offset (f[i][0], f[j][1], f[k][2], f[l][3])
+    F n[2];
+    for (int l = 0; l < 2; ++l) {
+        F nz[2];
+        for (int k = 0; k < 2; ++k) {
+            F ny[2];
+            for (int j = 0; j < 2; ++j) {
+                const U s = seed ^ wp[l] ^ zp[k] ^ yp[j];
+                const F a = grad4<L>(finish_hash<L>(s ^ xp[0]), f[0][0], f[j][1], f[k][2], f[l][3]);
+                const F b = grad4<L>(finish_hash<L>(s ^ xp[1]), f[1][0], f[j][1], f[k][2], f[l][3]);
+                ny[j] = lerp<L>(a, b, u);
+            }
+            nz[k] = lerp<L>(ny[0], ny[1], v);
+        }
+        n[l] = lerp<L>(nz[0], nz[1], t);
+    }
+    return lerp<L>(n[0], n[1], fade<L>(f[0][3])) * F(perlin4_scale);
+}
+
+//NOTE: falloff (r^2 - d^2)^4 of a simplex corner; r^2 = 0.5 keeps the sum continuous across
+//      simplices
+template<typename L>
+[[nodiscard]] inline f_t<L> falloff(f_t<L> d2) noexcept {
+    const f_t<L> t = L::max(f_t<L>(0.5f) - d2, f_t<L>(0.0f));
+    const f_t<L> t2 = t * t;
+    return t2 * t2;
+}
+
+//NOTE: Simplex noise (Perlin 2001), following Gustavson, "Simplex noise demystified"; the corner
+//      ordering is computed with comparisons and selects instead of branches
+template<typename L>
+[[nodiscard]] inline f_t<L> simplex2(f_t<L> x, f_t<L> y, u_t<L> seed) noexcept {
+    using F = f_t<L>;
+    using U = u_t<L>;
+    constexpr float skew   = 0.36602540378443865f;   // (sqrt(3) - 1) / 2
+    constexpr float unskew = 0.21132486540518713f;   // (3 - sqrt(3)) / 6
+
+    const F s  = (x + y) * F(skew);
+    const F i  = L::floor(x + s);
+    const F j  = L::floor(y + s);
+    const F t  = (i + j) * F(unskew);
+    const F x0 = x - (i - t);
+    const F y0 = y - (j - t);
+
+    //NOTE: lower or upper triangle of the skewed cell
+    const auto lower = L::gt(x0, y0);
+    const F i1 = L::select(lower, F(1.0f), F(0.0f));
+    const F j1 = F(1.0f) - i1;
+
+    const F x1 = x0 - i1 + F(unskew);
+    const F y1 = y0 - j1 + F(unskew);
+    const F x2 = x0 - F(1.0f - 2.0f * unskew);
+    const F y2 = y0 - F(1.0f - 2.0f * unskew);
+
+    const U xp = L::to_u(i) * U(prime_x);
+    const U yp = L::to_u(j) * U(prime_y);
+    const U xq = xp + U(prime_x);
+    const U yq = yp + U(prime_y);
+
+    const F n0 = falloff<L>(x0 * x0 + y0 * y0) * grad2<L>(finish_hash<L>(seed ^ xp ^ yp), x0, y0);
+    const F n1 = falloff<L>(x1 * x1 + y1 * y1)
+               * grad2<L>(finish_hash<L>(seed ^ L::select(lower, xq, xp) ^ L::select(lower, yp, yq)), x1, y1);
+    const F n2 = falloff<L>(x2 * x2 + y2 * y2) * grad2<L>(finish_hash<L>(seed ^ xq ^ yq), x2, y2);
+    return (n0 + n1 + n2) * F(simplex2_scale);
+}
+
+template<typename L>
+[[nodiscard]] inline f_t<L> simplex3(f_t<L> x, f_t<L> y, f_t<L> z, u_t<L> seed) noexcept {
+    using F = f_t<L>;
+    using U = u_t<L>;
+    constexpr float skew   = 1.0f / 3.0f;
+    constexpr float unskew = 1.0f / 6.0f;
+
+    const F s  = (x + y + z) * F(skew);
+    const F i  = L::floor(x + s);
+    const F j  = L::floor(y + s);
+    const F k  = L::floor(z + s);
+    const F t  = (i + j + k) * F(unskew);
+    const F x0 = x - (i - t);
+    const F y0 = y - (j - t);
+    const F z0 = z - (k - t);
+
+    //NOTE: the second corner steps along the largest offset, the third along the two largest
+    const auto xy = L::ge(x0, y0);
+    const auto yz = L::ge(y0, z0);
+    const auto xz = L::ge(x0, z0);
+    const auto i1 = L::mask_and(xy, xz);
+    const auto j1 = L::mask_and(L::mask_not(xy), yz);
+    const auto k1 = L::mask_not(L::mask_or(xz, yz));
+    const auto i2 = L::mask_or(xy, xz);
+    const auto j2 = L::mask_or(L::mask_not(xy), yz);
+    const auto k2 = L::mask_not(L::mask_and(xz, yz));
+
+    const F one(1.0f);
+    const F zero(0.0f);
+    const F x1 = x0 - L::select(i1, one, zero) + F(unskew);
+    const F y1 = y0 - L::select(j1, one, zero) + F(unskew);
+    const F z1 = z0 - L::select(k1, one, zero) + F(unskew);
+    const F x2 = x0 - L::select(i2, one, zero) + F(2.0f * unskew);
+    const F y2 = y0 - L::select(j2, one, zero) + F(2.0f * unskew);
+    const F z2 = z0 - L::select(k2, one, zero) + F(2.0f * unskew);
+    const F x3 = x0 - F(1.0f - 3.0f * unskew);
+    const F y3 = y0 - F(1.0f - 3.0f * unskew);
+    const F z3 = z0 - F(1.0f - 3.0f * unskew);
+
+    const U xp = L::to_u(i) * U(prime_x);
+    const U yp = L::to_u(j) * U(prime_y);
+    const U zp = L::to_u(k) * U(prime_z);
+    const U xq = xp + U(prime_x);
+    const U yq = yp + U(prime_y);
+    const U zq = zp + U(prime_z);
+
+    const U h0 = finish_hash<L>(seed ^ xp ^ yp ^ zp);
+    const U h1 = finish_hash<L>(seed ^ L::select(i1, xq, xp) ^ L::select(j1, yq, yp) ^ L::select(k1, zq, zp));
+    const U h2 = finish_hash<L>(seed ^ L::select(i2, xq, xp) ^ L::select(j2, yq, yp) ^ L::select(k2, zq, zp));
+    const U h3 = finish_hash<L>(seed ^ xq ^ yq ^ zq);
+
+    const F n0 = falloff<L>(x0 * x0 + y0 * y0 + z0 * z0) * grad3<L>(h0, x0, y0, z0);
+    const F n1 = falloff<L>(x1 * x1 + y1 * y1 + z1 * z1) * grad3<L>(h1, x1, y1, z1);
+    const F n2 = falloff<L>(x2 * x2 + y2 * y2 + z2 * z2) * grad3<L>(h2, x2, y2, z2);
+    const F n3 = falloff<L>(x3 * x3 + y3 * y3 + z3 * z3) * grad3<L>(h3, x3, y3, z3);
+    return (n0 + n1 + n2 + n3) * F(simplex3_scale);
+}
+
+template<typename L>
+[[nodiscard]] inline f_t<L> simplex4(f_t<L> x, f_t<L> y, f_t<L> z, f_t<L> w, u_t<L> seed) noexcept {
+    using F = f_t<L>;
+    using U = u_t<L>;
+    constexpr float skew   = 0.30901699437494745f;   // (sqrt(5) - 1) / 4
+    constexpr float unskew = 0.1381966011250105f;    // (5 - sqrt(5)) / 20
+
+    const F s  = (x + y + z + w) * F(skew);
+    const F i  = L::floor(x + s);
+    const F j  = L::floor(y + s);
+    const F k  = L::floor(z + s);
+    const F l  = L::floor(w + s);
+    const F t  = (i + j + k + l) * F(unskew);
+    const F d0[4] = {x - (i - t), y - (j - t), z - (k - t), w - (l - t)};
+
+    //NOTE: rank of each offset among the four (3 = largest); corner c steps along the axes with
+    //      rank >= 4 - c
+    const F one(1.0f);
+    const F zero(0.0f);
+    F rank[4] = {zero, zero, zero, zero};
+    for (int a = 0; a < 4; ++a) {
+        for (int b = a + 1; b < 4; ++b) {
+            const F a_wins = L::select(L::gt(d0[a], d0[b]), one, zero);
+            rank[a] = rank[a] + a_wins;
+            rank[b] = rank[b] + (one - a_wins);
+        }
+    }
+
+    const U base[4] = {L::to_u(i) * U(prime_x), L::to_u(j) * U(prime_y), L::to_u(k) * U(prime_z),
+                       L::to_u(l) * U(prime_w)};
+    const U step[4] = {U(prime_x), U(prime_y), U(prime_z), U(prime_w)};
+
+    F sum = falloff<L>(d0[0] * d0[0] + d0[1] * d0[1] + d0[2] * d0[2] + d0[3] * d0[3])
+          * grad4<L>(finish_hash<L>(seed ^ base[0] ^ base[1] ^ base[2] ^ base[3]), d0[0], d0[1], d0[2], d0[3]);
+    for (int c = 1; c <= 4; ++c) {
+        F d[4];
+        U h = seed;
+        for (int a = 0; a < 4; ++a) {
+            const auto stepped = L::gt(rank[a], F(3.5f - static_cast<float>(c)));
+            d[a] = d0[a] - L::select(stepped, one, zero) + F(static_cast<float>(c) * unskew);
+            h = h ^ L::select(stepped, base[a] + step[a], base[a]);
+        }
+        sum = sum + falloff<L>(d[0] * d[0] + d[1] * d[1] + d[2] * d[2] + d[3] * d[3])
+                  * grad4<L>(finish_hash<L>(h), d[0], d[1], d[2], d[3]);
+    }
+    return sum * F(simplex4_scale);
+}
+
+//NOTE: Value noise, hashed corner values blended like Perlin; already within [-1, 1]
+template<typename L>
+[[nodiscard]] inline f_t<L> value2(f_t<L> x, f_t<L> y, u_t<L> seed) noexcept {
+    using F = f_t<L>;
+    using U = u_t<L>;
+    const F x0 = L::floor(x);
+    const F y0 = L::floor(y);
+    const U xp = L::to_u(x0) * U(prime_x);
+    const U yp = L::to_u(y0) * U(prime_y);
+    const U xq = xp + U(prime_x);
+    const U yq = yp + U(prime_y);
+
+    const F u = fade<L>(x - x0);
+    return lerp<L>(lerp<L>(lattice_value<L>(finish_hash<L>(seed ^ xp ^ yp)),
+                           lattice_value<L>(finish_hash<L>(seed ^ xq ^ yp)), u),
+                   lerp<L>(lattice_value<L>(finish_hash<L>(seed ^ xp ^ yq)),
+                           lattice_value<L>(finish_hash<L>(seed ^ xq ^ yq)), u),
+                   fade<L>(y - y0));
+}
+
+template<typename L>
+[[nodiscard]] inline f_t<L> value3(f_t<L> x, f_t<L> y, f_t<L> z, u_t<L> seed) noexcept {
+    using F = f_t<L>;
+    using U = u_t<L>;
+    const F z0 = L::floor(z);
+    const U zp = L::to_u(z0) * U(prime_z);
+    //NOTE: two value2 slices with the z term folded into the seed, blended along z
+    const F a = value2<L>(x, y, seed ^ zp);
+    const F b = value2<L>(x, y, seed ^ (zp + U(prime_z)));
+    return lerp<L>(a, b, fade<L>(z - z0));
+}
+
+template<typename L>
+[[nodiscard]] inline f_t<L> value4(f_t<L> x, f_t<L> y, f_t<L> z, f_t<L> w, u_t<L> seed) noexcept {
+    using F = f_t<L>;
+    using U = u_t<L>;
+    const F w0 = L::floor(w);
+    const U wp = L::to_u(w0) * U(prime_w);
+    const F a = value3<L>(x, y, z, seed ^ wp);
+    const F b = value3<L>(x, y, z, seed ^ (wp + U(prime_w)));
+    return lerp<L>(a, b, fade<L>(w - w0));
+}
+
+template<typename L>
+[[nodiscard]] inline f_t<L> sample(kind type, std::uint32_t dims, f_t<L> x, f_t<L> y, f_t<L> z, f_t<L> w,
+                                   u_t<L> seed) noexcept {
+    switch (type) {
+        case kind::perlin:
+            return dims == 2 ? perlin2<L>(x, y, seed) : dims == 3 ? perlin3<L>(x, y, z, seed) : perlin4<L>(x, y, z, w, seed);
+        case kind::simplex:
+            return dims == 2 ? simplex2<L>(x, y, seed) : dims == 3 ? simplex3<L>(x, y, z, seed) : simplex4<L>(x, y, z, w, seed);
+        case kind::value:
+            return dims == 2 ? value2<L>(x, y, seed) : dims == 3 ? value3<L>(x, y, z, seed) : value4<L>(x, y, z, w, seed);
+    }
+    return f_t<L>(0.0f);
+}
+
+//NOTE: fractal Brownian motion, normalized by the sum of the octave amplitudes
+template<typename L>
+[[nodiscard]] inline f_t<L> fbm(const fbm_desc& d, f_t<L> x, f_t<L> y, f_t<L> z, f_t<L> w) noexcept {
+    using F = f_t<L>;
+    F sum(0.0f);
+    float amplitude = 1.0f;
+    float total     = 0.0f;
+    float frequency = d.frequency;
+    for (std::uint32_t o = 0; o < d.octaves; ++o) {
+        const F f(frequency);
+        const u_t<L> seed(d.seed + o * octave_seed_step);
+        sum = sum + sample<L>(d.type, d.dims, x * f, y * f, z * f, w * f, seed) * F(amplitude);
+        total += amplitude;
+        amplitude *= d.gain;
+        frequency *= d.lacunarity;
+    }
+    return total > 0.0f ? sum * F(1.0f / total) : sum;
+}
+
+} // namespace detail
+} // namespace cc::noise
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "./lattice.hpp"
+#include "../vec/base.hpp"
+#include "../vec/vec2.hpp"          // IWYU pragma: keep
+#include "../vec/vec3.hpp"          // IWYU pragma: keep
+#include "../vec/vec4.hpp"          // IWYU pragma: keep
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+//NOTE: Coherent noise for CPU-side procedural data (height fields, textures, water). Perlin,
+//      simplex and value noise in 2D, 3D and 4D, each in [-1, 1] and continuous; the seed selects
+//      an independent pattern. The functions below evaluate one point; fill_grid evaluates whole
+//      grids on the batch kernels (AVX2, SSE or scalar, chosen at runtime) and matches them
+//      within 1e-4 (FMA contraction on AVX2).
+namespace cc::noise {
+
+[[nodiscard]] inline float perlin(const vec<2, float>& p, std::uint32_t seed = 0) noexcept {
+    return detail::perlin2<detail::scalar_lane>(p.x, p.y, seed);
+}
+
+[[nodiscard]] inline float perlin(const vec<3, float>& p, std::uint32_t seed = 0) noexcept {
+    return detail::perlin3<detail::scalar_lane>(p.x, p.y, p.z, seed);
+}
+
+[[nodiscard]] inline float perlin(const vec<4, float>& p, std::uint32_t seed = 0) noexcept {
+    return detail::perlin4<detail::scalar_lane>(p.x, p.y, p.z, p.w, seed);
+}
+
+//NOTE: fewer corners than Perlin in 3D and 4D (n + 1 instead of 2^n) and no axis-aligned artifacts
+[[nodiscard]] inline float simplex(const vec<2, float>& p, std::uint32_t seed = 0) noexcept {
+    return detail::simplex2<detail::scalar_lane>(p.x, p.y, seed);
+}
+
+[[nodiscard]] inline float simplex(const vec<3, float>& p, std::uint32_t seed = 0) noexcept {
+    return detail::simplex3<detail::scalar_lane>(p.x, p.y, p.z, seed);
+}
+
+[[nodiscard]] inline float simplex(const vec<4, float>& p, std::uint32_t seed = 0) noexcept {
+    return detail::simplex4<detail::scalar_lane>(p.x, p.y, p.z, p.w, seed);
+}
+
+[[nodiscard]] inline float value(const vec<2, float>& p, std::uint32_t seed = 0) noexcept {
+    return detail::value2<detail::scalar_lane>(p.x, p.y, seed);
+}
+
+[[nodiscard]] inline float value(const vec<3, float>& p, std::uint32_t seed = 0) noexcept {
+    return detail::value3<detail::scalar_lane>(p.x, p.y, p.z, seed);
+}
+
+[[nodiscard]] inline float value(const vec<4, float>& p, std::uint32_t seed = 0) noexcept {
+    return detail::value4<detail::scalar_lane>(p.x, p.y, p.z, p.w, seed);
+}
+
+//NOTE: octave i samples at frequency * lacunarity^i with amplitude gain^i; the sum is divided by
+//      the total amplitude so it stays in [-1, 1]
+struct fbm_params {
+    std::uint32_t octaves{5};
+    float         frequency{1.0f};
+    float         lacunarity{2.0f};
+    float         gain{0.5f};
+    std::uint32_t seed{0};
+};
+
+namespace detail {
+
+[[nodiscard]] inline fbm_desc make_desc(kind type, std::uint32_t dims, const fbm_params& params) noexcept {
+    return {type, dims, params.octaves, params.seed, params.frequency, params.lacunarity, params.gain};
+}
+
+} // namespace detail
+
+[[nodiscard]] inline float fbm(kind type, const vec<2, float>& p, const fbm_params& params = {}) noexcept {
+    return detail::fbm<detail::scalar_lane>(detail::make_desc(type, 2, params), p.x, p.y, 0.0f, 0.0f);
+}
+
+[[nodiscard]] inline float fbm(kind type, const vec<3, float>& p, const fbm_params& params = {}) noexcept {
+    return detail::fbm<detail::scalar_lane>(detail::make_desc(type, 3, params), p.x, p.y, p.z, 0.0f);
+}
+
+[[nodiscard]] inline float fbm(kind type, const vec<4, float>& p, const fbm_params& params = {}) noexcept {
+    return detail::fbm<detail::scalar_lane>(detail::make_desc(type, 4, params), p.x, p.y, p.z, p.w);
+}
+
+struct grid_params {
+    kind          type{kind::simplex};
+    fbm_params    fbm{};
+    //NOTE: noise-space position of texel (0, 0) and the distance between neighbouring texels
+    vec<2, float> origin{0.0f, 0.0f};
+    vec<2, float> step{1.0f, 1.0f};
+    //NOTE: set to sample 3D noise in the plane z = *slice instead of 2D noise (e.g. z = time)
+    std::optional<float> slice;
+    //NOTE: rows are split across this many threads; 0 uses std::thread::hardware_concurrency()
+    std::uint32_t threads{0};
+};
+
+//NOTE: out[y * width + x] = fbm(type, origin + (x, y) * step[, slice]); out.size() must be
+//      width * height
+void fill_grid(std::span<float> out, std::size_t width, std::size_t height, const grid_params& params);
+
+} // namespace cc::noise
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "../common/functions.hpp"
+#include "../vec/base.hpp"
+#include "../vec/vec2.hpp"          // IWYU pragma: keep
+#include "../vec/vec3.hpp"          // IWYU pragma: keep
+#include "../vec/vec4.hpp"          // IWYU pragma: keep
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+//NOTE: Compact vertex attribute encodings. Floats are clamped to the normalized range (NaN maps to
+//      the low end) and rounded to nearest-even, so the batch converters in cc::batch produce the
+//      same bits on every ISA. Packed words store x in the lowest bits.
+namespace cc {
+
+//NOTE: IEEE 754 binary16 storage type; arithmetic is done in float
+struct half {
+    std::uint16_t bits{0};
+
+    constexpr half() noexcept = default;
+
+    explicit constexpr half(float value) noexcept
+        : bits(from_float(value)) {}
+
+    [[nodiscard]] static constexpr half from_bits(std::uint16_t bits_) noexcept {
+        half h;
+        h.bits = bits_;
+        return h;
+    }
+
+    //NOTE: round to nearest-even; values past 65504 become infinity, NaNs stay (quiet) NaNs
+    [[nodiscard]] static constexpr std::uint16_t from_float(float value) noexcept {
+        constexpr std::uint32_t f16max      = (127 + 16) << 23;
+        constexpr std::uint32_t min_normal  = (127 - 14) << 23;
+        constexpr std::uint32_t denorm_bits = ((127 - 15) + (23 - 10) + 1) << 23;
+
+        std::uint32_t f = std::bit_cast<std::uint32_t>(value);
+        const std::uint32_t sign = (f >> 16) & 0x8000u;
+        f &= 0x7fffffffu;
+
+        std::uint32_t out;
+        if (f >= f16max) {
+            out = f > 0x7f800000u ? 0x7e00u : 0x7c00u;
+        } else if (f < min_normal) {
+            //NOTE: adding the magic value lets the FPU round the subnormal mantissa into place
+            const float denorm = std::bit_cast<float>(f) + std::bit_cast<float>(denorm_bits);
+            out = std::bit_cast<std::uint32_t>(denorm) - denorm_bits;
+        } else {
+            const std::uint32_t odd = (f >> 13) & 1u;
+            out = (f + 0xfffu - ((127u - 15u) << 23) + odd) >> 13;
+        }
+        return static_cast<std::uint16_t>(out | sign);
+    }
+
+    [[nodiscard]] static constexpr float to_float(std::uint16_t bits_) noexcept {
+        constexpr std::uint32_t shifted_exp = 0x7c00u << 13;
+
+        std::uint32_t o = (bits_ & 0x7fffu) << 13;
+        const std::uint32_t exp = o & shifted_exp;
+        o += (127u - 15u) << 23;
+
+        if (exp == shifted_exp) {
+            o += (128u - 16u) << 23;
+        } else if (exp == 0) {
+            o += 1u << 23;
+            o = std::bit_cast<std::uint32_t>(std::bit_cast<float>(o) - std::bit_cast<float>(113u << 23));
+        }
+        return std::bit_cast<float>(o | (static_cast<std::uint32_t>(bits_ & 0x8000u) << 16));
+    }
+
+    [[nodiscard]] explicit constexpr operator float() const noexcept {
+        return to_float(bits);
+    }
+
+    [[nodiscard]] constexpr bool operator==(const half&) const noexcept = default;
+};
+
+static_assert(sizeof(half) == 2);
+
+namespace detail {
+
+[[nodiscard]] inline std::int32_t quantize(float value, float lo, float scale) noexcept {
+    return static_cast<std::int32_t>(std::nearbyint(clamp(value, lo, 1.0f) * scale));
+}
+
+} // namespace detail
+
+//NOTE: [-1, 1] <-> [-32767, 32767]; -32768 also decodes to -1
+[[nodiscard]] inline std::int16_t pack_snorm16(float value) noexcept {
+    return static_cast<std::int16_t>(detail::quantize(value, -1.0f, 32767.0f));
+}
+
+[[nodiscard]] inline float unpack_snorm16(std::int16_t value) noexcept {
+    return max(static_cast<float>(value) / 32767.0f, -1.0f);
+}
+
+[[nodiscard]] inline std::uint32_t pack_unorm8x4(const vec<4, float>& v) noexcept {
+    return static_cast<std::uint32_t>(detail::quantize(v.x, 0.0f, 255.0f))
+         | static_cast<std::uint32_t>(detail::quantize(v.y, 0.0f, 255.0f)) << 8
+         | static_cast<std::uint32_t>(detail::quantize(v.z, 0.0f, 255.0f)) << 16
+         | static_cast<std::uint32_t>(detail::quantize(v.w, 0.0f, 255.0f)) << 24;
+}
+
+[[nodiscard]] inline vec<4, float> unpack_unorm8x4(std::uint32_t packed) noexcept {
+    return vec<4, float>(static_cast<float>(packed & 0xffu),
+                         static_cast<float>((packed >> 8) & 0xffu),
+                         static_cast<float>((packed >> 16) & 0xffu),
+                         static_cast<float>(packed >> 24)) / 255.0f;
+}
+
+//NOTE: x, y, z as signed 10-bit and w as signed 2-bit fields (GL_INT_2_10_10_10_REV,
+//      A2B10G10R10_SNORM_PACK32); w can only hold -1, 0 and 1
+[[nodiscard]] inline std::uint32_t pack_snorm10_10_10_2(const vec<4, float>& v) noexcept {
+    return (static_cast<std::uint32_t>(detail::quantize(v.x, -1.0f, 511.0f)) & 0x3ffu)
+         | (static_cast<std::uint32_t>(detail::quantize(v.y, -1.0f, 511.0f)) & 0x3ffu) << 10
+         | (static_cast<std::uint32_t>(detail::quantize(v.z, -1.0f, 511.0f)) & 0x3ffu) << 20
+         | (static_cast<std::uint32_t>(detail::quantize(v.w, -1.0f, 1.0f)) & 0x3u) << 30;
+}
+
+[[nodiscard]] inline vec<4, float> unpack_snorm10_10_10_2(std::uint32_t packed) noexcept {
+    //NOTE: shift each field to the top of an int32 and back to sign-extend it
+    const auto field = [packed](int shift, int bits) {
+        return static_cast<std::int32_t>(packed << (32 - shift - bits)) >> (32 - bits);
+    };
+    return vec<4, float>(max(static_cast<float>(field(0, 10)) / 511.0f, -1.0f),
+                         max(static_cast<float>(field(10, 10)) / 511.0f, -1.0f),
+                         max(static_cast<float>(field(20, 10)) / 511.0f, -1.0f),
+                         max(static_cast<float>(field(30, 2)), -1.0f));
+}
+
+[[nodiscard]] inline std::uint32_t pack_unorm10_10_10_2(const vec<4, float>& v) noexcept {
+    return static_cast<std::uint32_t>(detail::quantize(v.x, 0.0f, 1023.0f))
+         | static_cast<std::uint32_t>(detail::quantize(v.y, 0.0f, 1023.0f)) << 10
+         | static_cast<std::uint32_t>(detail::quantize(v.z, 0.0f, 1023.0f)) << 20
+         | static_cast<std::uint32_t>(detail::quantize(v.w, 0.0f, 3.0f)) << 30;
+}
+
+[[nodiscard]] inline vec<4, float> unpack_unorm10_10_10_2(std::uint32_t packed) noexcept {
+    return vec<4, float>(static_cast<float>(packed & 0x3ffu) / 1023.0f,
+                         static_cast<float>((packed >> 10) & 0x3ffu) / 1023.0f,
+                         static_cast<float>((packed >> 20) & 0x3ffu) / 1023.0f,
+                         static_cast<float>(packed >> 30) / 3.0f);
+}
+
+//NOTE: Octahedral unit vector encoding (Cigolle et al., "A Survey of Efficient Representations
+//      for Independent Unit Vectors"): the octahedron |x| + |y| + |z| = 1 is unfolded onto
+//      [-1, 1]^2. The input need not be normalized; a zero vector encodes as +z.
+[[nodiscard]] inline vec<2, float> oct_encode(const vec<3, float>& n) noexcept {
+    const float l1 = abs(n.x) + abs(n.y) + abs(n.z);
+    float x = l1 > 0.0f ? n.x / l1 : 0.0f;
+    float y = l1 > 0.0f ? n.y / l1 : 0.0f;
+    if (n.z < 0.0f) {
+        const float fx = (1.0f - abs(y)) * std::copysign(1.0f, x);
+        const float fy = (1.0f - abs(x)) * std::copysign(1.0f, y);
+        x = fx;
+        y = fy;
+    }
+    return {x, y};
+}
+
+[[nodiscard]] inline vec<3, float> oct_decode(const vec<2, float>& e) noexcept {
+    vec<3, float> n(e.x, e.y, 1.0f - abs(e.x) - abs(e.y));
+    const float fold = max(-n.z, 0.0f);
+    n.x += n.x >= 0.0f ? -fold : fold;
+    n.y += n.y >= 0.0f ? -fold : fold;
+    return n.normalized();
+}
+
+//NOTE: octahedral encoding stored as two snorm16 values (x in the low half); decodes within
+//      0.004 degrees of the input direction
+[[nodiscard]] inline std::uint32_t pack_oct_snorm16(const vec<3, float>& n) noexcept {
+    const vec<2, float> e = oct_encode(n);
+    return static_cast<std::uint16_t>(pack_snorm16(e.x))
+         | static_cast<std::uint32_t>(static_cast<std::uint16_t>(pack_snorm16(e.y))) << 16;
+}
+
+[[nodiscard]] inline vec<3, float> unpack_oct_snorm16(std::uint32_t packed) noexcept {
+    return oct_decode({unpack_snorm16(static_cast<std::int16_t>(packed & 0xffffu)),
+                       unpack_snorm16(static_cast<std::int16_t>(packed >> 16))});
+}
+
+} // namespace cc
@@ -42,6 +42,31 @@ struct quat {
         return quat(n[0] * s, n[1] * s, n[2] * s, c);
     }
 
+    //NOTE: m must be a rotation (Shepperd's method: the branch with the largest diagonal term
+    //      keeps the square root well away from zero); the result has w >= 0 when m's trace
+    //      is positive
+    [[nodiscard]] static quat from_mat3(const mat<3, 3, T>& m) noexcept {
+        const T trace = m(0, 0) + m(1, 1) + m(2, 2);
+        if (trace > T{0}) {
+            const T s = sqrt(trace + T{1}) * T{2};
+            const T inv = T{1} / s;
+            return quat((m(2, 1) - m(1, 2)) * inv, (m(0, 2) - m(2, 0)) * inv, (m(1, 0) - m(0, 1)) * inv, s / T{4});
+        }
+        if (m(0, 0) > m(1, 1) && m(0, 0) > m(2, 2)) {
+            const T s = sqrt(T{1} + m(0, 0) - m(1, 1) - m(2, 2)) * T{2};
+            const T inv = T{1} / s;
+            return quat(s / T{4}, (m(0, 1) + m(1, 0)) * inv, (m(0, 2) + m(2, 0)) * inv, (m(2, 1) - m(1, 2)) * inv);
+        }
+        if (m(1, 1) > m(2, 2)) {
+            const T s = sqrt(T{1} + m(1, 1) - m(0, 0) - m(2, 2)) * T{2};
+            const T inv = T{1} / s;
+            return quat((m(0, 1) + m(1, 0)) * inv, s / T{4}, (m(1, 2) + m(2, 1)) * inv, (m(0, 2) - m(2, 0)) * inv);
+        }
+        const T s = sqrt(T{1} + m(2, 2) - m(0, 0) - m(1, 1)) * T{2};
+        const T inv = T{1} / s;
+        return quat((m(0, 2) + m(2, 0)) * inv, (m(1, 2) + m(2, 1)) * inv, s / T{4}, (m(1, 0) - m(0, 1)) * inv);
+    }
+
     [[nodiscard]] T length() const noexcept {
         return sqrt(x * x + y * y + z * z + w * w);
     }
@@ -209,6 +234,44 @@ template<arithmetic T>
     return !(a == b);
 }
 
+//NOTE: Interpolation between unit quaternions along the shorter arc; b is negated when
+//      dot(a, b) < 0 so the result never takes the long way round.
+
+template<floating_point T>
+[[nodiscard]] quat<T> nlerp(const quat<T>& a, const quat<T>& b, T t) noexcept {
+    const T tb = quat<T>::dot(a, b) < T{0} ? -t : t;
+    return (a * (T{1} - t) + b * tb).normalized();
+}
+
+//NOTE: constant angular velocity; falls back to nlerp when the quaternions are nearly equal and
+//      sin(theta) would lose precision
+template<floating_point T>
+[[nodiscard]] quat<T> slerp(const quat<T>& a, const quat<T>& b, T t) noexcept {
+    T d = quat<T>::dot(a, b);
+    const T sign = d < T{0} ? T{-1} : T{1};
+    d *= sign;
+
+    if (d > T{0.9995}) {
+        return (a * (T{1} - t) + b * (sign * t)).normalized();
+    }
+
+    const T theta   = acos(d);
+    const T inv_sin = T{1} / sin(theta);
+    return a * (sin((T{1} - t) * theta) * inv_sin) + b * (sign * sin(t * theta) * inv_sin);
+}
+
+//NOTE: nlerp with t remapped by a fitted cubic so the angle follows slerp (Zeux, "Approximating
+//      slerp"). Costs about as much as nlerp; the rotation differs from the exact slerp by less
+//      than 8e-4 rad, and less than 1e-4 rad for rotations under 120 degrees apart.
+template<floating_point T>
+[[nodiscard]] quat<T> fast_slerp(const quat<T>& a, const quat<T>& b, T t) noexcept {
+    const T d  = abs(quat<T>::dot(a, b));
+    const T ka = T{1.0904} + d * (T{-3.2452} + d * (T{3.55645} - d * T{1.43519}));
+    const T kb = T{0.848013} + d * (T{-1.06021} + d * T{0.215638});
+    const T k  = ka * (t - T{0.5}) * (t - T{0.5}) + kb;
+    return nlerp(a, b, t + t * (t - T{0.5}) * (t - T{1}) * k);
+}
+
 static_assert(std::is_trivially_copyable_v<quat<float>>);
 static_assert(std::is_trivially_copyable_v<quat<double>>);
 
@@ -0,0 +1,246 @@
+#pragma once
+
+#include "./sampling.hpp"
+#include "../vec/base.hpp"
+#include "../vec/vec3.hpp"          // IWYU pragma: keep
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+
+//NOTE: Fast, reproducible pseudo-random numbers for simulation and procedural content; not for
+//      anything security related. xoshiro256++ and pcg32 are UniformRandomBitGenerators, so they
+//      also drive the <random> distributions. For parallel work give every thread its own stream:
+//      xoshiro256pp::fork() hands out generators 2^192 calls apart, pcg32 takes a stream selector.
+//      The fill_* functions generate whole spans on the batch kernels (AVX2, SSE or scalar, chosen
+//      at runtime) from xoshiro256pp_x8, eight streams advanced together.
+namespace cc::random {
+
+//NOTE: SplitMix64 (Steele, Lea, Flood), used to expand a single seed into generator state
+[[nodiscard]] constexpr std::uint64_t splitmix64(std::uint64_t& state) noexcept {
+    std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+//NOTE: xoshiro256++ (Blackman, Vigna): period 2^256 - 1, 64-bit output
+class xoshiro256pp {
+public:
+    using result_type = std::uint64_t;
+
+    constexpr explicit xoshiro256pp(std::uint64_t seed = 0) noexcept {
+        for (std::uint64_t& word : s_) {
+            word = splitmix64(seed);
+        }
+    }
+
+    //NOTE: state must not be all zero
+    constexpr explicit xoshiro256pp(const std::array<std::uint64_t, 4>& state) noexcept : s_(state) {}
+
+    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+    [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    constexpr result_type operator()() noexcept {
+        const std::uint64_t result = std::rotl(s_[0] + s_[3], 23) + s_[0];
+        const std::uint64_t t      = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = std::rotl(s_[3], 45);
+        return result;
+    }
+
+    //NOTE: advances by 2^128 calls
+    constexpr void jump() noexcept {
+        apply({0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull, 0x39abdc4529b1661cull});
+    }
+
+    //NOTE: advances by 2^192 calls
+    constexpr void long_jump() noexcept {
+        apply({0x76e15d3efefdcbbfull, 0xc5004e441c522fb3ull, 0x77710069854ee241ull, 0x39109bb02acbe635ull});
+    }
+
+    //NOTE: returns a copy of this generator, then long-jumps this one; call it once per thread or
+    //      task to get non-overlapping streams
+    [[nodiscard]] constexpr xoshiro256pp fork() noexcept {
+        const xoshiro256pp copy = *this;
+        long_jump();
+        return copy;
+    }
+
+    [[nodiscard]] constexpr const std::array<std::uint64_t, 4>& state() const noexcept { return s_; }
+
+    [[nodiscard]] friend constexpr bool operator==(const xoshiro256pp&, const xoshiro256pp&) noexcept = default;
+
+private:
+    constexpr void apply(const std::array<std::uint64_t, 4>& poly) noexcept {
+        std::array<std::uint64_t, 4> s{};
+        for (const std::uint64_t word : poly) {
+            for (int b = 0; b < 64; ++b) {
+                if (word & (std::uint64_t{1} << b)) {
+                    for (std::size_t i = 0; i < 4; ++i) {
+                        s[i] ^= s_[i];
+                    }
+                }
+                (*this)();
+            }
+        }
+        s_ = s;
+    }
+
+    std::array<std::uint64_t, 4> s_;
+};
+
+//NOTE: PCG32, XSH-RR variant (O'Neill): 64-bit state, 32-bit output, period 2^64; every stream
+//      selector gives a distinct sequence
+class pcg32 {
+public:
+    using result_type = std::uint32_t;
+
+    constexpr explicit pcg32(std::uint64_t seed = 0, std::uint64_t stream = 0) noexcept
+        : inc_((stream << 1) | 1u) {
+        (*this)();
+        state_ += seed;
+        (*this)();
+    }
+
+    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+    [[nodiscard]] static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    constexpr result_type operator()() noexcept {
+        const std::uint64_t old = state_;
+        state_ = old * Multiplier + inc_;
+        const auto xorshifted = static_cast<std::uint32_t>(((old >> 18) ^ old) >> 27);
+        return std::rotr(xorshifted, static_cast<int>(old >> 59));
+    }
+
+    //NOTE: advances by delta calls in O(log delta) (Brown, "Random number generation with
+    //      arbitrary strides")
+    constexpr void advance(std::uint64_t delta) noexcept {
+        std::uint64_t mul = Multiplier;
+        std::uint64_t add = inc_;
+        std::uint64_t acc_mul = 1;
+        std::uint64_t acc_add = 0;
+        while (delta > 0) {
+            if (delta & 1u) {
+                acc_mul *= mul;
+                acc_add = acc_add * mul + add;
+            }
+            add = (mul + 1) * add;
+            mul *= mul;
+            delta >>= 1;
+        }
+        state_ = acc_mul * state_ + acc_add;
+    }
+
+    constexpr void discard(std::uint64_t n) noexcept { advance(n); }
+
+    [[nodiscard]] friend constexpr bool operator==(const pcg32&, const pcg32&) noexcept = default;
+
+private:
+    static constexpr std::uint64_t Multiplier = 6364136223846793005ull;
+
+    std::uint64_t state_{0};
+    std::uint64_t inc_;
+};
+
+namespace detail {
+
+template<typename G>
+concept word_generator = std::uniform_random_bit_generator<G> && G::min() == 0 &&
+                         (G::max() == std::numeric_limits<std::uint32_t>::max() ||
+                          G::max() == std::numeric_limits<std::uint64_t>::max());
+
+//NOTE: the high half of 64-bit outputs; the low bits of some generators are weaker
+template<word_generator G>
+[[nodiscard]] constexpr std::uint32_t next_u32(G& g) {
+    if constexpr (G::max() == std::numeric_limits<std::uint32_t>::max()) {
+        return static_cast<std::uint32_t>(g());
+    } else {
+        return static_cast<std::uint32_t>(g() >> 32);
+    }
+}
+
+} // namespace detail
+
+//NOTE: the single-value helpers below take any generator with full 32- or 64-bit output and map
+//      it exactly like the fill_* functions do
+
+//NOTE: [0, 1) in steps of 2^-24
+template<detail::word_generator G>
+[[nodiscard]] inline float uniform(G& g) {
+    return detail::uniform01<detail::scalar_lane>(detail::next_u32(g));
+}
+
+//NOTE: lo + (hi - lo) * uniform(g); rounding can return hi itself when |lo| is much larger than
+//      hi - lo
+template<detail::word_generator G>
+[[nodiscard]] inline float uniform(G& g, float lo, float hi) {
+    return lo + (hi - lo) * uniform(g);
+}
+
+template<detail::word_generator G>
+[[nodiscard]] inline vec<3, float> unit_vector(G& g) {
+    const std::uint32_t a = detail::next_u32(g);
+    const std::uint32_t b = detail::next_u32(g);
+    vec<3, float> v;
+    detail::unit_vector<detail::scalar_lane>(a, b, v.x, v.y, v.z);
+    return v;
+}
+
+//NOTE: normal distribution, truncated at about 5.8 standard deviations; each call draws a fresh
+//      pair and discards the second sample, the fill_gaussian batch keeps both
+template<detail::word_generator G>
+[[nodiscard]] inline float gaussian(G& g, float mean = 0.0f, float stddev = 1.0f) {
+    const std::uint32_t a = detail::next_u32(g);
+    const std::uint32_t b = detail::next_u32(g);
+    float g0;
+    float g1;
+    detail::gaussian_pair<detail::scalar_lane>(a, b, g0, g1);
+    return mean + stddev * g0;
+}
+
+//NOTE: eight xoshiro256++ streams stepped together; stream i starts at the seed generator jumped
+//      i times (2^128 calls apart), so forked generators never overlap. The state is kept in SoA
+//      order, word k of stream i at state()[k * 8 + i], which is what the batch kernels load.
+//      The output depends only on the seed and the call sequence, never on the ISA.
+class xoshiro256pp_x8 {
+public:
+    static constexpr std::size_t lanes = 8;
+
+    explicit xoshiro256pp_x8(std::uint64_t seed = 0) noexcept : xoshiro256pp_x8(xoshiro256pp(seed)) {}
+
+    explicit xoshiro256pp_x8(xoshiro256pp base) noexcept {
+        for (std::size_t i = 0; i < lanes; ++i) {
+            for (std::size_t k = 0; k < 4; ++k) {
+                state_[k * lanes + i] = base.state()[k];
+            }
+            base.jump();
+        }
+    }
+
+    [[nodiscard]] std::array<std::uint64_t, 4 * lanes>&       state() noexcept { return state_; }
+    [[nodiscard]] const std::array<std::uint64_t, 4 * lanes>& state() const noexcept { return state_; }
+
+private:
+    alignas(32) std::array<std::uint64_t, 4 * lanes> state_;
+};
+
+//NOTE: each step of the eight streams yields 16 floats for fill_uniform and fill_gaussian and 8
+//      vectors for fill_unit_vectors; a span that ends mid-step discards the rest of that step, so
+//      splitting one fill into several changes the values unless the cuts fall on step boundaries
+
+void fill_uniform(xoshiro256pp_x8& rng, std::span<float> out, float lo = 0.0f, float hi = 1.0f) noexcept;
+
+void fill_unit_vectors(xoshiro256pp_x8& rng, std::span<vec<3, float>> out) noexcept;
+
+void fill_gaussian(xoshiro256pp_x8& rng, std::span<float> out, float mean = 0.0f, float stddev = 1.0f) noexcept;
+
+} // namespace cc::random
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "../detail/lane.hpp"
+
+#include <cstdint>
+
+//NOTE: Lane-generic mappings from random 32-bit words to floats (see detail/lane.hpp), shared by
+//      cc/math/random/random.hpp and the cc::batch kernel TUs so both produce the same values.
+namespace cc::random::detail {
+
+using cc::detail::scalar_lane;
+
+template<typename L>
+using f_t = typename L::f;
+
+template<typename L>
+using u_t = typename L::u;
+
+//NOTE: [0, 1) from the top 24 bits, every value a multiple of 2^-24
+template<typename L>
+[[nodiscard]] inline f_t<L> uniform01(u_t<L> bits) noexcept {
+    return L::to_f(bits >> 8) * f_t<L>(1.0f / 16777216.0f);
+}
+
+//NOTE: ln(x) for normal x > 0: x = 2^e * m with m in [sqrt(1/2), sqrt(2)) and
+//      ln(1 + t) = t * p(t), p a minimax fit; relative error below 3e-7
+template<typename L>
+[[nodiscard]] inline f_t<L> log(f_t<L> x) noexcept {
+    using F = f_t<L>;
+    using U = u_t<L>;
+    const U bits = L::as_u(x) + U(0x3f800000u - 0x3f3504f3u);
+    const F e = L::to_f(bits >> 23) - F(127.0f);
+    const F t = L::as_f((bits & U(0x007fffffu)) + U(0x3f3504f3u)) - F(1.0f);
+
+    F p = F(-0.10378718872105866f);
+    p = p * t + F(0.16338146972096113f);
+    p = p * t + F(-0.17212425696733077f);
+    p = p * t + F(0.1988423527550451f);
+    p = p * t + F(-0.24971560284239283f);
+    p = p * t + F(0.33335607908948706f);
+    p = p * t + F(-0.5000034428095813f);
+    p = p * t + F(0.9999999178558293f);
+    return e * F(0.6931471805599453f) + t * p;
+}
+
+//NOTE: sin and cos of 2 pi s for s in [-1/2, 1/2], within 3e-7; the polynomials are those of
+//      cc::fast::sin / cos (precision::high) on [-pi / 2, pi / 2]
+template<typename L>
+inline void sincos_turns(f_t<L> s, f_t<L>& sin_out, f_t<L>& cos_out) noexcept {
+    using F = f_t<L>;
+    using U = u_t<L>;
+    const U sign = L::as_u(s) & U(0x80000000u);
+    //NOTE: with a = |s|: sin(2 pi a) = cos(r) and cos(2 pi a) = -sin(r), r = 2 pi (a - 1/4)
+    const F r  = (L::as_f(L::as_u(s) ^ sign) - F(0.25f)) * F(6.283185307179586f);
+    const F r2 = r * r;
+
+    F sp = F(2.59048850135675e-06f);
+    sp = sp * r2 + F(-0.0001980089776321234f);
+    sp = sp * r2 + F(0.00833289982335853f);
+    sp = sp * r2 + F(-0.1666664763464011f);
+    sp = sp * r2 + F(0.9999999765898828f);
+
+    F cp = F(2.3194386495944077e-05f);
+    cp = cp * r2 + F(-0.0013855927184659967f);
+    cp = cp * r2 + F(0.04166398945486036f);
+    cp = cp * r2 + F(-0.49999932293054106f);
+    cp = cp * r2 + F(1.0f);
+
+    sin_out = L::as_f(L::as_u(cp) ^ sign);
+    cos_out = -(sp * r);
+}
+
+//NOTE: uniform on the unit sphere (Archimedes): z uniform in [-1, 1), longitude uniform
+template<typename L>
+inline void unit_vector(u_t<L> a, u_t<L> b, f_t<L>& x, f_t<L>& y, f_t<L>& z) noexcept {
+    using F = f_t<L>;
+    z = uniform01<L>(a) * F(2.0f) - F(1.0f);
+    const F r = L::sqrt(L::max(F(1.0f) - z * z, F(0.0f)));
+    F s;
+    F c;
+    sincos_turns<L>(uniform01<L>(b) - F(0.5f), s, c);
+    x = r * c;
+    y = r * s;
+}
+
+//NOTE: two independent standard normal samples (Box-Muller); 1 - u keeps the log argument in
+//      (0, 1], so the largest magnitude is sqrt(-2 ln 2^-24), about 5.8
+template<typename L>
+inline void gaussian_pair(u_t<L> a, u_t<L> b, f_t<L>& g0, f_t<L>& g1) noexcept {
+    using F = f_t<L>;
+    const F r = L::sqrt(F(-2.0f) * log<L>(F(1.0f) - uniform01<L>(a)));
+    F s;
+    F c;
+    sincos_turns<L>(uniform01<L>(b) - F(0.5f), s, c);
+    g0 = r * c;
+    g1 = r * s;
+}
+
+} // namespace cc::random::detail
@@ -0,0 +1,293 @@
+#pragma once
+
+#include "../detail/simd.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+//NOTE: Register-level operations behind cc::simd. The generic version works on plain arrays and
+//      is always available; float x4 (SSE) and float x8 (AVX) map onto one register each when
+//      the including TU is compiled for them.
+namespace cc::detail::simd {
+
+template<typename T, std::size_t W>
+struct abi {
+    using reg  = std::array<T, W>;
+    using mask = std::array<bool, W>;
+
+    template<typename Fn>
+    static reg map(Fn&& fn) noexcept {
+        reg r;
+        for (std::size_t i = 0; i < W; ++i) r[i] = fn(i);
+        return r;
+    }
+
+    template<typename Fn>
+    static mask test(Fn&& fn) noexcept {
+        mask r;
+        for (std::size_t i = 0; i < W; ++i) r[i] = fn(i);
+        return r;
+    }
+
+    static reg broadcast(T s) noexcept { return map([&](std::size_t) { return s; }); }
+    static reg load(const T* p) noexcept { return map([&](std::size_t i) { return p[i]; }); }
+    static reg loadu(const T* p) noexcept { return load(p); }
+    static void store(const reg& a, T* p) noexcept { for (std::size_t i = 0; i < W; ++i) p[i] = a[i]; }
+    static void storeu(const reg& a, T* p) noexcept { store(a, p); }
+    static T get(const reg& a, std::size_t i) noexcept { return a[i]; }
+
+    static reg add(const reg& a, const reg& b) noexcept { return map([&](std::size_t i) { return a[i] + b[i]; }); }
+    static reg sub(const reg& a, const reg& b) noexcept { return map([&](std::size_t i) { return a[i] - b[i]; }); }
+    static reg mul(const reg& a, const reg& b) noexcept { return map([&](std::size_t i) { return a[i] * b[i]; }); }
+    static reg div(const reg& a, const reg& b) noexcept { return map([&](std::size_t i) { return a[i] / b[i]; }); }
+    static reg neg(const reg& a) noexcept { return map([&](std::size_t i) { return -a[i]; }); }
+    static reg fma(const reg& a, const reg& b, const reg& c) noexcept {
+        return map([&](std::size_t i) { return a[i] * b[i] + c[i]; });
+    }
+    static reg sqrt(const reg& a) noexcept { return map([&](std::size_t i) { return std::sqrt(a[i]); }); }
+    static reg abs(const reg& a) noexcept { return map([&](std::size_t i) { return std::fabs(a[i]); }); }
+    static reg min(const reg& a, const reg& b) noexcept { return map([&](std::size_t i) { return b[i] < a[i] ? b[i] : a[i]; }); }
+    static reg max(const reg& a, const reg& b) noexcept { return map([&](std::size_t i) { return a[i] < b[i] ? b[i] : a[i]; }); }
+
+    //NOTE: building blocks for cc::fast: an approximate 1 / sqrt(a), and 2^k for integral k
+    //      within the normal exponent range
+    static reg rsqrt_estimate(const reg& a) noexcept {
+        return map([&](std::size_t i) { return T{1} / std::sqrt(a[i]); });
+    }
+    static reg exp2i(const reg& k) noexcept {
+        return map([&](std::size_t i) { return std::ldexp(T{1}, static_cast<int>(k[i])); });
+    }
+
+    static mask eq(const reg& a, const reg& b) noexcept { return test([&](std::size_t i) { return a[i] == b[i]; }); }
+    static mask ne(const reg& a, const reg& b) noexcept { return test([&](std::size_t i) { return a[i] != b[i]; }); }
+    static mask lt(const reg& a, const reg& b) noexcept { return test([&](std::size_t i) { return a[i] < b[i]; }); }
+    static mask le(const reg& a, const reg& b) noexcept { return test([&](std::size_t i) { return a[i] <= b[i]; }); }
+    static mask gt(const reg& a, const reg& b) noexcept { return test([&](std::size_t i) { return a[i] > b[i]; }); }
+    static mask ge(const reg& a, const reg& b) noexcept { return test([&](std::size_t i) { return a[i] >= b[i]; }); }
+
+    static mask mask_and(const mask& a, const mask& b) noexcept { return test([&](std::size_t i) { return a[i] && b[i]; }); }
+    static mask mask_or(const mask& a, const mask& b) noexcept { return test([&](std::size_t i) { return a[i] || b[i]; }); }
+    static mask mask_xor(const mask& a, const mask& b) noexcept { return test([&](std::size_t i) { return a[i] != b[i]; }); }
+    static mask mask_not(const mask& a) noexcept { return test([&](std::size_t i) { return !a[i]; }); }
+    static mask mask_broadcast(bool v) noexcept { return test([&](std::size_t) { return v; }); }
+
+    static std::uint32_t bits(const mask& m) noexcept {
+        std::uint32_t r = 0;
+        for (std::size_t i = 0; i < W; ++i) r |= static_cast<std::uint32_t>(m[i]) << i;
+        return r;
+    }
+
+    static reg select(const mask& m, const reg& a, const reg& b) noexcept {
+        return map([&](std::size_t i) { return m[i] ? a[i] : b[i]; });
+    }
+
+    static T reduce_add(const reg& a) noexcept {
+        T r{};
+        for (std::size_t i = 0; i < W; ++i) r += a[i];
+        return r;
+    }
+};
+
+#if defined(CC_MATH_SSE2)
+
+template<>
+struct abi<float, 4> {
+    using reg  = __m128;
+    using mask = __m128;
+
+    static reg broadcast(float s) noexcept { return _mm_set1_ps(s); }
+    static reg load(const float* p) noexcept { return _mm_load_ps(p); }
+    static reg loadu(const float* p) noexcept { return _mm_loadu_ps(p); }
+    static void store(reg a, float* p) noexcept { _mm_store_ps(p, a); }
+    static void storeu(reg a, float* p) noexcept { _mm_storeu_ps(p, a); }
+    static float get(reg a, std::size_t i) noexcept {
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, a);
+        return lanes[i];
+    }
+
+    static reg add(reg a, reg b) noexcept { return _mm_add_ps(a, b); }
+    static reg sub(reg a, reg b) noexcept { return _mm_sub_ps(a, b); }
+    static reg mul(reg a, reg b) noexcept { return _mm_mul_ps(a, b); }
+    static reg div(reg a, reg b) noexcept { return _mm_div_ps(a, b); }
+    static reg neg(reg a) noexcept { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+    static reg fma(reg a, reg b, reg c) noexcept { return madd(a, b, c); }
+    static reg sqrt(reg a) noexcept { return _mm_sqrt_ps(a); }
+    static reg abs(reg a) noexcept { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    static reg min(reg a, reg b) noexcept { return _mm_min_ps(a, b); }
+    static reg max(reg a, reg b) noexcept { return _mm_max_ps(a, b); }
+
+    //NOTE: rsqrtps, relative error below 1.5 * 2^-12
+    static reg rsqrt_estimate(reg a) noexcept { return _mm_rsqrt_ps(a); }
+    static reg exp2i(reg k) noexcept {
+        return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(k), _mm_set1_epi32(127)), 23));
+    }
+
+    static mask eq(reg a, reg b) noexcept { return _mm_cmpeq_ps(a, b); }
+    static mask ne(reg a, reg b) noexcept { return _mm_cmpneq_ps(a, b); }
+    static mask lt(reg a, reg b) noexcept { return _mm_cmplt_ps(a, b); }
+    static mask le(reg a, reg b) noexcept { return _mm_cmple_ps(a, b); }
+    static mask gt(reg a, reg b) noexcept { return _mm_cmpgt_ps(a, b); }
+    static mask ge(reg a, reg b) noexcept { return _mm_cmpge_ps(a, b); }
+
+    static mask mask_and(mask a, mask b) noexcept { return _mm_and_ps(a, b); }
+    static mask mask_or(mask a, mask b) noexcept { return _mm_or_ps(a, b); }
+    static mask mask_xor(mask a, mask b) noexcept { return _mm_xor_ps(a, b); }
+    static mask mask_not(mask a) noexcept { return _mm_xor_ps(a, _mm_castsi128_ps(_mm_set1_epi32(-1))); }
+    static mask mask_broadcast(bool v) noexcept { return _mm_castsi128_ps(_mm_set1_epi32(v ? -1 : 0)); }
+
+    static std::uint32_t bits(mask m) noexcept { return static_cast<std::uint32_t>(_mm_movemask_ps(m)); }
+
+    static reg select(mask m, reg a, reg b) noexcept {
+#if defined(CC_MATH_SSE41)
+        return _mm_blendv_ps(b, a, m);
+#else
+        return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+#endif
+    }
+
+    static float reduce_add(reg a) noexcept {
+        const __m128 s1 = _mm_add_ps(a, _mm_movehl_ps(a, a));
+        return _mm_cvtss_f32(_mm_add_ss(s1, _mm_shuffle_ps(s1, s1, _MM_SHUFFLE(1, 1, 1, 1))));
+    }
+};
+
+#endif // CC_MATH_SSE2
+
+#if defined(CC_MATH_AVX)
+
+template<>
+struct abi<float, 8> {
+    using reg  = __m256;
+    using mask = __m256;
+
+    [[nodiscard]] static __m256 madd8(__m256 a, __m256 b, __m256 c) noexcept {
+#if defined(CC_MATH_FMA)
+        return _mm256_fmadd_ps(a, b, c);
+#else
+        return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+    }
+
+    static reg broadcast(float s) noexcept { return _mm256_set1_ps(s); }
+    static reg load(const float* p) noexcept { return _mm256_load_ps(p); }
+    static reg loadu(const float* p) noexcept { return _mm256_loadu_ps(p); }
+    static void store(reg a, float* p) noexcept { _mm256_store_ps(p, a); }
+    static void storeu(reg a, float* p) noexcept { _mm256_storeu_ps(p, a); }
+    static float get(reg a, std::size_t i) noexcept {
+        alignas(32) float lanes[8];
+        _mm256_store_ps(lanes, a);
+        return lanes[i];
+    }
+
+    static reg add(reg a, reg b) noexcept { return _mm256_add_ps(a, b); }
+    static reg sub(reg a, reg b) noexcept { return _mm256_sub_ps(a, b); }
+    static reg mul(reg a, reg b) noexcept { return _mm256_mul_ps(a, b); }
+    static reg div(reg a, reg b) noexcept { return _mm256_div_ps(a, b); }
+    static reg neg(reg a) noexcept { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+    static reg fma(reg a, reg b, reg c) noexcept { return madd8(a, b, c); }
+    static reg sqrt(reg a) noexcept { return _mm256_sqrt_ps(a); }
+    static reg abs(reg a) noexcept { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    static reg min(reg a, reg b) noexcept { return _mm256_min_ps(a, b); }
+    static reg max(reg a, reg b) noexcept { return _mm256_max_ps(a, b); }
+
+    static reg rsqrt_estimate(reg a) noexcept { return _mm256_rsqrt_ps(a); }
+    static reg exp2i(reg k) noexcept {
+        const __m256i e = _mm256_cvtps_epi32(k);
+#if defined(CC_MATH_AVX2)
+        return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(e, _mm256_set1_epi32(127)), 23));
+#else
+        //NOTE: AVX1 has no 256-bit integer ops, build each half with SSE2
+        const __m128i bias = _mm_set1_epi32(127);
+        const __m128i lo = _mm_slli_epi32(_mm_add_epi32(_mm256_castsi256_si128(e), bias), 23);
+        const __m128i hi = _mm_slli_epi32(_mm_add_epi32(_mm256_extractf128_si256(e, 1), bias), 23);
+        return _mm256_castsi256_ps(_mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1));
+#endif
+    }
+
+    static mask eq(reg a, reg b) noexcept { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    static mask ne(reg a, reg b) noexcept { return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ); }
+    static mask lt(reg a, reg b) noexcept { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static mask le(reg a, reg b) noexcept { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static mask gt(reg a, reg b) noexcept { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static mask ge(reg a, reg b) noexcept { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+
+    static mask mask_and(mask a, mask b) noexcept { return _mm256_and_ps(a, b); }
+    static mask mask_or(mask a, mask b) noexcept { return _mm256_or_ps(a, b); }
+    static mask mask_xor(mask a, mask b) noexcept { return _mm256_xor_ps(a, b); }
+    static mask mask_not(mask a) noexcept { return _mm256_xor_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+    static mask mask_broadcast(bool v) noexcept { return _mm256_castsi256_ps(_mm256_set1_epi32(v ? -1 : 0)); }
+
+    static std::uint32_t bits(mask m) noexcept { return static_cast<std::uint32_t>(_mm256_movemask_ps(m)); }
+
+    static reg select(mask m, reg a, reg b) noexcept { return _mm256_blendv_ps(b, a, m); }
+
+    static float reduce_add(reg a) noexcept {
+        const __m128 s  = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+        const __m128 s1 = _mm_add_ps(s, _mm_movehl_ps(s, s));
+        return _mm_cvtss_f32(_mm_add_ss(s1, _mm_shuffle_ps(s1, s1, _MM_SHUFFLE(1, 1, 1, 1))));
+    }
+};
+
+#elif defined(CC_MATH_SSE2)
+
+//NOTE: without AVX, float x8 runs as two SSE registers
+template<>
+struct abi<float, 8> {
+    using half = abi<float, 4>;
+
+    struct reg {
+        __m128 lo, hi;
+    };
+    using mask = reg;
+
+    template<typename Fn, typename... Args>
+    static reg both(Fn fn, const Args&... args) noexcept {
+        return {fn(args.lo...), fn(args.hi...)};
+    }
+
+    static reg broadcast(float s) noexcept { return {_mm_set1_ps(s), _mm_set1_ps(s)}; }
+    static reg load(const float* p) noexcept { return {_mm_load_ps(p), _mm_load_ps(p + 4)}; }
+    static reg loadu(const float* p) noexcept { return {_mm_loadu_ps(p), _mm_loadu_ps(p + 4)}; }
+    static void store(reg a, float* p) noexcept { _mm_store_ps(p, a.lo); _mm_store_ps(p + 4, a.hi); }
+    static void storeu(reg a, float* p) noexcept { _mm_storeu_ps(p, a.lo); _mm_storeu_ps(p + 4, a.hi); }
+    static float get(reg a, std::size_t i) noexcept { return i < 4 ? half::get(a.lo, i) : half::get(a.hi, i - 4); }
+
+    static reg add(reg a, reg b) noexcept { return both(half::add, a, b); }
+    static reg sub(reg a, reg b) noexcept { return both(half::sub, a, b); }
+    static reg mul(reg a, reg b) noexcept { return both(half::mul, a, b); }
+    static reg div(reg a, reg b) noexcept { return both(half::div, a, b); }
+    static reg neg(reg a) noexcept { return both(half::neg, a); }
+    static reg fma(reg a, reg b, reg c) noexcept { return both(half::fma, a, b, c); }
+    static reg sqrt(reg a) noexcept { return both(half::sqrt, a); }
+    static reg abs(reg a) noexcept { return both(half::abs, a); }
+    static reg min(reg a, reg b) noexcept { return both(half::min, a, b); }
+    static reg max(reg a, reg b) noexcept { return both(half::max, a, b); }
+    static reg rsqrt_estimate(reg a) noexcept { return both(half::rsqrt_estimate, a); }
+    static reg exp2i(reg k) noexcept { return both(half::exp2i, k); }
+
+    static mask eq(reg a, reg b) noexcept { return both(half::eq, a, b); }
+    static mask ne(reg a, reg b) noexcept { return both(half::ne, a, b); }
+    static mask lt(reg a, reg b) noexcept { return both(half::lt, a, b); }
+    static mask le(reg a, reg b) noexcept { return both(half::le, a, b); }
+    static mask gt(reg a, reg b) noexcept { return both(half::gt, a, b); }
+    static mask ge(reg a, reg b) noexcept { return both(half::ge, a, b); }
+
+    static mask mask_and(mask a, mask b) noexcept { return both(half::mask_and, a, b); }
+    static mask mask_or(mask a, mask b) noexcept { return both(half::mask_or, a, b); }
+    static mask mask_xor(mask a, mask b) noexcept { return both(half::mask_xor, a, b); }
+    static mask mask_not(mask a) noexcept { return both(half::mask_not, a); }
+    static mask mask_broadcast(bool v) noexcept { return {half::mask_broadcast(v), half::mask_broadcast(v)}; }
+
+    static std::uint32_t bits(mask m) noexcept { return half::bits(m.lo) | (half::bits(m.hi) << 4); }
+
+    static reg select(mask m, reg a, reg b) noexcept { return both(half::select, m, a, b); }
+
+    static float reduce_add(reg a) noexcept { return half::reduce_add(_mm_add_ps(a.lo, a.hi)); }
+};
+
+#endif // CC_MATH_AVX
+
+} // namespace cc::detail::simd
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "../detail/arithmetic.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace cc {
+
+template<floating_point T, std::size_t W>
+class simd;
+
+template<floating_point T, std::size_t W>
+class simd_mask;
+
+template<typename T>
+struct is_simd : std::false_type {};
+
+template<floating_point T, std::size_t W>
+struct is_simd<simd<T, W>> : std::true_type {};
+
+template<typename T>
+concept simd_pack = is_simd<T>::value;
+
+} // namespace cc
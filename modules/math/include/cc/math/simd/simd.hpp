@@ -0,0 +1,216 @@
+#pragma once
+
+#include "fwd.hpp"
+#include "abi.hpp"
+#include "../detail/arithmetic.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace cc {
+
+//NOTE: Lane-wise mask produced by simd comparisons; consumed by select(), any(), all(), none().
+template<floating_point T, std::size_t W>
+class simd_mask {
+    using abi = detail::simd::abi<T, W>;
+
+public:
+    using reg_type = typename abi::mask;
+
+    simd_mask() noexcept : reg_(abi::mask_broadcast(false)) {}
+    explicit simd_mask(bool value) noexcept : reg_(abi::mask_broadcast(value)) {}
+    explicit simd_mask(reg_type reg) noexcept : reg_(reg) {}
+
+    [[nodiscard]] reg_type reg() const noexcept {
+        return reg_;
+    }
+
+    //NOTE: bit i is set when lane i is true
+    [[nodiscard]] std::uint32_t bits() const noexcept {
+        return abi::bits(reg_);
+    }
+
+    [[nodiscard]] bool operator[](std::size_t i) const noexcept {
+        assert(i < W);
+        return (bits() >> i) & 1u;
+    }
+
+    [[nodiscard]] friend simd_mask operator&&(const simd_mask& a, const simd_mask& b) noexcept {
+        return simd_mask(abi::mask_and(a.reg_, b.reg_));
+    }
+
+    [[nodiscard]] friend simd_mask operator||(const simd_mask& a, const simd_mask& b) noexcept {
+        return simd_mask(abi::mask_or(a.reg_, b.reg_));
+    }
+
+    [[nodiscard]] friend simd_mask operator^(const simd_mask& a, const simd_mask& b) noexcept {
+        return simd_mask(abi::mask_xor(a.reg_, b.reg_));
+    }
+
+    [[nodiscard]] simd_mask operator!() const noexcept {
+        return simd_mask(abi::mask_not(reg_));
+    }
+
+    [[nodiscard]] friend bool any(const simd_mask& m) noexcept {
+        return m.bits() != 0;
+    }
+
+    [[nodiscard]] friend bool all(const simd_mask& m) noexcept {
+        return m.bits() == (W == 32 ? ~0u : (1u << W) - 1u);
+    }
+
+    [[nodiscard]] friend bool none(const simd_mask& m) noexcept {
+        return m.bits() == 0;
+    }
+
+private:
+    reg_type reg_;
+};
+
+//NOTE: W lanes of T processed together. float x4 and float x8 are one SSE / AVX register when
+//      the TU is compiled for it and fall back to plain arrays otherwise. Scalars convert
+//      implicitly (broadcast), so `v * 2.0f` and `simd(1.0f) - t` read like scalar code.
+template<floating_point T, std::size_t W>
+class alignas(W * sizeof(T)) simd {
+    using abi = detail::simd::abi<T, W>;
+
+public:
+    static constexpr std::size_t size = W;
+    using value_type = T;
+    using mask_type  = simd_mask<T, W>;
+    using reg_type   = typename abi::reg;
+
+    simd() noexcept : reg_(abi::broadcast(T{})) {}
+    simd(T scalar) noexcept : reg_(abi::broadcast(scalar)) {}
+    explicit simd(reg_type reg) noexcept : reg_(reg) {}
+
+    //NOTE: p must be aligned to W * sizeof(T)
+    [[nodiscard]] static simd load(const T* p) noexcept {
+        return simd(abi::load(p));
+    }
+
+    [[nodiscard]] static simd loadu(const T* p) noexcept {
+        return simd(abi::loadu(p));
+    }
+
+    void store(T* p) const noexcept {
+        abi::store(reg_, p);
+    }
+
+    void storeu(T* p) const noexcept {
+        abi::storeu(reg_, p);
+    }
+
+    [[nodiscard]] reg_type reg() const noexcept {
+        return reg_;
+    }
+
+    [[nodiscard]] T operator[](std::size_t i) const noexcept {
+        assert(i < W);
+        return abi::get(reg_, i);
+    }
+
+    simd& operator+=(const simd& other) noexcept {
+        reg_ = abi::add(reg_, other.reg_);
+        return *this;
+    }
+
+    simd& operator-=(const simd& other) noexcept {
+        reg_ = abi::sub(reg_, other.reg_);
+        return *this;
+    }
+
+    simd& operator*=(const simd& other) noexcept {
+        reg_ = abi::mul(reg_, other.reg_);
+        return *this;
+    }
+
+    simd& operator/=(const simd& other) noexcept {
+        reg_ = abi::div(reg_, other.reg_);
+        return *this;
+    }
+
+    [[nodiscard]] friend simd operator+(const simd& a, const simd& b) noexcept {
+        return simd(abi::add(a.reg_, b.reg_));
+    }
+
+    [[nodiscard]] friend simd operator-(const simd& a, const simd& b) noexcept {
+        return simd(abi::sub(a.reg_, b.reg_));
+    }
+
+    [[nodiscard]] friend simd operator*(const simd& a, const simd& b) noexcept {
+        return simd(abi::mul(a.reg_, b.reg_));
+    }
+
+    [[nodiscard]] friend simd operator/(const simd& a, const simd& b) noexcept {
+        return simd(abi::div(a.reg_, b.reg_));
+    }
+
+    [[nodiscard]] simd operator-() const noexcept {
+        return simd(abi::neg(reg_));
+    }
+
+    [[nodiscard]] friend mask_type operator==(const simd& a, const simd& b) noexcept {
+        return mask_type(abi::eq(a.reg_, b.reg_));
+    }
+
+    [[nodiscard]] friend mask_type operator!=(const simd& a, const simd& b) noexcept {
+        return mask_type(abi::ne(a.reg_, b.reg_));
+    }
+
+    [[nodiscard]] friend mask_type operator<(const simd& a, const simd& b) noexcept {
+        return mask_type(abi::lt(a.reg_, b.reg_));
+    }
+
+    [[nodiscard]] friend mask_type operator<=(const simd& a, const simd& b) noexcept {
+        return mask_type(abi::le(a.reg_, b.reg_));
+    }
+
+    [[nodiscard]] friend mask_type operator>(const simd& a, const simd& b) noexcept {
+        return mask_type(abi::gt(a.reg_, b.reg_));
+    }
+
+    [[nodiscard]] friend mask_type operator>=(const simd& a, const simd& b) noexcept {
+        return mask_type(abi::ge(a.reg_, b.reg_));
+    }
+
+    //NOTE: a * b + c, fused when FMA is available
+    [[nodiscard]] friend simd fma(const simd& a, const simd& b, const simd& c) noexcept {
+        return simd(abi::fma(a.reg_, b.reg_, c.reg_));
+    }
+
+    [[nodiscard]] friend simd sqrt(const simd& a) noexcept {
+        return simd(abi::sqrt(a.reg_));
+    }
+
+    [[nodiscard]] friend simd abs(const simd& a) noexcept {
+        return simd(abi::abs(a.reg_));
+    }
+
+    [[nodiscard]] friend simd min(const simd& a, const simd& b) noexcept {
+        return simd(abi::min(a.reg_, b.reg_));
+    }
+
+    [[nodiscard]] friend simd max(const simd& a, const simd& b) noexcept {
+        return simd(abi::max(a.reg_, b.reg_));
+    }
+
+    [[nodiscard]] friend simd clamp(const simd& v, const simd& lo, const simd& hi) noexcept {
+        return min(max(v, lo), hi);
+    }
+
+    //NOTE: lane i = m[i] ? a[i] : b[i]
+    [[nodiscard]] friend simd select(const mask_type& m, const simd& a, const simd& b) noexcept {
+        return simd(abi::select(m.reg(), a.reg_, b.reg_));
+    }
+
+    [[nodiscard]] friend T reduce_add(const simd& a) noexcept {
+        return abi::reduce_add(a.reg_);
+    }
+
+private:
+    reg_type reg_;
+};
+
+} // namespace cc
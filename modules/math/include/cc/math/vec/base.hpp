@@ -1,5 +1,6 @@
 #pragma once
 
+#include "fwd.hpp"
 #include "../detail/arithmetic.hpp"
 #include "../common/functions.hpp"
 
@@ -9,7 +10,7 @@
 
 namespace cc {
 
-template<std::size_t N, arithmetic T>
+template<std::size_t N, vec_element T>
 requires (N >= 2)
 class vec {
 public:
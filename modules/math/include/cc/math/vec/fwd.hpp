@@ -1,11 +1,16 @@
 #pragma once
 
 #include "../detail/arithmetic.hpp"
+#include "../simd/fwd.hpp"
 #include <cstddef>
 
 namespace cc {
 
-template<std::size_t N, arithmetic T>
+//NOTE: scalars, or simd packs for the wide SoA specialisations (vec<3, simd<float, 8>>)
+template<typename T>
+concept vec_element = arithmetic<T> || simd_pack<T>;
+
+template<std::size_t N, vec_element T>
 requires (N >= 2)
 class vec;
 
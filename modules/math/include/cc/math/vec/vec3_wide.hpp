@@ -0,0 +1,192 @@
+#pragma once
+
+#include "fwd.hpp"
+#include "vec3.hpp"
+#include "../simd/simd.hpp"
+#include "../common/constants.hpp"
+
+#include <cassert>
+#include <cstddef>
+
+namespace cc {
+
+//NOTE: W vec3s in struct-of-arrays form, one simd register per axis. Mirrors the vec<3, T>
+//      interface so scalar code ports mechanically; reductions (dot, length) return a simd
+//      and comparisons return masks instead of bool.
+template<floating_point T, std::size_t W>
+class vec<3, simd<T, W>> {
+public:
+    using pack_type = simd<T, W>;
+    using mask_type = typename pack_type::mask_type;
+
+    static constexpr std::size_t size  = 3;
+    static constexpr std::size_t lanes = W;
+    using value_type = pack_type;
+
+    pack_type x, y, z;
+
+    vec() noexcept = default;
+    explicit vec(pack_type scalar) noexcept : x(scalar), y(scalar), z(scalar) {}
+    vec(pack_type x_, pack_type y_, pack_type z_) noexcept : x(x_), y(y_), z(z_) {}
+
+    //NOTE: broadcast one vec3 into every lane
+    explicit vec(const vec<3, T>& v) noexcept : x(v.x), y(v.y), z(v.z) {}
+
+    //NOTE: loads lanes [0, W) from per-axis columns, e.g. SoaStorage::Field<&T::position>();
+    //      load() requires W * sizeof(T) alignment, loadu() does not
+    [[nodiscard]] static vec load(const T* xs, const T* ys, const T* zs) noexcept {
+        return {pack_type::load(xs), pack_type::load(ys), pack_type::load(zs)};
+    }
+
+    [[nodiscard]] static vec loadu(const T* xs, const T* ys, const T* zs) noexcept {
+        return {pack_type::loadu(xs), pack_type::loadu(ys), pack_type::loadu(zs)};
+    }
+
+    void store(T* xs, T* ys, T* zs) const noexcept {
+        x.store(xs);
+        y.store(ys);
+        z.store(zs);
+    }
+
+    void storeu(T* xs, T* ys, T* zs) const noexcept {
+        x.storeu(xs);
+        y.storeu(ys);
+        z.storeu(zs);
+    }
+
+    [[nodiscard]] vec<3, T> lane(std::size_t i) const noexcept {
+        assert(i < W);
+        return {x[i], y[i], z[i]};
+    }
+
+    [[nodiscard]] pack_type& operator[](std::size_t i) noexcept {
+        assert(i < 3);
+        return i == 0 ? x : (i == 1 ? y : z);
+    }
+
+    [[nodiscard]] const pack_type& operator[](std::size_t i) const noexcept {
+        assert(i < 3);
+        return i == 0 ? x : (i == 1 ? y : z);
+    }
+
+    vec& operator+=(const vec& other) noexcept {
+        x += other.x;
+        y += other.y;
+        z += other.z;
+        return *this;
+    }
+
+    vec& operator-=(const vec& other) noexcept {
+        x -= other.x;
+        y -= other.y;
+        z -= other.z;
+        return *this;
+    }
+
+    vec& operator*=(const vec& other) noexcept {
+        x *= other.x;
+        y *= other.y;
+        z *= other.z;
+        return *this;
+    }
+
+    vec& operator*=(pack_type scalar) noexcept {
+        x *= scalar;
+        y *= scalar;
+        z *= scalar;
+        return *this;
+    }
+
+    vec& operator/=(const vec& other) noexcept {
+        x /= other.x;
+        y /= other.y;
+        z /= other.z;
+        return *this;
+    }
+
+    vec& operator/=(pack_type scalar) noexcept {
+        x /= scalar;
+        y /= scalar;
+        z /= scalar;
+        return *this;
+    }
+
+    [[nodiscard]] friend vec operator+(const vec& a, const vec& b) noexcept {
+        return {a.x + b.x, a.y + b.y, a.z + b.z};
+    }
+
+    [[nodiscard]] friend vec operator-(const vec& a, const vec& b) noexcept {
+        return {a.x - b.x, a.y - b.y, a.z - b.z};
+    }
+
+    [[nodiscard]] friend vec operator*(const vec& a, const vec& b) noexcept {
+        return {a.x * b.x, a.y * b.y, a.z * b.z};
+    }
+
+    [[nodiscard]] friend vec operator*(const vec& v, pack_type scalar) noexcept {
+        return {v.x * scalar, v.y * scalar, v.z * scalar};
+    }
+
+    [[nodiscard]] friend vec operator*(pack_type scalar, const vec& v) noexcept {
+        return v * scalar;
+    }
+
+    [[nodiscard]] friend vec operator/(const vec& a, const vec& b) noexcept {
+        return {a.x / b.x, a.y / b.y, a.z / b.z};
+    }
+
+    [[nodiscard]] friend vec operator/(const vec& v, pack_type scalar) noexcept {
+        return {v.x / scalar, v.y / scalar, v.z / scalar};
+    }
+
+    [[nodiscard]] vec operator-() const noexcept {
+        return {-x, -y, -z};
+    }
+
+    [[nodiscard]] pack_type dot(const vec& other) const noexcept {
+        return fma(x, other.x, fma(y, other.y, z * other.z));
+    }
+
+    [[nodiscard]] vec cross(const vec& other) const noexcept {
+        return {
+            y * other.z - z * other.y,
+            z * other.x - x * other.z,
+            x * other.y - y * other.x
+        };
+    }
+
+    [[nodiscard]] pack_type length_squared() const noexcept {
+        return dot(*this);
+    }
+
+    [[nodiscard]] pack_type length() const noexcept {
+        return sqrt(length_squared());
+    }
+
+    //NOTE: zero-length lanes stay zero, matching vec<3, T>::normalized()
+    [[nodiscard]] vec normalized() const noexcept {
+        const pack_type l       = length();
+        const mask_type nonzero = l != pack_type{};
+        const pack_type inv     = select(nonzero, pack_type(T{1}) / l, pack_type{});
+        return *this * inv;
+    }
+
+    vec& normalize() noexcept {
+        *this = normalized();
+        return *this;
+    }
+
+    //NOTE: lane-wise approx_equal on every axis
+    [[nodiscard]] friend mask_type approx_equal(const vec& a, const vec& b,
+                                               pack_type tolerance = pack_type(epsilon<T>)) noexcept {
+        return abs(a.x - b.x) <= tolerance &&
+               abs(a.y - b.y) <= tolerance &&
+               abs(a.z - b.z) <= tolerance;
+    }
+
+    [[nodiscard]] friend vec select(const mask_type& m, const vec& a, const vec& b) noexcept {
+        return {select(m, a.x, b.x), select(m, a.y, b.y), select(m, a.z, b.z)};
+    }
+};
+
+} // namespace cc
@@ -4,6 +4,7 @@
 #include "vec2.hpp" // IWYU pragma: keep
 #include "vec3.hpp" // IWYU pragma: keep
 #include "../detail/arithmetic.hpp"
+#include "../detail/simd.hpp"
 #include "../common/functions.hpp"
 
 #include <array>
@@ -12,8 +13,10 @@
 
 namespace cc {
 
+//NOTE: aligned to its size so vec4f/vec4d load straight into SSE/AVX registers; constant
+//      evaluation always takes the scalar path.
 template<arithmetic T>
-class vec<4, T> {
+class alignas(4 * sizeof(T)) vec<4, T> {
 public:
     static constexpr std::size_t size = 4;
     using value_type = T;
@@ -56,6 +59,12 @@ public:
     }
 
     constexpr vec& operator+=(const vec& other) noexcept {
+        if !consteval {
+            if constexpr (detail::simd::has_x4<T>) {
+                detail::simd::add4(data(), other.data(), data());
+                return *this;
+            }
+        }
         x += other.x;
         y += other.y;
         z += other.z;
@@ -64,6 +73,12 @@ public:
     }
 
     constexpr vec& operator-=(const vec& other) noexcept {
+        if !consteval {
+            if constexpr (detail::simd::has_x4<T>) {
+                detail::simd::sub4(data(), other.data(), data());
+                return *this;
+            }
+        }
         x -= other.x;
         y -= other.y;
         z -= other.z;
@@ -72,6 +87,12 @@ public:
     }
 
     constexpr vec& operator*=(const vec& other) noexcept {
+        if !consteval {
+            if constexpr (detail::simd::has_x4<T>) {
+                detail::simd::mul4(data(), other.data(), data());
+                return *this;
+            }
+        }
         x *= other.x;
         y *= other.y;
         z *= other.z;
@@ -80,6 +101,12 @@ public:
     }
 
     constexpr vec& operator*=(T scalar) noexcept {
+        if !consteval {
+            if constexpr (detail::simd::has_x4<T>) {
+                detail::simd::scale4(data(), scalar, data());
+                return *this;
+            }
+        }
         x *= scalar;
         y *= scalar;
         z *= scalar;
@@ -89,6 +116,12 @@ public:
 
     constexpr vec& operator/=(const vec& other) noexcept {
         assert(other.x != T{} && other.y != T{} && other.z != T{} && other.w != T{});
+        if !consteval {
+            if constexpr (detail::simd::has_x4<T>) {
+                detail::simd::div4(data(), other.data(), data());
+                return *this;
+            }
+        }
         x /= other.x;
         y /= other.y;
         z /= other.z;
@@ -98,6 +131,12 @@ public:
 
     constexpr vec& operator/=(T scalar) noexcept {
         assert(scalar != T{});
+        if !consteval {
+            if constexpr (detail::simd::has_x4<T>) {
+                detail::simd::divs4(data(), scalar, data());
+                return *this;
+            }
+        }
         x /= scalar;
         y /= scalar;
         z /= scalar;
@@ -106,18 +145,46 @@ public:
     }
 
     [[nodiscard]] friend constexpr vec operator+(const vec& a, const vec& b) noexcept {
+        if !consteval {
+            if constexpr (detail::simd::has_x4<T>) {
+                vec result;
+                detail::simd::add4(a.data(), b.data(), result.data());
+                return result;
+            }
+        }
         return {a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w};
     }
 
     [[nodiscard]] friend constexpr vec operator-(const vec& a, const vec& b) noexcept {
+        if !consteval {
+            if constexpr (detail::simd::has_x4<T>) {
+                vec result;
+                detail::simd::sub4(a.data(), b.data(), result.data());
+                return result;
+            }
+        }
         return {a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w};
     }
 
     [[nodiscard]] friend constexpr vec operator*(const vec& a, const vec& b) noexcept {
+        if !consteval {
+            if constexpr (detail::simd::has_x4<T>) {
+                vec result;
+                detail::simd::mul4(a.data(), b.data(), result.data());
+                return result;
+            }
+        }
         return {a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w};
     }
 
     [[nodiscard]] friend constexpr vec operator*(const vec& v, T scalar) noexcept {
+        if !consteval {
+            if constexpr (detail::simd::has_x4<T>) {
+                vec result;
+                detail::simd::scale4(v.data(), scalar, result.data());
+                return result;
+            }
+        }
         return {v.x * scalar, v.y * scalar, v.z * scalar, v.w * scalar};
     }
 
@@ -127,11 +194,25 @@ public:
 
     [[nodiscard]] friend constexpr vec operator/(const vec& a, const vec& b) noexcept {
         assert(b.x != T{} && b.y != T{} && b.z != T{} && b.w != T{});
+        if !consteval {
+            if constexpr (detail::simd::has_x4<T>) {
+                vec result;
+                detail::simd::div4(a.data(), b.data(), result.data());
+                return result;
+            }
+        }
         return {a.x / b.x, a.y / b.y, a.z / b.z, a.w / b.w};
     }
 
     [[nodiscard]] friend constexpr vec operator/(const vec& v, T scalar) noexcept {
         assert(scalar != T{});
+        if !consteval {
+            if constexpr (detail::simd::has_x4<T>) {
+                vec result;
+                detail::simd::divs4(v.data(), scalar, result.data());
+                return result;
+            }
+        }
         return {v.x / scalar, v.y / scalar, v.z / scalar, v.w / scalar};
     }
 
@@ -157,6 +238,11 @@ public:
     }
 
     [[nodiscard]] constexpr T dot(const vec& other) const noexcept {
+        if !consteval {
+            if constexpr (detail::simd::has_x4<T>) {
+                return detail::simd::dot4(data(), other.data());
+            }
+        }
         return x * other.x + y * other.y + z * other.z + w * other.w;
     }
 
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "../vec/base.hpp"
+#include "../vec/vec2.hpp"              // IWYU pragma: keep
+#include "../vec/vec3.hpp"              // IWYU pragma: keep
+#include "../mat/base.hpp"
+#include "../mat/mat3.hpp"              // IWYU pragma: keep
+#include "../mat/mat4.hpp"              // IWYU pragma: keep
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+//NOTE: Two-view and camera-pose estimation: direct solvers for homographies, fundamental and
+//      essential matrices and camera poses (PnP), and RANSAC drivers that find them among
+//      outliers. The solvers work in double on Hartley-normalized coordinates and return
+//      std::nullopt for too few or degenerate correspondences; the drivers score hypotheses
+//      with the cc::batch SIMD kernels and spread iterations across threads.
+//
+//      Essential matrices and poses take normalized image coordinates, i.e. pixels with the
+//      camera intrinsics removed (K^-1 * (u, v, 1)); their thresholds are in the same units,
+//      roughly pixels / focal length.
+namespace cc::vision {
+
+//NOTE: dst ~ h * (src, 1); at least 4 correspondences, least squares beyond that. h(2, 2) is 1
+//      unless it vanishes. std::nullopt when either point set is collinear or h is singular
+[[nodiscard]] std::optional<mat<3, 3, float>> homography(std::span<const vec<2, float>> src,
+                                                         std::span<const vec<2, float>> dst) noexcept;
+
+//NOTE: (dst, 1)^T * f * (src, 1) = 0; at least 8 correspondences, f has rank 2 and unit
+//      Frobenius norm
+[[nodiscard]] std::optional<mat<3, 3, float>> fundamental(std::span<const vec<2, float>> src,
+                                                          std::span<const vec<2, float>> dst) noexcept;
+
+//NOTE: as fundamental() on normalized image coordinates; e has two equal singular values and
+//      unit Frobenius norm, i.e. singular values (sqrt(1/2), sqrt(1/2), 0)
+[[nodiscard]] std::optional<mat<3, 3, float>> essential(std::span<const vec<2, float>> src,
+                                                        std::span<const vec<2, float>> dst) noexcept;
+
+//NOTE: camera-from-world rigid transform from at least 6 world points and their normalized
+//      image coordinates (DLT, rotation recovered with cc::svd); the camera looks down +z
+[[nodiscard]] std::optional<mat<4, 4, float>> pose(std::span<const vec<3, float>> world,
+                                                   std::span<const vec<2, float>> image) noexcept;
+
+struct ransac_params {
+    //NOTE: inlier bound: transfer error for homographies, Sampson distance for fundamental and
+    //      essential matrices, reprojection error for poses
+    float threshold{1.0f};
+    //NOTE: stop once an all-inlier sample has been drawn with this probability
+    float confidence{0.999f};
+    std::uint32_t max_iterations{10000};
+    std::uint64_t seed{0x853c49e6748fea9bull};
+    //NOTE: iterations are split across this many threads; 0 uses std::thread::hardware_concurrency()
+    std::uint32_t threads{0};
+    //NOTE: re-estimate the winner from all its inliers with the direct solver and rescore,
+    //      repeated until the inlier set stops changing
+    bool refine{true};
+};
+
+template<typename Model>
+struct ransac_result {
+    Model model;
+    std::size_t inliers;
+    std::uint32_t iterations;
+};
+
+//NOTE: inliers, when given, needs (n + 63) / 64 words and gets bit i set for each inlier of the
+//      returned model. std::nullopt when there are fewer correspondences than a sample needs or
+//      no sample produced a model
+[[nodiscard]] std::optional<ransac_result<mat<3, 3, float>>> find_homography(std::span<const vec<2, float>> src,
+                                                                             std::span<const vec<2, float>> dst,
+                                                                             const ransac_params& params = {},
+                                                                             std::span<std::uint64_t> inliers = {});
+
+[[nodiscard]] std::optional<ransac_result<mat<3, 3, float>>> find_fundamental(std::span<const vec<2, float>> src,
+                                                                              std::span<const vec<2, float>> dst,
+                                                                              const ransac_params& params = {},
+                                                                              std::span<std::uint64_t> inliers = {});
+
+[[nodiscard]] std::optional<ransac_result<mat<3, 3, float>>> find_essential(std::span<const vec<2, float>> src,
+                                                                            std::span<const vec<2, float>> dst,
+                                                                            const ransac_params& params = {},
+                                                                            std::span<std::uint64_t> inliers = {});
+
+[[nodiscard]] std::optional<ransac_result<mat<4, 4, float>>> find_pose(std::span<const vec<3, float>> world,
+                                                                       std::span<const vec<2, float>> image,
+                                                                       const ransac_params& params = {},
+                                                                       std::span<std::uint64_t> inliers = {});
+
+} // namespace cc::vision
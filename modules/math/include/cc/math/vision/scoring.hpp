@@ -0,0 +1,60 @@
+#pragma once
+
+//NOTE: Inlier tests for robust estimation, written once for any lane type (see
+//      cc/math/detail/lane.hpp) and shared by the header code and the SSE and AVX2 kernel TUs,
+//      so this header must not include the other math headers. Models are packed column-major
+//      floats: 3x3 for homographies and fundamental matrices, 3x4 for projections. Errors are
+//      compared squared and cross-multiplied, so there is no division and a point at infinity
+//      (w = 0) simply fails.
+namespace cc::vision::detail {
+
+//NOTE: one-way transfer error |d - h(s)| <= threshold, with h(s) the dehomogenized h * (s, 1)
+template<typename L>
+[[nodiscard]] inline typename L::m homography_inlier(const float* h,
+                                                      typename L::f sx, typename L::f sy,
+                                                      typename L::f dx, typename L::f dy,
+                                                      typename L::f threshold2) noexcept {
+    using f = typename L::f;
+    const f x = f(h[0]) * sx + f(h[3]) * sy + f(h[6]);
+    const f y = f(h[1]) * sx + f(h[4]) * sy + f(h[7]);
+    const f w = f(h[2]) * sx + f(h[5]) * sy + f(h[8]);
+    const f ex = x - dx * w;
+    const f ey = y - dy * w;
+    return L::ge(threshold2 * w * w, ex * ex + ey * ey);
+}
+
+//NOTE: Sampson distance of (s, d) to the epipolar geometry d^T * f * s = 0, the first-order
+//      approximation of the reprojection error
+template<typename L>
+[[nodiscard]] inline typename L::m epipolar_inlier(const float* e,
+                                                    typename L::f sx, typename L::f sy,
+                                                    typename L::f dx, typename L::f dy,
+                                                    typename L::f threshold2) noexcept {
+    using f = typename L::f;
+    //NOTE: f * s and f^T * d
+    const f a0 = f(e[0]) * sx + f(e[3]) * sy + f(e[6]);
+    const f a1 = f(e[1]) * sx + f(e[4]) * sy + f(e[7]);
+    const f a2 = f(e[2]) * sx + f(e[5]) * sy + f(e[8]);
+    const f b0 = f(e[0]) * dx + f(e[1]) * dy + f(e[2]);
+    const f b1 = f(e[3]) * dx + f(e[4]) * dy + f(e[5]);
+    const f r = dx * a0 + dy * a1 + a2;
+    return L::ge(threshold2 * (a0 * a0 + a1 * a1 + b0 * b0 + b1 * b1), r * r);
+}
+
+//NOTE: reprojection error of world point (x, y, z) through p against image point (u, v);
+//      points behind the camera are outliers
+template<typename L>
+[[nodiscard]] inline typename L::m projection_inlier(const float* p,
+                                                      typename L::f x, typename L::f y, typename L::f z,
+                                                      typename L::f u, typename L::f v,
+                                                      typename L::f threshold2) noexcept {
+    using f = typename L::f;
+    const f px = f(p[0]) * x + f(p[3]) * y + f(p[6]) * z + f(p[9]);
+    const f py = f(p[1]) * x + f(p[4]) * y + f(p[7]) * z + f(p[10]);
+    const f pw = f(p[2]) * x + f(p[5]) * y + f(p[8]) * z + f(p[11]);
+    const f eu = px - u * pw;
+    const f ev = py - v * pw;
+    return L::mask_and(L::gt(pw, f(0.0f)), L::ge(threshold2 * pw * pw, eu * eu + ev * ev));
+}
+
+} // namespace cc::vision::detail
@@ -0,0 +1,270 @@
+#include "batch/batch.hpp"
+#include "kernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <immintrin.h>
+    #include <intrin.h>
+#endif
+
+namespace cc::batch {
+
+namespace {
+
+[[nodiscard]] bool cpu_has_avx2_fma() noexcept {
+#if defined(CC_MATH_NO_SIMD)
+    return false;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4]{};
+    __cpuid(info, 1);
+    const bool fma     = (info[2] & (1 << 12)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx     = (info[2] & (1 << 28)) != 0;
+    if (!fma || !osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+[[nodiscard]] const detail::kernel_table& select_kernels() noexcept {
+    if (const auto* avx2 = detail::avx2_kernels(); avx2 && cpu_has_avx2_fma()) {
+        return *avx2;
+    }
+    if (const auto* sse = detail::sse_kernels()) {
+        return *sse;
+    }
+    return detail::scalar_kernels();
+}
+
+[[nodiscard]] const detail::kernel_table& kernels() noexcept {
+    static const detail::kernel_table& table = select_kernels();
+    return table;
+}
+
+//NOTE: the kernels read vec3f as packed xyz triples and mat3f / mat4f as 9 / 16 column-major
+//      floats
+static_assert(sizeof(vec<3, float>) == 3 * sizeof(float));
+static_assert(sizeof(mat<3, 3, float>) == 9 * sizeof(float));
+static_assert(sizeof(mat<4, 4, float>) == 16 * sizeof(float));
+static_assert(sizeof(quat<float>) == 4 * sizeof(float));
+static_assert(sizeof(std::array<half, 4>) == 4 * sizeof(std::uint16_t));
+static_assert(sizeof(std::array<std::int16_t, 4>) == 4 * sizeof(std::uint16_t));
+
+template<typename T>
+[[nodiscard]] const float* floats(std::span<const T> s) noexcept {
+    return reinterpret_cast<const float*>(s.data());
+}
+
+template<typename T>
+[[nodiscard]] float* floats(std::span<T> s) noexcept {
+    return reinterpret_cast<float*>(s.data());
+}
+
+[[nodiscard]] std::array<float, 24> pack_planes(const frustum<float>& f) noexcept {
+    std::array<float, 24> packed{};
+    for (std::size_t p = 0; p < 6; ++p) {
+        packed[p * 4]     = f.planes[p].normal.x;
+        packed[p * 4 + 1] = f.planes[p].normal.y;
+        packed[p * 4 + 2] = f.planes[p].normal.z;
+        packed[p * 4 + 3] = f.planes[p].d;
+    }
+    return packed;
+}
+
+[[nodiscard]] std::span<std::uint64_t> clear_bits(std::span<std::uint64_t> visible, std::size_t n) noexcept {
+    assert(visible.size() * 64 >= n);
+    const auto words = visible.first((n + 63) / 64);
+    std::fill(words.begin(), words.end(), std::uint64_t{0});
+    return words;
+}
+
+} // namespace
+
+namespace detail {
+
+const kernel_table& active_kernels() noexcept {
+    return kernels();
+}
+
+} // namespace detail
+
+void transform_points(const mat<4, 4, float>& m,
+                      std::span<const vec<3, float>> in,
+                      std::span<vec<3, float>> out) noexcept {
+    assert(in.size() == out.size());
+    kernels().transform3(m.data(), floats(in), floats(out), in.size(), 1.0f);
+}
+
+void transform_vectors(const mat<4, 4, float>& m,
+                       std::span<const vec<3, float>> in,
+                       std::span<vec<3, float>> out) noexcept {
+    assert(in.size() == out.size());
+    kernels().transform3(m.data(), floats(in), floats(out), in.size(), 0.0f);
+}
+
+void multiply_matrices(std::span<const mat<4, 4, float>> a,
+                       std::span<const mat<4, 4, float>> b,
+                       std::span<mat<4, 4, float>> out) noexcept {
+    assert(a.size() == b.size() && a.size() == out.size());
+    kernels().multiply4x4(floats(a), floats(b), floats(out), a.size());
+}
+
+void normalize_many(std::span<const vec<3, float>> in,
+                    std::span<vec<3, float>> out) noexcept {
+    assert(in.size() == out.size());
+    kernels().normalize3(floats(in), floats(out), in.size());
+}
+
+void normalize_many(std::span<vec<3, float>> values) noexcept {
+    normalize_many(std::span<const vec<3, float>>(values), values);
+}
+
+std::size_t cull_spheres(const frustum<float>& f,
+                         std::span<const float> x,
+                         std::span<const float> y,
+                         std::span<const float> z,
+                         std::span<const float> radius,
+                         std::span<std::uint64_t> visible) noexcept {
+    const std::size_t n = x.size();
+    assert(y.size() == n && z.size() == n && radius.size() == n);
+    const auto planes = pack_planes(f);
+    const auto words  = clear_bits(visible, n);
+    return kernels().cull_spheres(planes.data(), x.data(), y.data(), z.data(), radius.data(), n, words.data());
+}
+
+std::size_t cull_aabbs(const frustum<float>& f,
+                       std::span<const float> cx,
+                       std::span<const float> cy,
+                       std::span<const float> cz,
+                       std::span<const float> ex,
+                       std::span<const float> ey,
+                       std::span<const float> ez,
+                       std::span<std::uint64_t> visible) noexcept {
+    const std::size_t n = cx.size();
+    assert(cy.size() == n && cz.size() == n && ex.size() == n && ey.size() == n && ez.size() == n);
+    const auto planes = pack_planes(f);
+    const auto words  = clear_bits(visible, n);
+    return kernels().cull_aabbs(planes.data(), cx.data(), cy.data(), cz.data(),
+                                ex.data(), ey.data(), ez.data(), n, words.data());
+}
+
+void slerp_many(std::span<const quat<float>> a,
+                std::span<const quat<float>> b,
+                float t,
+                std::span<quat<float>> out) noexcept {
+    assert(a.size() == b.size() && a.size() == out.size());
+    kernels().slerp_quat(floats(a), floats(b), &t, 0, floats(out), a.size());
+}
+
+void slerp_many(std::span<const quat<float>> a,
+                std::span<const quat<float>> b,
+                std::span<const float> t,
+                std::span<quat<float>> out) noexcept {
+    assert(a.size() == b.size() && a.size() == t.size() && a.size() == out.size());
+    kernels().slerp_quat(floats(a), floats(b), t.data(), 1, floats(out), a.size());
+}
+
+void nlerp_many(std::span<const quat<float>> a,
+                std::span<const quat<float>> b,
+                float t,
+                std::span<quat<float>> out) noexcept {
+    assert(a.size() == b.size() && a.size() == out.size());
+    kernels().nlerp_quat(floats(a), floats(b), &t, 0, floats(out), a.size());
+}
+
+void nlerp_many(std::span<const quat<float>> a,
+                std::span<const quat<float>> b,
+                std::span<const float> t,
+                std::span<quat<float>> out) noexcept {
+    assert(a.size() == b.size() && a.size() == t.size() && a.size() == out.size());
+    kernels().nlerp_quat(floats(a), floats(b), t.data(), 1, floats(out), a.size());
+}
+
+void rotate_many(const quat<float>& q,
+                 std::span<const vec<3, float>> in,
+                 std::span<vec<3, float>> out) noexcept {
+    assert(in.size() == out.size());
+    const float packed[4] = {q.x, q.y, q.z, q.w};
+    kernels().rotate3(packed, 0, floats(in), floats(out), in.size());
+}
+
+void rotate_many(std::span<const quat<float>> q,
+                 std::span<const vec<3, float>> in,
+                 std::span<vec<3, float>> out) noexcept {
+    assert(q.size() == in.size() && in.size() == out.size());
+    kernels().rotate3(floats(q), 1, floats(in), floats(out), in.size());
+}
+
+void quats_to_matrices(std::span<const quat<float>> q,
+                       std::span<mat<4, 4, float>> out) noexcept {
+    assert(q.size() == out.size());
+    kernels().quat_to_mat4(floats(q), floats(out), q.size());
+}
+
+void pack_half4(std::span<const vec<3, float>> in,
+                std::span<std::array<half, 4>> out) noexcept {
+    assert(in.size() == out.size());
+    kernels().pack_half4(floats(in), reinterpret_cast<std::uint16_t*>(out.data()), in.size());
+}
+
+void pack_snorm16x4(std::span<const vec<3, float>> in,
+                    std::span<std::array<std::int16_t, 4>> out) noexcept {
+    assert(in.size() == out.size());
+    kernels().pack_snorm16x4(floats(in), reinterpret_cast<std::uint16_t*>(out.data()), in.size());
+}
+
+void pack_unorm8x4(std::span<const vec<3, float>> in,
+                   std::span<std::uint32_t> out) noexcept {
+    assert(in.size() == out.size());
+    kernels().pack_unorm8x4(floats(in), out.data(), in.size());
+}
+
+void pack_snorm10_10_10_2(std::span<const vec<3, float>> in,
+                          std::span<std::uint32_t> out) noexcept {
+    assert(in.size() == out.size());
+    kernels().pack_snorm10x3(floats(in), out.data(), in.size());
+}
+
+void pack_oct_snorm16(std::span<const vec<3, float>> normals,
+                      std::span<std::uint32_t> out) noexcept {
+    assert(normals.size() == out.size());
+    kernels().pack_oct16(floats(normals), out.data(), normals.size());
+}
+
+void svd_many(std::span<const mat<3, 3, float>> m,
+              std::span<mat<3, 3, float>> u,
+              std::span<vec<3, float>> s,
+              std::span<mat<3, 3, float>> v) noexcept {
+    assert(m.size() == u.size() && m.size() == s.size() && m.size() == v.size());
+    kernels().svd3(floats(m), floats(u), floats(s), floats(v), m.size());
+}
+
+void eigen_symmetric_many(std::span<const mat<3, 3, float>> m,
+                          std::span<vec<3, float>> values,
+                          std::span<mat<3, 3, float>> vectors) noexcept {
+    assert(m.size() == values.size() && m.size() == vectors.size());
+    kernels().eigen3(floats(m), floats(values), floats(vectors), m.size());
+}
+
+void polar_many(std::span<const mat<3, 3, float>> m,
+                std::span<mat<3, 3, float>> r,
+                std::span<mat<3, 3, float>> s) noexcept {
+    assert(m.size() == r.size() && m.size() == s.size());
+    kernels().polar3(floats(m), floats(r), floats(s), m.size());
+}
+
+std::string_view active_isa() noexcept {
+    return kernels().name;
+}
+
+} // namespace cc::batch
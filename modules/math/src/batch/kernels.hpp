@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+//NOTE: Raw-pointer kernel tables behind cc::batch. Each table lives in its own TU compiled with
+//      the matching ISA flags. Those TUs include the lane-generic math headers (noise/lattice,
+//      mat/jacobi3, random/sampling, vision/scoring, packing), but their lane types live in
+//      anonymous namespaces, so every template instantiated on them has internal linkage. What
+//      must not happen is an ISA TU calling a non-template inline function of those headers, or
+//      instantiating one of their templates on a scalar type: the linker keeps one weak copy for
+//      the whole program, possibly the AVX2 one. Scalar work, tails included, goes through
+//      scalar_kernels(). After adding a kernel, check `nm -C` on an -O0 build of kernels_avx2.cpp
+//      for new weak (W/V/u) symbols; today there are only std::min<unsigned long>, slerp_u/slerp_v
+//      and the personality routine reference.
+namespace cc::noise::detail {
+struct fbm_desc;
+} // namespace cc::noise::detail
+
+namespace cc::batch::detail {
+
+struct kernel_table {
+    const char* name;
+
+    //NOTE: in/out are packed xyz triples; w is 1 for points and 0 for vectors
+    void (*transform3)(const float* m, const float* in, float* out, std::size_t n, float w) noexcept;
+    void (*multiply4x4)(const float* a, const float* b, float* out, std::size_t n) noexcept;
+    void (*normalize3)(const float* in, float* out, std::size_t n) noexcept;
+
+    //NOTE: planes are 6 normalized (a, b, c, d) quadruples; visible gets bit i set for each
+    //      element that passes, words must be zeroed by the caller; returns the visible count
+    std::size_t (*cull_spheres)(const float* planes, const float* x, const float* y, const float* z,
+                                const float* r, std::size_t n, std::uint64_t* visible) noexcept;
+    std::size_t (*cull_aabbs)(const float* planes, const float* cx, const float* cy, const float* cz,
+                              const float* ex, const float* ey, const float* ez, std::size_t n,
+                              std::uint64_t* visible) noexcept;
+
+    //NOTE: quaternions are packed xyzw; t holds one weight per element, or a single weight for
+    //      all of them when t_step is 0
+    void (*slerp_quat)(const float* a, const float* b, const float* t, std::size_t t_step,
+                       float* out, std::size_t n) noexcept;
+    void (*nlerp_quat)(const float* a, const float* b, const float* t, std::size_t t_step,
+                       float* out, std::size_t n) noexcept;
+
+    //NOTE: unit quaternions applied to packed xyz triples; q_step 0 uses q for every element
+    void (*rotate3)(const float* q, std::size_t q_step, const float* in, float* out, std::size_t n) noexcept;
+    void (*quat_to_mat4)(const float* q, float* out, std::size_t n) noexcept;
+
+    //NOTE: vertex attribute packing of xyz triples, bit-exact with cc/math/packing/packing.hpp.
+    //      4-wide outputs get w = 0, except unorm8x4 whose alpha is 1; snorm10x3 leaves w = 0
+    void (*pack_half4)(const float* in, std::uint16_t* out, std::size_t n) noexcept;
+    void (*pack_snorm16x4)(const float* in, std::uint16_t* out, std::size_t n) noexcept;
+    void (*pack_unorm8x4)(const float* in, std::uint32_t* out, std::size_t n) noexcept;
+    void (*pack_snorm10x3)(const float* in, std::uint32_t* out, std::size_t n) noexcept;
+    void (*pack_oct16)(const float* in, std::uint32_t* out, std::size_t n) noexcept;
+
+    //NOTE: out[i] = fbm at (x0 + i * dx, y, z, 0) for the kernels in cc/math/noise/lattice.hpp
+    void (*noise_row)(const noise::detail::fbm_desc& desc, float x0, float dx, float y, float z,
+                      float* out, std::size_t n) noexcept;
+
+    //NOTE: state is the 32-word SoA state of cc::random::xoshiro256pp_x8; values are mapped as
+    //      in cc/math/random/sampling.hpp and a partial last step is generated in full. Uniform
+    //      and Gaussian fills take 16 values per step, unit3 takes 8 packed xyz triples.
+    void (*random_uniform)(std::uint64_t* state, float* out, std::size_t n, float lo, float scale) noexcept;
+    void (*random_unit3)(std::uint64_t* state, float* out, std::size_t n) noexcept;
+    void (*random_gaussian)(std::uint64_t* state, float* out, std::size_t n, float mean, float stddev) noexcept;
+
+    //NOTE: packed column-major 3x3 matrices decomposed as in cc/math/mat/jacobi3.hpp; s and
+    //      values are packed triples
+    void (*svd3)(const float* in, float* u, float* s, float* v, std::size_t n) noexcept;
+    void (*eigen3)(const float* in, float* values, float* vectors, std::size_t n) noexcept;
+    void (*polar3)(const float* in, float* r, float* s, std::size_t n) noexcept;
+
+    //NOTE: inlier tests of cc/math/vision/scoring.hpp over SoA correspondences (s, d) or world
+    //      and image points (x, y, z, u, v); threshold2 is the squared error bound. inliers, when
+    //      not null, gets bit i set for each inlier (words zeroed by the caller); returns the
+    //      inlier count
+    std::size_t (*score_homography)(const float* h, const float* sx, const float* sy, const float* dx,
+                                    const float* dy, std::size_t n, float threshold2,
+                                    std::uint64_t* inliers) noexcept;
+    std::size_t (*score_epipolar)(const float* f, const float* sx, const float* sy, const float* dx,
+                                  const float* dy, std::size_t n, float threshold2,
+                                  std::uint64_t* inliers) noexcept;
+    std::size_t (*score_projection)(const float* p, const float* x, const float* y, const float* z,
+                                    const float* u, const float* v, std::size_t n, float threshold2,
+                                    std::uint64_t* inliers) noexcept;
+};
+
+//NOTE: Eberly, "A Fast and Accurate Algorithm for Computing SLERP": sin(t * theta) / sin(theta)
+//      as a polynomial in t and cos(theta) - 1, no trig or division. The last term is scaled by
+//      mu to absorb the truncation error; weights stay within 2e-5 of the exact ones.
+inline constexpr float slerp_mu = 1.85298109240830f;
+inline constexpr float slerp_u[8] = {
+    1.0f / (1 * 3), 1.0f / (2 * 5), 1.0f / (3 * 7), 1.0f / (4 * 9),
+    1.0f / (5 * 11), 1.0f / (6 * 13), 1.0f / (7 * 15), slerp_mu / (8 * 17),
+};
+inline constexpr float slerp_v[8] = {
+    1.0f / 3, 2.0f / 5, 3.0f / 7, 4.0f / 9,
+    5.0f / 11, 6.0f / 13, 7.0f / 15, slerp_mu * 8 / 17,
+};
+
+[[nodiscard]] const kernel_table& scalar_kernels() noexcept;
+
+//NOTE: nullptr when the TU was not built for the ISA (non-x86 targets, CC_MATH_NO_SIMD)
+[[nodiscard]] const kernel_table* sse_kernels() noexcept;
+[[nodiscard]] const kernel_table* avx2_kernels() noexcept;
+
+//NOTE: the table cc::batch dispatches to, picked once from the CPU features
+[[nodiscard]] const kernel_table& active_kernels() noexcept;
+
+} // namespace cc::batch::detail
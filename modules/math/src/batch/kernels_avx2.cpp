@@ -0,0 +1,891 @@
+#include "kernels.hpp"
+#include "packing.hpp"
+#include "mat/jacobi3.hpp"
+#include "noise/lattice.hpp"
+#include "random/sampling.hpp"
+#include "vision/scoring.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+//NOTE: built with -mavx2 -mfma (/arch:AVX2) on x86; only reached after the runtime CPU check
+#if !defined(CC_MATH_NO_SIMD) && defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+    #define CC_BATCH_AVX2 1
+    #include <immintrin.h>
+#endif
+
+namespace cc::batch::detail {
+
+#if defined(CC_BATCH_AVX2)
+
+namespace {
+
+[[nodiscard]] inline __m256 load2x4(const float* lo, const float* hi) noexcept {
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(lo)), _mm_loadu_ps(hi), 1);
+}
+
+inline void store2x4(float* lo, float* hi, __m256 v) noexcept {
+    _mm_storeu_ps(lo, _mm256_castps256_ps128(v));
+    _mm_storeu_ps(hi, _mm256_extractf128_ps(v, 1));
+}
+
+//NOTE: 8 packed xyz triples <-> x, y, z registers; each 128-bit lane holds 4 points and is
+//      shuffled exactly like the SSE kernel
+inline void load_xyz8(const float* p, __m256& x, __m256& y, __m256& z) noexcept {
+    const __m256 a  = load2x4(p, p + 12);
+    const __m256 b  = load2x4(p + 4, p + 16);
+    const __m256 c  = load2x4(p + 8, p + 20);
+    const __m256 xy = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+    const __m256 yz = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+    x = _mm256_shuffle_ps(a, xy, _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+    z = _mm256_shuffle_ps(yz, c, _MM_SHUFFLE(3, 0, 3, 1));
+}
+
+inline void store_xyz8(float* p, __m256 x, __m256 y, __m256 z) noexcept {
+    const __m256 xy = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m256 yz = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+    const __m256 zx = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+    store2x4(p,     p + 12, _mm256_shuffle_ps(xy, zx, _MM_SHUFFLE(2, 0, 2, 0)));
+    store2x4(p + 4, p + 16, _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0)));
+    store2x4(p + 8, p + 20, _mm256_shuffle_ps(zx, yz, _MM_SHUFFLE(3, 1, 3, 1)));
+}
+
+void transform3(const float* m, const float* in, float* out, std::size_t n, float w) noexcept {
+    const __m256 m00 = _mm256_set1_ps(m[0]), m01 = _mm256_set1_ps(m[4]), m02 = _mm256_set1_ps(m[8]);
+    const __m256 m10 = _mm256_set1_ps(m[1]), m11 = _mm256_set1_ps(m[5]), m12 = _mm256_set1_ps(m[9]);
+    const __m256 m20 = _mm256_set1_ps(m[2]), m21 = _mm256_set1_ps(m[6]), m22 = _mm256_set1_ps(m[10]);
+    const __m256 t0  = _mm256_set1_ps(m[12] * w);
+    const __m256 t1  = _mm256_set1_ps(m[13] * w);
+    const __m256 t2  = _mm256_set1_ps(m[14] * w);
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x, y, z;
+        load_xyz8(in + i * 3, x, y, z);
+        const __m256 rx = _mm256_fmadd_ps(m00, x, _mm256_fmadd_ps(m01, y, _mm256_fmadd_ps(m02, z, t0)));
+        const __m256 ry = _mm256_fmadd_ps(m10, x, _mm256_fmadd_ps(m11, y, _mm256_fmadd_ps(m12, z, t1)));
+        const __m256 rz = _mm256_fmadd_ps(m20, x, _mm256_fmadd_ps(m21, y, _mm256_fmadd_ps(m22, z, t2)));
+        store_xyz8(out + i * 3, rx, ry, rz);
+    }
+    if (i < n) {
+        scalar_kernels().transform3(m, in + i * 3, out + i * 3, n - i, w);
+    }
+}
+
+//NOTE: two output columns per register: lane k of b01 is broadcast within each half and
+//      multiplied by column k of a duplicated into both halves
+void multiply4x4(const float* a, const float* b, float* out, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i, a += 16, b += 16, out += 16) {
+        const __m256 a0  = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a));
+        const __m256 a1  = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 4));
+        const __m256 a2  = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 8));
+        const __m256 a3  = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 12));
+        const __m256 b01 = _mm256_loadu_ps(b);
+        const __m256 b23 = _mm256_loadu_ps(b + 8);
+
+        __m256 r01 = _mm256_mul_ps(a0, _mm256_permute_ps(b01, 0x00));
+        __m256 r23 = _mm256_mul_ps(a0, _mm256_permute_ps(b23, 0x00));
+        r01 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b01, 0x55), r01);
+        r23 = _mm256_fmadd_ps(a1, _mm256_permute_ps(b23, 0x55), r23);
+        r01 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b01, 0xAA), r01);
+        r23 = _mm256_fmadd_ps(a2, _mm256_permute_ps(b23, 0xAA), r23);
+        r01 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b01, 0xFF), r01);
+        r23 = _mm256_fmadd_ps(a3, _mm256_permute_ps(b23, 0xFF), r23);
+
+        _mm256_storeu_ps(out, r01);
+        _mm256_storeu_ps(out + 8, r23);
+    }
+}
+
+void normalize3(const float* in, float* out, std::size_t n) noexcept {
+    const __m256 zero = _mm256_setzero_ps();
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x, y, z;
+        load_xyz8(in + i * 3, x, y, z);
+        const __m256 l2   = _mm256_fmadd_ps(x, x, _mm256_fmadd_ps(y, y, _mm256_mul_ps(z, z)));
+        const __m256 l    = _mm256_sqrt_ps(l2);
+        const __m256 mask = _mm256_cmp_ps(l2, zero, _CMP_GT_OQ);
+        store_xyz8(out + i * 3,
+                   _mm256_and_ps(_mm256_div_ps(x, l), mask),
+                   _mm256_and_ps(_mm256_div_ps(y, l), mask),
+                   _mm256_and_ps(_mm256_div_ps(z, l), mask));
+    }
+    if (i < n) {
+        scalar_kernels().normalize3(in + i * 3, out + i * 3, n - i);
+    }
+}
+
+//NOTE: sets the 8 bits of elements [i, i + 8) from a lane mask, i is a multiple of 8. Counts
+//      with the intrinsic rather than std::popcount so no std template is instantiated with
+//      AVX2 codegen in this TU.
+inline std::size_t store_bits(__m256 inside, std::size_t i, std::uint64_t* visible) noexcept {
+    const auto bits = static_cast<std::uint64_t>(_mm256_movemask_ps(inside));
+    visible[i / 64] |= bits << (i % 64);
+    return static_cast<std::size_t>(_mm_popcnt_u32(static_cast<unsigned>(bits)));
+}
+
+inline void merge_tail(std::uint64_t tail, std::size_t i, std::uint64_t* visible) noexcept {
+    visible[i / 64] |= tail << (i % 64);
+}
+
+std::size_t cull_spheres(const float* planes, const float* x, const float* y, const float* z,
+                         const float* r, std::size_t n, std::uint64_t* visible) noexcept {
+    __m256 pa[6], pb[6], pc[6], pd[6];
+    for (int p = 0; p < 6; ++p) {
+        pa[p] = _mm256_set1_ps(planes[p * 4]);
+        pb[p] = _mm256_set1_ps(planes[p * 4 + 1]);
+        pc[p] = _mm256_set1_ps(planes[p * 4 + 2]);
+        pd[p] = _mm256_set1_ps(planes[p * 4 + 3]);
+    }
+
+    std::size_t count = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256 px = _mm256_loadu_ps(x + i);
+        const __m256 py = _mm256_loadu_ps(y + i);
+        const __m256 pz = _mm256_loadu_ps(z + i);
+        const __m256 nr = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(r + i));
+
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p) {
+            const __m256 dist = _mm256_fmadd_ps(pa[p], px, _mm256_fmadd_ps(pb[p], py, _mm256_fmadd_ps(pc[p], pz, pd[p])));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(dist, nr, _CMP_GE_OQ));
+        }
+        count += store_bits(inside, i, visible);
+    }
+    if (i < n) {
+        std::uint64_t tail = 0;
+        count += scalar_kernels().cull_spheres(planes, x + i, y + i, z + i, r + i, n - i, &tail);
+        merge_tail(tail, i, visible);
+    }
+    return count;
+}
+
+std::size_t cull_aabbs(const float* planes, const float* cx, const float* cy, const float* cz,
+                       const float* ex, const float* ey, const float* ez, std::size_t n,
+                       std::uint64_t* visible) noexcept {
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    __m256 pa[6], pb[6], pc[6], pd[6], aa[6], ab[6], ac[6];
+    for (int p = 0; p < 6; ++p) {
+        pa[p] = _mm256_set1_ps(planes[p * 4]);
+        pb[p] = _mm256_set1_ps(planes[p * 4 + 1]);
+        pc[p] = _mm256_set1_ps(planes[p * 4 + 2]);
+        pd[p] = _mm256_set1_ps(planes[p * 4 + 3]);
+        aa[p] = _mm256_andnot_ps(sign, pa[p]);
+        ab[p] = _mm256_andnot_ps(sign, pb[p]);
+        ac[p] = _mm256_andnot_ps(sign, pc[p]);
+    }
+
+    std::size_t count = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256 px = _mm256_loadu_ps(cx + i);
+        const __m256 py = _mm256_loadu_ps(cy + i);
+        const __m256 pz = _mm256_loadu_ps(cz + i);
+        const __m256 qx = _mm256_loadu_ps(ex + i);
+        const __m256 qy = _mm256_loadu_ps(ey + i);
+        const __m256 qz = _mm256_loadu_ps(ez + i);
+
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p) {
+            //NOTE: dist + |n| . extents >= 0
+            __m256 d = _mm256_fmadd_ps(pa[p], px, _mm256_fmadd_ps(pb[p], py, _mm256_fmadd_ps(pc[p], pz, pd[p])));
+            d = _mm256_fmadd_ps(aa[p], qx, _mm256_fmadd_ps(ab[p], qy, _mm256_fmadd_ps(ac[p], qz, d)));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+        count += store_bits(inside, i, visible);
+    }
+    if (i < n) {
+        std::uint64_t tail = 0;
+        count += scalar_kernels().cull_aabbs(planes, cx + i, cy + i, cz + i, ex + i, ey + i, ez + i, n - i, &tail);
+        merge_tail(tail, i, visible);
+    }
+    return count;
+}
+
+//NOTE: in-lane 4x4 transpose, the 256-bit counterpart of _MM_TRANSPOSE4_PS
+inline void transpose4x2(__m256& r0, __m256& r1, __m256& r2, __m256& r3) noexcept {
+    const __m256d t0 = _mm256_castps_pd(_mm256_unpacklo_ps(r0, r1));
+    const __m256d t1 = _mm256_castps_pd(_mm256_unpacklo_ps(r2, r3));
+    const __m256d t2 = _mm256_castps_pd(_mm256_unpackhi_ps(r0, r1));
+    const __m256d t3 = _mm256_castps_pd(_mm256_unpackhi_ps(r2, r3));
+    r0 = _mm256_castpd_ps(_mm256_unpacklo_pd(t0, t1));
+    r1 = _mm256_castpd_ps(_mm256_unpackhi_pd(t0, t1));
+    r2 = _mm256_castpd_ps(_mm256_unpacklo_pd(t2, t3));
+    r3 = _mm256_castpd_ps(_mm256_unpackhi_pd(t2, t3));
+}
+
+//NOTE: 8 packed xyzw quaternions <-> x, y, z, w registers; quaternions k and k + 4 share a
+//      row so lanes come out in element order, matching load_xyz8 and plain loads of t
+struct quat8 {
+    __m256 x, y, z, w;
+};
+
+[[nodiscard]] inline quat8 load_quat8(const float* p) noexcept {
+    quat8 q{load2x4(p, p + 16), load2x4(p + 4, p + 20), load2x4(p + 8, p + 24), load2x4(p + 12, p + 28)};
+    transpose4x2(q.x, q.y, q.z, q.w);
+    return q;
+}
+
+inline void store_quat8(float* p, quat8 q) noexcept {
+    transpose4x2(q.x, q.y, q.z, q.w);
+    store2x4(p, p + 16, q.x);
+    store2x4(p + 4, p + 20, q.y);
+    store2x4(p + 8, p + 24, q.z);
+    store2x4(p + 12, p + 28, q.w);
+}
+
+[[nodiscard]] inline __m256 dot8(const quat8& a, const quat8& b) noexcept {
+    return _mm256_fmadd_ps(a.x, b.x, _mm256_fmadd_ps(a.y, b.y, _mm256_fmadd_ps(a.z, b.z, _mm256_mul_ps(a.w, b.w))));
+}
+
+[[nodiscard]] inline quat8 blend8(const quat8& a, __m256 wa, const quat8& b, __m256 wb) noexcept {
+    return {_mm256_fmadd_ps(wa, a.x, _mm256_mul_ps(wb, b.x)),
+            _mm256_fmadd_ps(wa, a.y, _mm256_mul_ps(wb, b.y)),
+            _mm256_fmadd_ps(wa, a.z, _mm256_mul_ps(wb, b.z)),
+            _mm256_fmadd_ps(wa, a.w, _mm256_mul_ps(wb, b.w))};
+}
+
+[[nodiscard]] inline __m256 slerp_weight8(__m256 t, __m256 xm1) noexcept {
+    const __m256 tt  = _mm256_mul_ps(t, t);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    __m256 f = one;
+    for (int k = 7; k >= 0; --k) {
+        const __m256 c = _mm256_mul_ps(_mm256_fmsub_ps(_mm256_set1_ps(slerp_u[k]), tt, _mm256_set1_ps(slerp_v[k])), xm1);
+        f = _mm256_fmadd_ps(c, f, one);
+    }
+    return _mm256_mul_ps(t, f);
+}
+
+void slerp_quat(const float* a, const float* b, const float* t, std::size_t t_step,
+                float* out, std::size_t n) noexcept {
+    //NOTE: the broadcast operand below is read before the loop; empty spans may pass null
+    if (n == 0) {
+        return;
+    }
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    const __m256 one  = _mm256_set1_ps(1.0f);
+    const __m256 t1   = _mm256_set1_ps(*t);
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const quat8 qa = load_quat8(a + i * 4);
+        const quat8 qb = load_quat8(b + i * 4);
+        const __m256 tv = t_step ? _mm256_loadu_ps(t + i) : t1;
+
+        const __m256 d   = dot8(qa, qb);
+        const __m256 neg = _mm256_and_ps(d, sign);
+        const __m256 xm1 = _mm256_sub_ps(_mm256_andnot_ps(sign, d), one);
+        const __m256 wa  = slerp_weight8(_mm256_sub_ps(one, tv), xm1);
+        const __m256 wb  = _mm256_xor_ps(slerp_weight8(tv, xm1), neg);
+        store_quat8(out + i * 4, blend8(qa, wa, qb, wb));
+    }
+    if (i < n) {
+        scalar_kernels().slerp_quat(a + i * 4, b + i * 4, t + i * t_step, t_step, out + i * 4, n - i);
+    }
+}
+
+void nlerp_quat(const float* a, const float* b, const float* t, std::size_t t_step,
+                float* out, std::size_t n) noexcept {
+    if (n == 0) {
+        return;
+    }
+    const __m256 sign  = _mm256_set1_ps(-0.0f);
+    const __m256 one   = _mm256_set1_ps(1.0f);
+    const __m256 half  = _mm256_set1_ps(0.5f);
+    const __m256 three = _mm256_set1_ps(3.0f);
+    const __m256 t1    = _mm256_set1_ps(*t);
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const quat8 qa = load_quat8(a + i * 4);
+        const quat8 qb = load_quat8(b + i * 4);
+        const __m256 tv = t_step ? _mm256_loadu_ps(t + i) : t1;
+
+        const __m256 wb = _mm256_xor_ps(tv, _mm256_and_ps(dot8(qa, qb), sign));
+        const quat8 r   = blend8(qa, _mm256_sub_ps(one, tv), qb, wb);
+
+        const __m256 l2  = dot8(r, r);
+        const __m256 est = _mm256_rsqrt_ps(l2);
+        const __m256 inv = _mm256_mul_ps(_mm256_mul_ps(half, est),
+                                         _mm256_fnmadd_ps(_mm256_mul_ps(l2, est), est, three));
+        store_quat8(out + i * 4, {_mm256_mul_ps(r.x, inv), _mm256_mul_ps(r.y, inv),
+                                  _mm256_mul_ps(r.z, inv), _mm256_mul_ps(r.w, inv)});
+    }
+    if (i < n) {
+        scalar_kernels().nlerp_quat(a + i * 4, b + i * 4, t + i * t_step, t_step, out + i * 4, n - i);
+    }
+}
+
+void rotate3(const float* q, std::size_t q_step, const float* in, float* out, std::size_t n) noexcept {
+    if (n == 0) {
+        return;
+    }
+    const quat8 q1{_mm256_set1_ps(q[0]), _mm256_set1_ps(q[1]), _mm256_set1_ps(q[2]), _mm256_set1_ps(q[3])};
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const quat8 r = q_step ? load_quat8(q + i * 4) : q1;
+        __m256 x, y, z;
+        load_xyz8(in + i * 3, x, y, z);
+
+        const __m256 tx = _mm256_fmsub_ps(r.y, z, _mm256_mul_ps(r.z, y));
+        const __m256 ty = _mm256_fmsub_ps(r.z, x, _mm256_mul_ps(r.x, z));
+        const __m256 tz = _mm256_fmsub_ps(r.x, y, _mm256_mul_ps(r.y, x));
+        const __m256 ux = _mm256_add_ps(tx, tx);
+        const __m256 uy = _mm256_add_ps(ty, ty);
+        const __m256 uz = _mm256_add_ps(tz, tz);
+
+        store_xyz8(out + i * 3,
+                   _mm256_fmadd_ps(r.w, ux, _mm256_add_ps(x, _mm256_fmsub_ps(r.y, uz, _mm256_mul_ps(r.z, uy)))),
+                   _mm256_fmadd_ps(r.w, uy, _mm256_add_ps(y, _mm256_fmsub_ps(r.z, ux, _mm256_mul_ps(r.x, uz)))),
+                   _mm256_fmadd_ps(r.w, uz, _mm256_add_ps(z, _mm256_fmsub_ps(r.x, uy, _mm256_mul_ps(r.y, ux)))));
+    }
+    if (i < n) {
+        scalar_kernels().rotate3(q + i * 4 * q_step, q_step, in + i * 3, out + i * 3, n - i);
+    }
+}
+
+void quat_to_mat4(const float* q, float* out, std::size_t n) noexcept {
+    const __m256 one  = _mm256_set1_ps(1.0f);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m128 col3 = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const quat8 r = load_quat8(q + i * 4);
+        const __m256 l2 = dot8(r, r);
+        const __m256 s  = _mm256_and_ps(_mm256_div_ps(_mm256_set1_ps(2.0f), l2), _mm256_cmp_ps(l2, zero, _CMP_GT_OQ));
+
+        const __m256 sx = _mm256_mul_ps(s, r.x);
+        const __m256 sy = _mm256_mul_ps(s, r.y);
+        const __m256 sz = _mm256_mul_ps(s, r.z);
+        const __m256 xx = _mm256_mul_ps(sx, r.x), yy = _mm256_mul_ps(sy, r.y), zz = _mm256_mul_ps(sz, r.z);
+        const __m256 xy = _mm256_mul_ps(sx, r.y), xz = _mm256_mul_ps(sx, r.z), yz = _mm256_mul_ps(sy, r.z);
+        const __m256 wx = _mm256_mul_ps(sx, r.w), wy = _mm256_mul_ps(sy, r.w), wz = _mm256_mul_ps(sz, r.w);
+
+        __m256 c0[4] = {_mm256_sub_ps(one, _mm256_add_ps(yy, zz)), _mm256_add_ps(xy, wz), _mm256_sub_ps(xz, wy), zero};
+        __m256 c1[4] = {_mm256_sub_ps(xy, wz), _mm256_sub_ps(one, _mm256_add_ps(xx, zz)), _mm256_add_ps(yz, wx), zero};
+        __m256 c2[4] = {_mm256_add_ps(xz, wy), _mm256_sub_ps(yz, wx), _mm256_sub_ps(one, _mm256_add_ps(xx, yy)), zero};
+        transpose4x2(c0[0], c0[1], c0[2], c0[3]);
+        transpose4x2(c1[0], c1[1], c1[2], c1[3]);
+        transpose4x2(c2[0], c2[1], c2[2], c2[3]);
+
+        //NOTE: row k holds matrix k in its low half and matrix k + 4 in its high half
+        float* m = out + i * 16;
+        for (int k = 0; k < 4; ++k, m += 16) {
+            store2x4(m, m + 64, c0[k]);
+            store2x4(m + 4, m + 68, c1[k]);
+            store2x4(m + 8, m + 72, c2[k]);
+            _mm_storeu_ps(m + 12, col3);
+            _mm_storeu_ps(m + 76, col3);
+        }
+    }
+    if (i < n) {
+        scalar_kernels().quat_to_mat4(q + i * 4, out + i * 16, n - i);
+    }
+}
+
+//NOTE: clamp to [lo, 1], scale and round to nearest-even; maxps returns lo for NaN
+[[nodiscard]] inline __m256i quantize8(__m256 v, __m256 lo, __m256 scale) noexcept {
+    return _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(v, lo), _mm256_set1_ps(1.0f)), scale));
+}
+
+//NOTE: same integer conversion as the SSE kernel; F16C is not assumed, this TU is only built
+//      for AVX2 and FMA
+[[nodiscard]] inline __m256i to_half8(__m256 f) noexcept {
+    const __m256i f16max      = _mm256_set1_epi32(static_cast<int>(half_overflow));
+    const __m256i min_normal  = _mm256_set1_epi32(static_cast<int>(half_min_normal));
+    const __m256i denorm_bits = _mm256_set1_epi32(static_cast<int>(half_denorm_magic));
+    const __m256i normal_bias = _mm256_set1_epi32(static_cast<int>(half_normal_bias));
+
+    const __m256  sign = _mm256_and_ps(f, _mm256_set1_ps(-0.0f));
+    const __m256  absf = _mm256_xor_ps(f, sign);
+    const __m256i bits = _mm256_castps_si256(absf);
+
+    const __m256i nan     = _mm256_and_si256(_mm256_castps_si256(_mm256_cmp_ps(absf, absf, _CMP_UNORD_Q)),
+                                             _mm256_set1_epi32(0x200));
+    const __m256i special = _mm256_or_si256(nan, _mm256_set1_epi32(0x7c00));
+    const __m256i regular = _mm256_cmpgt_epi32(f16max, bits);
+    const __m256i subnorm = _mm256_cmpgt_epi32(min_normal, bits);
+
+    const __m256i denorm = _mm256_sub_epi32(
+        _mm256_castps_si256(_mm256_add_ps(absf, _mm256_castsi256_ps(denorm_bits))), denorm_bits);
+    const __m256i odd    = _mm256_srai_epi32(_mm256_slli_epi32(bits, 31 - 13), 31);
+    const __m256i normal = _mm256_srli_epi32(_mm256_sub_epi32(_mm256_add_epi32(bits, normal_bias), odd), 13);
+
+    const __m256i finite = _mm256_blendv_epi8(normal, denorm, subnorm);
+    const __m256i joined = _mm256_blendv_epi8(special, finite, regular);
+    return _mm256_or_si256(joined, _mm256_srli_epi32(_mm256_castps_si256(sign), 16));
+}
+
+//NOTE: the 32-bit unpacks work per 128-bit lane, the cross-lane permutes restore point order
+inline void store_u16x8(std::uint16_t* p, __m256i x, __m256i y, __m256i z, __m256i w) noexcept {
+    const __m256i mask = _mm256_set1_epi32(0xffff);
+    const __m256i xy = _mm256_or_si256(_mm256_and_si256(x, mask), _mm256_slli_epi32(y, 16));
+    const __m256i zw = _mm256_or_si256(_mm256_and_si256(z, mask), _mm256_slli_epi32(w, 16));
+    const __m256i lo = _mm256_unpacklo_epi32(xy, zw);
+    const __m256i hi = _mm256_unpackhi_epi32(xy, zw);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p),      _mm256_permute2x128_si256(lo, hi, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p + 16), _mm256_permute2x128_si256(lo, hi, 0x31));
+}
+
+void pack_half4(const float* in, std::uint16_t* out, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x, y, z;
+        load_xyz8(in + i * 3, x, y, z);
+        store_u16x8(out + i * 4, to_half8(x), to_half8(y), to_half8(z), _mm256_setzero_si256());
+    }
+    if (i < n) {
+        scalar_kernels().pack_half4(in + i * 3, out + i * 4, n - i);
+    }
+}
+
+void pack_snorm16x4(const float* in, std::uint16_t* out, std::size_t n) noexcept {
+    const __m256 lo    = _mm256_set1_ps(-1.0f);
+    const __m256 scale = _mm256_set1_ps(32767.0f);
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x, y, z;
+        load_xyz8(in + i * 3, x, y, z);
+        store_u16x8(out + i * 4, quantize8(x, lo, scale), quantize8(y, lo, scale), quantize8(z, lo, scale),
+                    _mm256_setzero_si256());
+    }
+    if (i < n) {
+        scalar_kernels().pack_snorm16x4(in + i * 3, out + i * 4, n - i);
+    }
+}
+
+void pack_unorm8x4(const float* in, std::uint32_t* out, std::size_t n) noexcept {
+    const __m256  lo    = _mm256_setzero_ps();
+    const __m256  scale = _mm256_set1_ps(255.0f);
+    const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xff000000u));
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x, y, z;
+        load_xyz8(in + i * 3, x, y, z);
+        const __m256i xy = _mm256_or_si256(quantize8(x, lo, scale), _mm256_slli_epi32(quantize8(y, lo, scale), 8));
+        const __m256i za = _mm256_or_si256(_mm256_slli_epi32(quantize8(z, lo, scale), 16), alpha);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_or_si256(xy, za));
+    }
+    if (i < n) {
+        scalar_kernels().pack_unorm8x4(in + i * 3, out + i, n - i);
+    }
+}
+
+void pack_snorm10x3(const float* in, std::uint32_t* out, std::size_t n) noexcept {
+    const __m256  lo    = _mm256_set1_ps(-1.0f);
+    const __m256  scale = _mm256_set1_ps(511.0f);
+    const __m256i mask  = _mm256_set1_epi32(0x3ff);
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x, y, z;
+        load_xyz8(in + i * 3, x, y, z);
+        const __m256i px = _mm256_and_si256(quantize8(x, lo, scale), mask);
+        const __m256i py = _mm256_slli_epi32(_mm256_and_si256(quantize8(y, lo, scale), mask), 10);
+        const __m256i pz = _mm256_slli_epi32(_mm256_and_si256(quantize8(z, lo, scale), mask), 20);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_or_si256(_mm256_or_si256(px, py), pz));
+    }
+    if (i < n) {
+        scalar_kernels().pack_snorm10x3(in + i * 3, out + i, n - i);
+    }
+}
+
+void pack_oct16(const float* in, std::uint32_t* out, std::size_t n) noexcept {
+    const __m256  sign  = _mm256_set1_ps(-0.0f);
+    const __m256  one   = _mm256_set1_ps(1.0f);
+    const __m256  zero  = _mm256_setzero_ps();
+    const __m256  lo    = _mm256_set1_ps(-1.0f);
+    const __m256  scale = _mm256_set1_ps(32767.0f);
+    const __m256i mask  = _mm256_set1_epi32(0xffff);
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x, y, z;
+        load_xyz8(in + i * 3, x, y, z);
+        const __m256 l1    = _mm256_add_ps(_mm256_add_ps(_mm256_andnot_ps(sign, x), _mm256_andnot_ps(sign, y)),
+                                           _mm256_andnot_ps(sign, z));
+        const __m256 valid = _mm256_cmp_ps(l1, zero, _CMP_GT_OQ);
+        const __m256 ox    = _mm256_and_ps(_mm256_div_ps(x, l1), valid);
+        const __m256 oy    = _mm256_and_ps(_mm256_div_ps(y, l1), valid);
+
+        const __m256 fx    = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_andnot_ps(sign, oy)),
+                                           _mm256_or_ps(_mm256_and_ps(ox, sign), one));
+        const __m256 fy    = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_andnot_ps(sign, ox)),
+                                           _mm256_or_ps(_mm256_and_ps(oy, sign), one));
+        const __m256 below = _mm256_cmp_ps(z, zero, _CMP_LT_OQ);
+        const __m256 ex    = _mm256_blendv_ps(ox, fx, below);
+        const __m256 ey    = _mm256_blendv_ps(oy, fy, below);
+
+        const __m256i packed = _mm256_or_si256(_mm256_and_si256(quantize8(ex, lo, scale), mask),
+                                               _mm256_slli_epi32(quantize8(ey, lo, scale), 16));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), packed);
+    }
+    if (i < n) {
+        scalar_kernels().pack_oct16(in + i * 3, out + i, n - i);
+    }
+}
+
+//NOTE: lane for the shared kernels (cc/math/detail/lane.hpp), 8 values per register
+struct avx2_u32 {
+    __m256i v;
+
+    avx2_u32() noexcept : v(_mm256_setzero_si256()) {}
+    avx2_u32(__m256i v_) noexcept : v(v_) {}
+    avx2_u32(std::uint32_t s) noexcept : v(_mm256_set1_epi32(static_cast<int>(s))) {}
+};
+
+struct avx2_f32 {
+    __m256 v;
+
+    avx2_f32() noexcept : v(_mm256_setzero_ps()) {}
+    avx2_f32(__m256 v_) noexcept : v(v_) {}
+    avx2_f32(float s) noexcept : v(_mm256_set1_ps(s)) {}
+};
+
+struct avx2_mask {
+    __m256 v;
+};
+
+inline avx2_f32 operator+(avx2_f32 a, avx2_f32 b) noexcept { return _mm256_add_ps(a.v, b.v); }
+inline avx2_f32 operator-(avx2_f32 a, avx2_f32 b) noexcept { return _mm256_sub_ps(a.v, b.v); }
+inline avx2_f32 operator*(avx2_f32 a, avx2_f32 b) noexcept { return _mm256_mul_ps(a.v, b.v); }
+inline avx2_f32 operator/(avx2_f32 a, avx2_f32 b) noexcept { return _mm256_div_ps(a.v, b.v); }
+inline avx2_f32 operator-(avx2_f32 a) noexcept { return _mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f)); }
+
+inline avx2_u32 operator+(avx2_u32 a, avx2_u32 b) noexcept { return _mm256_add_epi32(a.v, b.v); }
+inline avx2_u32 operator*(avx2_u32 a, avx2_u32 b) noexcept { return _mm256_mullo_epi32(a.v, b.v); }
+inline avx2_u32 operator^(avx2_u32 a, avx2_u32 b) noexcept { return _mm256_xor_si256(a.v, b.v); }
+inline avx2_u32 operator&(avx2_u32 a, avx2_u32 b) noexcept { return _mm256_and_si256(a.v, b.v); }
+inline avx2_u32 operator|(avx2_u32 a, avx2_u32 b) noexcept { return _mm256_or_si256(a.v, b.v); }
+inline avx2_u32 operator<<(avx2_u32 a, int s) noexcept { return _mm256_slli_epi32(a.v, s); }
+inline avx2_u32 operator>>(avx2_u32 a, int s) noexcept { return _mm256_srli_epi32(a.v, s); }
+
+struct avx2_lane {
+    using f = avx2_f32;
+    using u = avx2_u32;
+    using m = avx2_mask;
+
+    static f floor(f x) noexcept { return _mm256_floor_ps(x.v); }
+    static f sqrt(f x) noexcept { return _mm256_sqrt_ps(x.v); }
+    static f max(f a, f b) noexcept { return _mm256_max_ps(a.v, b.v); }
+
+    static u to_u(f x) noexcept { return _mm256_cvttps_epi32(x.v); }
+    static f to_f(u x) noexcept { return _mm256_cvtepi32_ps(x.v); }
+    static u as_u(f x) noexcept { return _mm256_castps_si256(x.v); }
+    static f as_f(u x) noexcept { return _mm256_castsi256_ps(x.v); }
+
+    static m gt(f a, f b) noexcept { return {_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)}; }
+    static m ge(f a, f b) noexcept { return {_mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ)}; }
+    static m lt(u a, u b) noexcept { return {_mm256_castsi256_ps(_mm256_cmpgt_epi32(b.v, a.v))}; }
+    //NOTE: b is a single bit
+    static m bit(u a, u b) noexcept {
+        return {_mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(a.v, b.v), b.v))};
+    }
+
+    static m mask_and(m a, m b) noexcept { return {_mm256_and_ps(a.v, b.v)}; }
+    static m mask_or(m a, m b) noexcept { return {_mm256_or_ps(a.v, b.v)}; }
+    static m mask_not(m a) noexcept { return {_mm256_xor_ps(a.v, _mm256_castsi256_ps(_mm256_set1_epi32(-1)))}; }
+
+    static f select(m c, f a, f b) noexcept { return _mm256_blendv_ps(b.v, a.v, c.v); }
+    static u select(m c, u a, u b) noexcept {
+        return _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(b.v), _mm256_castsi256_ps(a.v), c.v));
+    }
+};
+
+void noise_row(const noise::detail::fbm_desc& desc, float x0, float dx, float y, float z,
+               float* out, std::size_t n) noexcept {
+    const __m256 iota = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+    for (std::size_t i = 0; i < n; i += 8) {
+        const __m256 index = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(i)), iota);
+        const avx2_f32 x = _mm256_add_ps(_mm256_set1_ps(x0), _mm256_mul_ps(index, _mm256_set1_ps(dx)));
+        const avx2_f32 r = noise::detail::fbm<avx2_lane>(desc, x, y, z, 0.0f);
+        //NOTE: the last partial group is evaluated in full and only the valid lanes are kept
+        if (i + 8 <= n) {
+            _mm256_storeu_ps(out + i, r.v);
+        } else {
+            alignas(32) float tail[8];
+            _mm256_store_ps(tail, r.v);
+            for (std::size_t j = i; j < n; ++j) {
+                out[j] = tail[j - i];
+            }
+        }
+    }
+}
+
+template<int K>
+inline __m256i rotl64(__m256i x) noexcept {
+    return _mm256_or_si256(_mm256_slli_epi64(x, K), _mm256_srli_epi64(x, 64 - K));
+}
+
+//NOTE: the eight xoshiro256++ streams as four-lane 64-bit registers, s[k][p] holding word k of
+//      streams 4p to 4p + 3
+struct avx2_xoshiro {
+    __m256i s[4][2];
+
+    explicit avx2_xoshiro(const std::uint64_t* state) noexcept {
+        for (int k = 0; k < 4; ++k) {
+            for (int p = 0; p < 2; ++p) {
+                s[k][p] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + k * 8 + p * 4));
+            }
+        }
+    }
+
+    void store(std::uint64_t* state) const noexcept {
+        for (int k = 0; k < 4; ++k) {
+            for (int p = 0; p < 2; ++p) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + k * 8 + p * 4), s[k][p]);
+            }
+        }
+    }
+
+    //NOTE: hi / lo get the upper / lower 32 bits of the outputs of streams 0 to 7; the in-lane
+    //      shuffle leaves the 64-bit pairs in stream order 0 1 4 5 2 3 6 7
+    void step(avx2_u32& hi, avx2_u32& lo) noexcept {
+        __m256 r[2];
+        for (int p = 0; p < 2; ++p) {
+            r[p] = _mm256_castsi256_ps(_mm256_add_epi64(rotl64<23>(_mm256_add_epi64(s[0][p], s[3][p])), s[0][p]));
+            const __m256i t = _mm256_slli_epi64(s[1][p], 17);
+            s[2][p] = _mm256_xor_si256(s[2][p], s[0][p]);
+            s[3][p] = _mm256_xor_si256(s[3][p], s[1][p]);
+            s[1][p] = _mm256_xor_si256(s[1][p], s[2][p]);
+            s[0][p] = _mm256_xor_si256(s[0][p], s[3][p]);
+            s[2][p] = _mm256_xor_si256(s[2][p], t);
+            s[3][p] = rotl64<45>(s[3][p]);
+        }
+        hi = _mm256_permute4x64_epi64(_mm256_castps_si256(_mm256_shuffle_ps(r[0], r[1], _MM_SHUFFLE(3, 1, 3, 1))),
+                                      _MM_SHUFFLE(3, 1, 2, 0));
+        lo = _mm256_permute4x64_epi64(_mm256_castps_si256(_mm256_shuffle_ps(r[0], r[1], _MM_SHUFFLE(2, 0, 2, 0))),
+                                      _MM_SHUFFLE(3, 1, 2, 0));
+    }
+};
+
+//NOTE: whole steps are stored directly, a partial last one goes through a buffer
+void random_uniform(std::uint64_t* state, float* out, std::size_t n, float lo, float scale) noexcept {
+    avx2_xoshiro rng(state);
+    const avx2_f32 offset = lo;
+    const avx2_f32 factor = scale;
+    alignas(32) float tail[16];
+    for (std::size_t i = 0; i < n; i += 16) {
+        avx2_u32 hi;
+        avx2_u32 lw;
+        rng.step(hi, lw);
+        float* dst = i + 16 <= n ? out + i : tail;
+        _mm256_storeu_ps(dst, (offset + factor * random::detail::uniform01<avx2_lane>(hi)).v);
+        _mm256_storeu_ps(dst + 8, (offset + factor * random::detail::uniform01<avx2_lane>(lw)).v);
+        if (dst == tail) {
+            std::memcpy(out + i, tail, (n - i) * sizeof(float));
+        }
+    }
+    rng.store(state);
+}
+
+void random_unit3(std::uint64_t* state, float* out, std::size_t n) noexcept {
+    avx2_xoshiro rng(state);
+    alignas(32) float tail[24];
+    for (std::size_t i = 0; i < n; i += 8) {
+        avx2_u32 hi;
+        avx2_u32 lw;
+        rng.step(hi, lw);
+        avx2_f32 x;
+        avx2_f32 y;
+        avx2_f32 z;
+        random::detail::unit_vector<avx2_lane>(hi, lw, x, y, z);
+        float* dst = i + 8 <= n ? out + i * 3 : tail;
+        store_xyz8(dst, x.v, y.v, z.v);
+        if (dst == tail) {
+            std::memcpy(out + i * 3, tail, (n - i) * 3 * sizeof(float));
+        }
+    }
+    rng.store(state);
+}
+
+void random_gaussian(std::uint64_t* state, float* out, std::size_t n, float mean, float stddev) noexcept {
+    avx2_xoshiro rng(state);
+    const avx2_f32 offset = mean;
+    const avx2_f32 factor = stddev;
+    alignas(32) float tail[16];
+    for (std::size_t i = 0; i < n; i += 16) {
+        avx2_u32 hi;
+        avx2_u32 lw;
+        rng.step(hi, lw);
+        avx2_f32 g0;
+        avx2_f32 g1;
+        random::detail::gaussian_pair<avx2_lane>(hi, lw, g0, g1);
+        float* dst = i + 16 <= n ? out + i : tail;
+        _mm256_storeu_ps(dst, (offset + factor * g0).v);
+        _mm256_storeu_ps(dst + 8, (offset + factor * g1).v);
+        if (dst == tail) {
+            std::memcpy(out + i, tail, (n - i) * sizeof(float));
+        }
+    }
+    rng.store(state);
+}
+
+namespace jacobi3 = cc::detail::jacobi3;
+
+//NOTE: up to 8 packed 3x3 matrices <-> one register per element; short groups are padded with
+//      zero matrices, which decompose without NaNs
+jacobi3::mat3<avx2_lane> load_mat3x8(const float* p, std::size_t count) noexcept {
+    alignas(32) float t[9][8] = {};
+    for (std::size_t j = 0; j < count; ++j) {
+        for (int e = 0; e < 9; ++e) {
+            t[e][j] = p[j * 9 + e];
+        }
+    }
+    jacobi3::mat3<avx2_lane> m;
+    for (int e = 0; e < 9; ++e) {
+        m.e[e] = _mm256_load_ps(t[e]);
+    }
+    return m;
+}
+
+template<int N>
+void store_lanes(float* p, const avx2_f32* v, std::size_t count) noexcept {
+    alignas(32) float t[N][8];
+    for (int e = 0; e < N; ++e) {
+        _mm256_store_ps(t[e], v[e].v);
+    }
+    for (std::size_t j = 0; j < count; ++j) {
+        for (int e = 0; e < N; ++e) {
+            p[j * N + e] = t[e][j];
+        }
+    }
+}
+
+void svd3(const float* in, float* u, float* s, float* v, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; i += 8) {
+        const std::size_t count = std::min<std::size_t>(n - i, 8);
+        jacobi3::mat3<avx2_lane> mu;
+        jacobi3::mat3<avx2_lane> mv;
+        avx2_f32 sigma[3];
+        jacobi3::svd<avx2_lane>(load_mat3x8(in + i * 9, count), mu, sigma, mv);
+        store_lanes<9>(u + i * 9, mu.e, count);
+        store_lanes<3>(s + i * 3, sigma, count);
+        store_lanes<9>(v + i * 9, mv.e, count);
+    }
+}
+
+void eigen3(const float* in, float* values, float* vectors, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; i += 8) {
+        const std::size_t count = std::min<std::size_t>(n - i, 8);
+        jacobi3::mat3<avx2_lane> mv;
+        avx2_f32 lambda[3];
+        jacobi3::eigen_symmetric<avx2_lane>(load_mat3x8(in + i * 9, count), lambda, mv);
+        store_lanes<3>(values + i * 3, lambda, count);
+        store_lanes<9>(vectors + i * 9, mv.e, count);
+    }
+}
+
+void polar3(const float* in, float* r, float* s, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; i += 8) {
+        const std::size_t count = std::min<std::size_t>(n - i, 8);
+        jacobi3::mat3<avx2_lane> mr;
+        jacobi3::mat3<avx2_lane> ms;
+        jacobi3::polar<avx2_lane>(load_mat3x8(in + i * 9, count), mr, ms);
+        store_lanes<9>(r + i * 9, mr.e, count);
+        store_lanes<9>(s + i * 9, ms.e, count);
+    }
+}
+
+//NOTE: bits and count of the 8 elements starting at i; inliers may be null
+inline std::size_t store_inliers(avx2_mask inside, std::size_t i, std::uint64_t* inliers) noexcept {
+    const auto bits = static_cast<std::uint64_t>(_mm256_movemask_ps(inside.v));
+    if (inliers) {
+        inliers[i / 64] |= bits << (i % 64);
+    }
+    return static_cast<std::size_t>(_mm_popcnt_u32(static_cast<unsigned>(bits)));
+}
+
+std::size_t score_homography(const float* h, const float* sx, const float* sy, const float* dx,
+                             const float* dy, std::size_t n, float threshold2,
+                             std::uint64_t* inliers) noexcept {
+    std::size_t count = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const avx2_mask inside = vision::detail::homography_inlier<avx2_lane>(
+            h, _mm256_loadu_ps(sx + i), _mm256_loadu_ps(sy + i), _mm256_loadu_ps(dx + i), _mm256_loadu_ps(dy + i), threshold2);
+        count += store_inliers(inside, i, inliers);
+    }
+    if (i < n) {
+        std::uint64_t tail = 0;
+        count += scalar_kernels().score_homography(h, sx + i, sy + i, dx + i, dy + i, n - i, threshold2,
+                                                   inliers ? &tail : nullptr);
+        if (inliers) {
+            merge_tail(tail, i, inliers);
+        }
+    }
+    return count;
+}
+
+std::size_t score_epipolar(const float* f, const float* sx, const float* sy, const float* dx,
+                           const float* dy, std::size_t n, float threshold2,
+                           std::uint64_t* inliers) noexcept {
+    std::size_t count = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const avx2_mask inside = vision::detail::epipolar_inlier<avx2_lane>(
+            f, _mm256_loadu_ps(sx + i), _mm256_loadu_ps(sy + i), _mm256_loadu_ps(dx + i), _mm256_loadu_ps(dy + i), threshold2);
+        count += store_inliers(inside, i, inliers);
+    }
+    if (i < n) {
+        std::uint64_t tail = 0;
+        count += scalar_kernels().score_epipolar(f, sx + i, sy + i, dx + i, dy + i, n - i, threshold2,
+                                                 inliers ? &tail : nullptr);
+        if (inliers) {
+            merge_tail(tail, i, inliers);
+        }
+    }
+    return count;
+}
+
+std::size_t score_projection(const float* p, const float* x, const float* y, const float* z,
+                             const float* u, const float* v, std::size_t n, float threshold2,
+                             std::uint64_t* inliers) noexcept {
+    std::size_t count = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const avx2_mask inside = vision::detail::projection_inlier<avx2_lane>(
+            p, _mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), _mm256_loadu_ps(z + i), _mm256_loadu_ps(u + i), _mm256_loadu_ps(v + i), threshold2);
+        count += store_inliers(inside, i, inliers);
+    }
+    if (i < n) {
+        std::uint64_t tail = 0;
+        count += scalar_kernels().score_projection(p, x + i, y + i, z + i, u + i, v + i, n - i, threshold2,
+                                                   inliers ? &tail : nullptr);
+        if (inliers) {
+            merge_tail(tail, i, inliers);
+        }
+    }
+    return count;
+}
+
+constexpr kernel_table table{"avx2", &transform3, &multiply4x4, &normalize3, &cull_spheres, &cull_aabbs,
+                             &slerp_quat, &nlerp_quat, &rotate3, &quat_to_mat4,
+                             &pack_half4, &pack_snorm16x4, &pack_unorm8x4, &pack_snorm10x3, &pack_oct16,
+                             &noise_row, &random_uniform, &random_unit3, &random_gaussian,
+                             &svd3, &eigen3, &polar3,
+                             &score_homography, &score_epipolar, &score_projection};
+
+} // namespace
+
+const kernel_table* avx2_kernels() noexcept {
+    return &table;
+}
+
+#else
+
+const kernel_table* avx2_kernels() noexcept {
+    return nullptr;
+}
+
+#endif
+
+} // namespace cc::batch::detail
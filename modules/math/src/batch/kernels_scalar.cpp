@@ -0,0 +1,387 @@
+#include "kernels.hpp"
+#include "packing.hpp"
+#include "mat/jacobi3.hpp"
+#include "noise/lattice.hpp"
+#include "random/sampling.hpp"
+#include "vision/scoring.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+namespace cc::batch::detail {
+
+namespace {
+
+void transform3(const float* m, const float* in, float* out, std::size_t n, float w) noexcept {
+    for (std::size_t i = 0; i < n; ++i, in += 3, out += 3) {
+        const float x = in[0];
+        const float y = in[1];
+        const float z = in[2];
+        out[0] = m[0] * x + m[4] * y + m[8]  * z + m[12] * w;
+        out[1] = m[1] * x + m[5] * y + m[9]  * z + m[13] * w;
+        out[2] = m[2] * x + m[6] * y + m[10] * z + m[14] * w;
+    }
+}
+
+void multiply4x4(const float* a, const float* b, float* out, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i, a += 16, b += 16, out += 16) {
+        float r[16];
+        for (int c = 0; c < 4; ++c) {
+            for (int row = 0; row < 4; ++row) {
+                r[c * 4 + row] = a[row]      * b[c * 4]
+                               + a[4 + row]  * b[c * 4 + 1]
+                               + a[8 + row]  * b[c * 4 + 2]
+                               + a[12 + row] * b[c * 4 + 3];
+            }
+        }
+        for (int k = 0; k < 16; ++k) {
+            out[k] = r[k];
+        }
+    }
+}
+
+void normalize3(const float* in, float* out, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i, in += 3, out += 3) {
+        const float x = in[0];
+        const float y = in[1];
+        const float z = in[2];
+        const float l = std::sqrt(x * x + y * y + z * z);
+        if (l == 0.0f) {
+            out[0] = out[1] = out[2] = 0.0f;
+            continue;
+        }
+        out[0] = x / l;
+        out[1] = y / l;
+        out[2] = z / l;
+    }
+}
+
+std::size_t cull_spheres(const float* planes, const float* x, const float* y, const float* z,
+                         const float* r, std::size_t n, std::uint64_t* visible) noexcept {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        bool inside = true;
+        for (int p = 0; p < 6 && inside; ++p) {
+            const float* pl = planes + p * 4;
+            inside = pl[0] * x[i] + pl[1] * y[i] + pl[2] * z[i] + pl[3] >= -r[i];
+        }
+        if (inside) {
+            visible[i / 64] |= std::uint64_t{1} << (i % 64);
+            ++count;
+        }
+    }
+    return count;
+}
+
+std::size_t cull_aabbs(const float* planes, const float* cx, const float* cy, const float* cz,
+                       const float* ex, const float* ey, const float* ez, std::size_t n,
+                       std::uint64_t* visible) noexcept {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        bool inside = true;
+        for (int p = 0; p < 6 && inside; ++p) {
+            const float* pl = planes + p * 4;
+            const float radius = ex[i] * std::fabs(pl[0]) + ey[i] * std::fabs(pl[1]) + ez[i] * std::fabs(pl[2]);
+            inside = pl[0] * cx[i] + pl[1] * cy[i] + pl[2] * cz[i] + pl[3] >= -radius;
+        }
+        if (inside) {
+            visible[i / 64] |= std::uint64_t{1} << (i % 64);
+            ++count;
+        }
+    }
+    return count;
+}
+
+//NOTE: sin(t * theta) / sin(theta) with xm1 = cos(theta) - 1
+[[nodiscard]] inline float slerp_weight(float t, float xm1) noexcept {
+    const float tt = t * t;
+    float f = 1.0f;
+    for (int k = 7; k >= 0; --k) {
+        f = 1.0f + (slerp_u[k] * tt - slerp_v[k]) * xm1 * f;
+    }
+    return t * f;
+}
+
+void slerp_quat(const float* a, const float* b, const float* t, std::size_t t_step,
+                float* out, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i, a += 4, b += 4, out += 4, t += t_step) {
+        const float d    = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+        const float sign = d < 0.0f ? -1.0f : 1.0f;
+        const float xm1  = d * sign - 1.0f;
+        const float wa   = slerp_weight(1.0f - *t, xm1);
+        const float wb   = slerp_weight(*t, xm1) * sign;
+        for (int k = 0; k < 4; ++k) {
+            out[k] = wa * a[k] + wb * b[k];
+        }
+    }
+}
+
+void nlerp_quat(const float* a, const float* b, const float* t, std::size_t t_step,
+                float* out, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i, a += 4, b += 4, out += 4, t += t_step) {
+        const float d  = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+        const float wa = 1.0f - *t;
+        const float wb = d < 0.0f ? -*t : *t;
+        float r[4];
+        for (int k = 0; k < 4; ++k) {
+            r[k] = wa * a[k] + wb * b[k];
+        }
+        const float inv = 1.0f / std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2] + r[3] * r[3]);
+        for (int k = 0; k < 4; ++k) {
+            out[k] = r[k] * inv;
+        }
+    }
+}
+
+//NOTE: v + w * t + cross(q.xyz, t) with t = 2 * cross(q.xyz, v)
+void rotate3(const float* q, std::size_t q_step, const float* in, float* out, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i, q += q_step * 4, in += 3, out += 3) {
+        const float x = in[0];
+        const float y = in[1];
+        const float z = in[2];
+        const float tx = 2.0f * (q[1] * z - q[2] * y);
+        const float ty = 2.0f * (q[2] * x - q[0] * z);
+        const float tz = 2.0f * (q[0] * y - q[1] * x);
+        out[0] = x + q[3] * tx + (q[1] * tz - q[2] * ty);
+        out[1] = y + q[3] * ty + (q[2] * tx - q[0] * tz);
+        out[2] = z + q[3] * tz + (q[0] * ty - q[1] * tx);
+    }
+}
+
+//NOTE: scaled by 2 / |q|^2 so non-unit quaternions give the same rotation as quat::to_mat4();
+//      a zero quaternion gives the identity
+void quat_to_mat4(const float* q, float* out, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i, q += 4, out += 16) {
+        const float x = q[0], y = q[1], z = q[2], w = q[3];
+        const float l2 = x * x + y * y + z * z + w * w;
+        const float s  = l2 > 0.0f ? 2.0f / l2 : 0.0f;
+        const float xx = s * x * x, yy = s * y * y, zz = s * z * z;
+        const float xy = s * x * y, xz = s * x * z, yz = s * y * z;
+        const float wx = s * w * x, wy = s * w * y, wz = s * w * z;
+
+        out[0]  = 1.0f - (yy + zz); out[1]  = xy + wz;          out[2]  = xz - wy;          out[3]  = 0.0f;
+        out[4]  = xy - wz;          out[5]  = 1.0f - (xx + zz); out[6]  = yz + wx;          out[7]  = 0.0f;
+        out[8]  = xz + wy;          out[9]  = yz - wx;          out[10] = 1.0f - (xx + yy); out[11] = 0.0f;
+        out[12] = 0.0f;             out[13] = 0.0f;             out[14] = 0.0f;             out[15] = 1.0f;
+    }
+}
+
+void pack_half4(const float* in, std::uint16_t* out, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i, in += 3, out += 4) {
+        out[0] = to_half(in[0]);
+        out[1] = to_half(in[1]);
+        out[2] = to_half(in[2]);
+        out[3] = 0;
+    }
+}
+
+void pack_snorm16x4(const float* in, std::uint16_t* out, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i, in += 3, out += 4) {
+        out[0] = static_cast<std::uint16_t>(quantize(in[0], -1.0f, 32767.0f));
+        out[1] = static_cast<std::uint16_t>(quantize(in[1], -1.0f, 32767.0f));
+        out[2] = static_cast<std::uint16_t>(quantize(in[2], -1.0f, 32767.0f));
+        out[3] = 0;
+    }
+}
+
+void pack_unorm8x4(const float* in, std::uint32_t* out, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i, in += 3) {
+        out[i] = static_cast<std::uint32_t>(quantize(in[0], 0.0f, 255.0f))
+               | static_cast<std::uint32_t>(quantize(in[1], 0.0f, 255.0f)) << 8
+               | static_cast<std::uint32_t>(quantize(in[2], 0.0f, 255.0f)) << 16
+               | 0xff000000u;
+    }
+}
+
+void pack_snorm10x3(const float* in, std::uint32_t* out, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i, in += 3) {
+        out[i] = (static_cast<std::uint32_t>(quantize(in[0], -1.0f, 511.0f)) & 0x3ffu)
+               | (static_cast<std::uint32_t>(quantize(in[1], -1.0f, 511.0f)) & 0x3ffu) << 10
+               | (static_cast<std::uint32_t>(quantize(in[2], -1.0f, 511.0f)) & 0x3ffu) << 20;
+    }
+}
+
+void pack_oct16(const float* in, std::uint32_t* out, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i, in += 3) {
+        const float l1 = std::fabs(in[0]) + std::fabs(in[1]) + std::fabs(in[2]);
+        float x = l1 > 0.0f ? in[0] / l1 : 0.0f;
+        float y = l1 > 0.0f ? in[1] / l1 : 0.0f;
+        if (in[2] < 0.0f) {
+            const float fx = (1.0f - std::fabs(y)) * std::copysign(1.0f, x);
+            const float fy = (1.0f - std::fabs(x)) * std::copysign(1.0f, y);
+            x = fx;
+            y = fy;
+        }
+        out[i] = (static_cast<std::uint32_t>(quantize(x, -1.0f, 32767.0f)) & 0xffffu)
+               | static_cast<std::uint32_t>(quantize(y, -1.0f, 32767.0f)) << 16;
+    }
+}
+
+void noise_row(const noise::detail::fbm_desc& desc, float x0, float dx, float y, float z,
+               float* out, std::size_t n) noexcept {
+    using lane = noise::detail::scalar_lane;
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = noise::detail::fbm<lane>(desc, x0 + static_cast<float>(i) * dx, y, z, 0.0f);
+    }
+}
+
+//NOTE: one step of the eight xoshiro256++ streams; r[i] is the output of stream i
+void xoshiro_step(std::uint64_t* s, std::uint64_t* r) noexcept {
+    for (std::size_t i = 0; i < 8; ++i) {
+        r[i] = std::rotl(s[i] + s[24 + i], 23) + s[i];
+        const std::uint64_t t = s[8 + i] << 17;
+        s[16 + i] ^= s[i];
+        s[24 + i] ^= s[8 + i];
+        s[8 + i]  ^= s[16 + i];
+        s[i]      ^= s[24 + i];
+        s[16 + i] ^= t;
+        s[24 + i] = std::rotl(s[24 + i], 45);
+    }
+}
+
+void random_uniform(std::uint64_t* state, float* out, std::size_t n, float lo, float scale) noexcept {
+    using lane = random::detail::scalar_lane;
+    std::uint64_t r[8];
+    float         v[16];
+    for (std::size_t i = 0; i < n; i += 16) {
+        xoshiro_step(state, r);
+        for (std::size_t j = 0; j < 8; ++j) {
+            v[j]     = lo + scale * random::detail::uniform01<lane>(static_cast<std::uint32_t>(r[j] >> 32));
+            v[8 + j] = lo + scale * random::detail::uniform01<lane>(static_cast<std::uint32_t>(r[j]));
+        }
+        std::memcpy(out + i, v, std::min<std::size_t>(n - i, 16) * sizeof(float));
+    }
+}
+
+void random_unit3(std::uint64_t* state, float* out, std::size_t n) noexcept {
+    using lane = random::detail::scalar_lane;
+    std::uint64_t r[8];
+    float         v[24];
+    for (std::size_t i = 0; i < n; i += 8) {
+        xoshiro_step(state, r);
+        for (std::size_t j = 0; j < 8; ++j) {
+            random::detail::unit_vector<lane>(static_cast<std::uint32_t>(r[j] >> 32), static_cast<std::uint32_t>(r[j]),
+                                              v[3 * j], v[3 * j + 1], v[3 * j + 2]);
+        }
+        std::memcpy(out + 3 * i, v, std::min<std::size_t>(n - i, 8) * 3 * sizeof(float));
+    }
+}
+
+void random_gaussian(std::uint64_t* state, float* out, std::size_t n, float mean, float stddev) noexcept {
+    using lane = random::detail::scalar_lane;
+    std::uint64_t r[8];
+    float         v[16];
+    for (std::size_t i = 0; i < n; i += 16) {
+        xoshiro_step(state, r);
+        for (std::size_t j = 0; j < 8; ++j) {
+            random::detail::gaussian_pair<lane>(static_cast<std::uint32_t>(r[j] >> 32), static_cast<std::uint32_t>(r[j]),
+                                                v[j], v[8 + j]);
+            v[j]     = mean + stddev * v[j];
+            v[8 + j] = mean + stddev * v[8 + j];
+        }
+        std::memcpy(out + i, v, std::min<std::size_t>(n - i, 16) * sizeof(float));
+    }
+}
+
+namespace jacobi3 = cc::detail::jacobi3;
+using cc::detail::scalar_lane;
+
+jacobi3::mat3<scalar_lane> load_mat3(const float* p) noexcept {
+    jacobi3::mat3<scalar_lane> m;
+    std::copy(p, p + 9, m.e);
+    return m;
+}
+
+void svd3(const float* in, float* u, float* s, float* v, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i, in += 9, u += 9, s += 3, v += 9) {
+        jacobi3::mat3<scalar_lane> mu;
+        jacobi3::mat3<scalar_lane> mv;
+        float sigma[3];
+        jacobi3::svd<scalar_lane>(load_mat3(in), mu, sigma, mv);
+        std::copy(mu.e, mu.e + 9, u);
+        std::copy(sigma, sigma + 3, s);
+        std::copy(mv.e, mv.e + 9, v);
+    }
+}
+
+void eigen3(const float* in, float* values, float* vectors, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i, in += 9, values += 3, vectors += 9) {
+        jacobi3::mat3<scalar_lane> mv;
+        float lambda[3];
+        jacobi3::eigen_symmetric<scalar_lane>(load_mat3(in), lambda, mv);
+        std::copy(lambda, lambda + 3, values);
+        std::copy(mv.e, mv.e + 9, vectors);
+    }
+}
+
+void polar3(const float* in, float* r, float* s, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i, in += 9, r += 9, s += 9) {
+        jacobi3::mat3<scalar_lane> mr;
+        jacobi3::mat3<scalar_lane> ms;
+        jacobi3::polar<scalar_lane>(load_mat3(in), mr, ms);
+        std::copy(mr.e, mr.e + 9, r);
+        std::copy(ms.e, ms.e + 9, s);
+    }
+}
+
+std::size_t score_homography(const float* h, const float* sx, const float* sy, const float* dx,
+                             const float* dy, std::size_t n, float threshold2,
+                             std::uint64_t* inliers) noexcept {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (vision::detail::homography_inlier<scalar_lane>(h, sx[i], sy[i], dx[i], dy[i], threshold2)) {
+            if (inliers) {
+                inliers[i / 64] |= std::uint64_t{1} << (i % 64);
+            }
+            ++count;
+        }
+    }
+    return count;
+}
+
+std::size_t score_epipolar(const float* f, const float* sx, const float* sy, const float* dx,
+                           const float* dy, std::size_t n, float threshold2,
+                           std::uint64_t* inliers) noexcept {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (vision::detail::epipolar_inlier<scalar_lane>(f, sx[i], sy[i], dx[i], dy[i], threshold2)) {
+            if (inliers) {
+                inliers[i / 64] |= std::uint64_t{1} << (i % 64);
+            }
+            ++count;
+        }
+    }
+    return count;
+}
+
+std::size_t score_projection(const float* p, const float* x, const float* y, const float* z,
+                             const float* u, const float* v, std::size_t n, float threshold2,
+                             std::uint64_t* inliers) noexcept {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (vision::detail::projection_inlier<scalar_lane>(p, x[i], y[i], z[i], u[i], v[i], threshold2)) {
+            if (inliers) {
+                inliers[i / 64] |= std::uint64_t{1} << (i % 64);
+            }
+            ++count;
+        }
+    }
+    return count;
+}
+
+constexpr kernel_table table{"scalar", &transform3, &multiply4x4, &normalize3, &cull_spheres, &cull_aabbs,
+                             &slerp_quat, &nlerp_quat, &rotate3, &quat_to_mat4,
+                             &pack_half4, &pack_snorm16x4, &pack_unorm8x4, &pack_snorm10x3, &pack_oct16,
+                             &noise_row, &random_uniform, &random_unit3, &random_gaussian,
+                             &svd3, &eigen3, &polar3,
+                             &score_homography, &score_epipolar, &score_projection};
+
+} // namespace
+
+const kernel_table& scalar_kernels() noexcept {
+    return table;
+}
+
+} // namespace cc::batch::detail
@@ -0,0 +1,885 @@
+#include "kernels.hpp"
+#include "packing.hpp"
+#include "mat/jacobi3.hpp"
+#include "noise/lattice.hpp"
+#include "random/sampling.hpp"
+#include "vision/scoring.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if !defined(CC_MATH_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define CC_BATCH_SSE 1
+    #include <emmintrin.h>
+#endif
+
+namespace cc::batch::detail {
+
+#if defined(CC_BATCH_SSE)
+
+namespace {
+
+//NOTE: 4 packed xyz triples (x0y0z0x1 y1z1x2y2 z2x3y3z3) <-> x, y, z registers
+inline void load_xyz4(const float* p, __m128& x, __m128& y, __m128& z) noexcept {
+    const __m128 a  = _mm_loadu_ps(p);
+    const __m128 b  = _mm_loadu_ps(p + 4);
+    const __m128 c  = _mm_loadu_ps(p + 8);
+    const __m128 xy = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+    const __m128 yz = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+    x = _mm_shuffle_ps(a, xy, _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+    z = _mm_shuffle_ps(yz, c, _MM_SHUFFLE(3, 0, 3, 1));
+}
+
+inline void store_xyz4(float* p, __m128 x, __m128 y, __m128 z) noexcept {
+    const __m128 xy = _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 yz = _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+    const __m128 zx = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+    _mm_storeu_ps(p,     _mm_shuffle_ps(xy, zx, _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storeu_ps(p + 4, _mm_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0)));
+    _mm_storeu_ps(p + 8, _mm_shuffle_ps(zx, yz, _MM_SHUFFLE(3, 1, 3, 1)));
+}
+
+void transform3(const float* m, const float* in, float* out, std::size_t n, float w) noexcept {
+    const __m128 m00 = _mm_set1_ps(m[0]), m01 = _mm_set1_ps(m[4]), m02 = _mm_set1_ps(m[8]);
+    const __m128 m10 = _mm_set1_ps(m[1]), m11 = _mm_set1_ps(m[5]), m12 = _mm_set1_ps(m[9]);
+    const __m128 m20 = _mm_set1_ps(m[2]), m21 = _mm_set1_ps(m[6]), m22 = _mm_set1_ps(m[10]);
+    const __m128 t0  = _mm_set1_ps(m[12] * w);
+    const __m128 t1  = _mm_set1_ps(m[13] * w);
+    const __m128 t2  = _mm_set1_ps(m[14] * w);
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 x, y, z;
+        load_xyz4(in + i * 3, x, y, z);
+        const __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m01, y)),
+                                     _mm_add_ps(_mm_mul_ps(m02, z), t0));
+        const __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, x), _mm_mul_ps(m11, y)),
+                                     _mm_add_ps(_mm_mul_ps(m12, z), t1));
+        const __m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, x), _mm_mul_ps(m21, y)),
+                                     _mm_add_ps(_mm_mul_ps(m22, z), t2));
+        store_xyz4(out + i * 3, rx, ry, rz);
+    }
+    if (i < n) {
+        scalar_kernels().transform3(m, in + i * 3, out + i * 3, n - i, w);
+    }
+}
+
+[[nodiscard]] inline __m128 combine4(__m128 a0, __m128 a1, __m128 a2, __m128 a3, __m128 w) noexcept {
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, _mm_shuffle_ps(w, w, 0x00)),
+                                 _mm_mul_ps(a1, _mm_shuffle_ps(w, w, 0x55))),
+                      _mm_add_ps(_mm_mul_ps(a2, _mm_shuffle_ps(w, w, 0xAA)),
+                                 _mm_mul_ps(a3, _mm_shuffle_ps(w, w, 0xFF))));
+}
+
+void multiply4x4(const float* a, const float* b, float* out, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i, a += 16, b += 16, out += 16) {
+        const __m128 a0 = _mm_loadu_ps(a);
+        const __m128 a1 = _mm_loadu_ps(a + 4);
+        const __m128 a2 = _mm_loadu_ps(a + 8);
+        const __m128 a3 = _mm_loadu_ps(a + 12);
+
+        const __m128 r0 = combine4(a0, a1, a2, a3, _mm_loadu_ps(b));
+        const __m128 r1 = combine4(a0, a1, a2, a3, _mm_loadu_ps(b + 4));
+        const __m128 r2 = combine4(a0, a1, a2, a3, _mm_loadu_ps(b + 8));
+        const __m128 r3 = combine4(a0, a1, a2, a3, _mm_loadu_ps(b + 12));
+
+        _mm_storeu_ps(out, r0);
+        _mm_storeu_ps(out + 4, r1);
+        _mm_storeu_ps(out + 8, r2);
+        _mm_storeu_ps(out + 12, r3);
+    }
+}
+
+void normalize3(const float* in, float* out, std::size_t n) noexcept {
+    const __m128 zero = _mm_setzero_ps();
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 x, y, z;
+        load_xyz4(in + i * 3, x, y, z);
+        const __m128 l2   = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+        const __m128 l    = _mm_sqrt_ps(l2);
+        const __m128 mask = _mm_cmpgt_ps(l2, zero);
+        store_xyz4(out + i * 3,
+                   _mm_and_ps(_mm_div_ps(x, l), mask),
+                   _mm_and_ps(_mm_div_ps(y, l), mask),
+                   _mm_and_ps(_mm_div_ps(z, l), mask));
+    }
+    if (i < n) {
+        scalar_kernels().normalize3(in + i * 3, out + i * 3, n - i);
+    }
+}
+
+//NOTE: sets the 4 bits of elements [i, i + 4) from a lane mask, i is a multiple of 4
+inline std::size_t store_bits(__m128 inside, std::size_t i, std::uint64_t* visible) noexcept {
+    const auto bits = static_cast<std::uint64_t>(_mm_movemask_ps(inside));
+    visible[i / 64] |= bits << (i % 64);
+    return static_cast<std::size_t>(std::popcount(bits));
+}
+
+//NOTE: the tail is < 4 elements starting at a multiple of 4, so it never crosses a word
+inline void merge_tail(std::uint64_t tail, std::size_t i, std::uint64_t* visible) noexcept {
+    visible[i / 64] |= tail << (i % 64);
+}
+
+std::size_t cull_spheres(const float* planes, const float* x, const float* y, const float* z,
+                         const float* r, std::size_t n, std::uint64_t* visible) noexcept {
+    __m128 pa[6], pb[6], pc[6], pd[6];
+    for (int p = 0; p < 6; ++p) {
+        pa[p] = _mm_set1_ps(planes[p * 4]);
+        pb[p] = _mm_set1_ps(planes[p * 4 + 1]);
+        pc[p] = _mm_set1_ps(planes[p * 4 + 2]);
+        pd[p] = _mm_set1_ps(planes[p * 4 + 3]);
+    }
+
+    std::size_t count = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128 px = _mm_loadu_ps(x + i);
+        const __m128 py = _mm_loadu_ps(y + i);
+        const __m128 pz = _mm_loadu_ps(z + i);
+        const __m128 nr = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(r + i));
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p) {
+            const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(pa[p], px), _mm_mul_ps(pb[p], py)),
+                                           _mm_add_ps(_mm_mul_ps(pc[p], pz), pd[p]));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(dist, nr));
+        }
+        count += store_bits(inside, i, visible);
+    }
+    if (i < n) {
+        std::uint64_t tail = 0;
+        count += scalar_kernels().cull_spheres(planes, x + i, y + i, z + i, r + i, n - i, &tail);
+        merge_tail(tail, i, visible);
+    }
+    return count;
+}
+
+std::size_t cull_aabbs(const float* planes, const float* cx, const float* cy, const float* cz,
+                       const float* ex, const float* ey, const float* ez, std::size_t n,
+                       std::uint64_t* visible) noexcept {
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    __m128 pa[6], pb[6], pc[6], pd[6], aa[6], ab[6], ac[6];
+    for (int p = 0; p < 6; ++p) {
+        pa[p] = _mm_set1_ps(planes[p * 4]);
+        pb[p] = _mm_set1_ps(planes[p * 4 + 1]);
+        pc[p] = _mm_set1_ps(planes[p * 4 + 2]);
+        pd[p] = _mm_set1_ps(planes[p * 4 + 3]);
+        aa[p] = _mm_andnot_ps(sign, pa[p]);
+        ab[p] = _mm_andnot_ps(sign, pb[p]);
+        ac[p] = _mm_andnot_ps(sign, pc[p]);
+    }
+
+    std::size_t count = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128 px = _mm_loadu_ps(cx + i);
+        const __m128 py = _mm_loadu_ps(cy + i);
+        const __m128 pz = _mm_loadu_ps(cz + i);
+        const __m128 qx = _mm_loadu_ps(ex + i);
+        const __m128 qy = _mm_loadu_ps(ey + i);
+        const __m128 qz = _mm_loadu_ps(ez + i);
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p) {
+            const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(pa[p], px), _mm_mul_ps(pb[p], py)),
+                                           _mm_add_ps(_mm_mul_ps(pc[p], pz), pd[p]));
+            const __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(aa[p], qx), _mm_mul_ps(ab[p], qy)),
+                                             _mm_mul_ps(ac[p], qz));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(dist, radius), _mm_setzero_ps()));
+        }
+        count += store_bits(inside, i, visible);
+    }
+    if (i < n) {
+        std::uint64_t tail = 0;
+        count += scalar_kernels().cull_aabbs(planes, cx + i, cy + i, cz + i, ex + i, ey + i, ez + i, n - i, &tail);
+        merge_tail(tail, i, visible);
+    }
+    return count;
+}
+
+//NOTE: 4 packed xyzw quaternions <-> x, y, z, w registers
+struct quat4 {
+    __m128 x, y, z, w;
+};
+
+[[nodiscard]] inline quat4 load_quat4(const float* p) noexcept {
+    quat4 q{_mm_loadu_ps(p), _mm_loadu_ps(p + 4), _mm_loadu_ps(p + 8), _mm_loadu_ps(p + 12)};
+    _MM_TRANSPOSE4_PS(q.x, q.y, q.z, q.w);
+    return q;
+}
+
+inline void store_quat4(float* p, quat4 q) noexcept {
+    _MM_TRANSPOSE4_PS(q.x, q.y, q.z, q.w);
+    _mm_storeu_ps(p, q.x);
+    _mm_storeu_ps(p + 4, q.y);
+    _mm_storeu_ps(p + 8, q.z);
+    _mm_storeu_ps(p + 12, q.w);
+}
+
+[[nodiscard]] inline __m128 dot4(const quat4& a, const quat4& b) noexcept {
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a.x, b.x), _mm_mul_ps(a.y, b.y)),
+                      _mm_add_ps(_mm_mul_ps(a.z, b.z), _mm_mul_ps(a.w, b.w)));
+}
+
+[[nodiscard]] inline quat4 blend4(const quat4& a, __m128 wa, const quat4& b, __m128 wb) noexcept {
+    return {_mm_add_ps(_mm_mul_ps(wa, a.x), _mm_mul_ps(wb, b.x)),
+            _mm_add_ps(_mm_mul_ps(wa, a.y), _mm_mul_ps(wb, b.y)),
+            _mm_add_ps(_mm_mul_ps(wa, a.z), _mm_mul_ps(wb, b.z)),
+            _mm_add_ps(_mm_mul_ps(wa, a.w), _mm_mul_ps(wb, b.w))};
+}
+
+[[nodiscard]] inline __m128 slerp_weight4(__m128 t, __m128 xm1) noexcept {
+    const __m128 tt  = _mm_mul_ps(t, t);
+    const __m128 one = _mm_set1_ps(1.0f);
+    __m128 f = one;
+    for (int k = 7; k >= 0; --k) {
+        const __m128 c = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(_mm_set1_ps(slerp_u[k]), tt), _mm_set1_ps(slerp_v[k])), xm1);
+        f = _mm_add_ps(one, _mm_mul_ps(c, f));
+    }
+    return _mm_mul_ps(t, f);
+}
+
+void slerp_quat(const float* a, const float* b, const float* t, std::size_t t_step,
+                float* out, std::size_t n) noexcept {
+    //NOTE: the broadcast operand below is read before the loop; empty spans may pass null
+    if (n == 0) {
+        return;
+    }
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 one  = _mm_set1_ps(1.0f);
+    const __m128 t1   = _mm_set1_ps(*t);
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const quat4 qa = load_quat4(a + i * 4);
+        const quat4 qb = load_quat4(b + i * 4);
+        const __m128 tv = t_step ? _mm_loadu_ps(t + i) : t1;
+
+        const __m128 d   = dot4(qa, qb);
+        const __m128 neg = _mm_and_ps(d, sign);
+        const __m128 xm1 = _mm_sub_ps(_mm_andnot_ps(sign, d), one);
+        const __m128 wa  = slerp_weight4(_mm_sub_ps(one, tv), xm1);
+        const __m128 wb  = _mm_xor_ps(slerp_weight4(tv, xm1), neg);
+        store_quat4(out + i * 4, blend4(qa, wa, qb, wb));
+    }
+    if (i < n) {
+        scalar_kernels().slerp_quat(a + i * 4, b + i * 4, t + i * t_step, t_step, out + i * 4, n - i);
+    }
+}
+
+void nlerp_quat(const float* a, const float* b, const float* t, std::size_t t_step,
+                float* out, std::size_t n) noexcept {
+    if (n == 0) {
+        return;
+    }
+    const __m128 sign  = _mm_set1_ps(-0.0f);
+    const __m128 one   = _mm_set1_ps(1.0f);
+    const __m128 half  = _mm_set1_ps(0.5f);
+    const __m128 three = _mm_set1_ps(3.0f);
+    const __m128 t1    = _mm_set1_ps(*t);
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const quat4 qa = load_quat4(a + i * 4);
+        const quat4 qb = load_quat4(b + i * 4);
+        const __m128 tv = t_step ? _mm_loadu_ps(t + i) : t1;
+
+        const __m128 wb = _mm_xor_ps(tv, _mm_and_ps(dot4(qa, qb), sign));
+        const quat4 r   = blend4(qa, _mm_sub_ps(one, tv), qb, wb);
+
+        //NOTE: rsqrt estimate plus one Newton-Raphson step, ~1e-7 relative error
+        const __m128 l2  = dot4(r, r);
+        const __m128 est = _mm_rsqrt_ps(l2);
+        const __m128 inv = _mm_mul_ps(_mm_mul_ps(half, est),
+                                      _mm_sub_ps(three, _mm_mul_ps(_mm_mul_ps(l2, est), est)));
+        store_quat4(out + i * 4, {_mm_mul_ps(r.x, inv), _mm_mul_ps(r.y, inv),
+                                  _mm_mul_ps(r.z, inv), _mm_mul_ps(r.w, inv)});
+    }
+    if (i < n) {
+        scalar_kernels().nlerp_quat(a + i * 4, b + i * 4, t + i * t_step, t_step, out + i * 4, n - i);
+    }
+}
+
+void rotate3(const float* q, std::size_t q_step, const float* in, float* out, std::size_t n) noexcept {
+    if (n == 0) {
+        return;
+    }
+    const quat4 q1{_mm_set1_ps(q[0]), _mm_set1_ps(q[1]), _mm_set1_ps(q[2]), _mm_set1_ps(q[3])};
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const quat4 r = q_step ? load_quat4(q + i * 4) : q1;
+        __m128 x, y, z;
+        load_xyz4(in + i * 3, x, y, z);
+
+        const __m128 tx = _mm_sub_ps(_mm_mul_ps(r.y, z), _mm_mul_ps(r.z, y));
+        const __m128 ty = _mm_sub_ps(_mm_mul_ps(r.z, x), _mm_mul_ps(r.x, z));
+        const __m128 tz = _mm_sub_ps(_mm_mul_ps(r.x, y), _mm_mul_ps(r.y, x));
+        const __m128 ux = _mm_add_ps(tx, tx);
+        const __m128 uy = _mm_add_ps(ty, ty);
+        const __m128 uz = _mm_add_ps(tz, tz);
+
+        store_xyz4(out + i * 3,
+                   _mm_add_ps(_mm_add_ps(x, _mm_mul_ps(r.w, ux)), _mm_sub_ps(_mm_mul_ps(r.y, uz), _mm_mul_ps(r.z, uy))),
+                   _mm_add_ps(_mm_add_ps(y, _mm_mul_ps(r.w, uy)), _mm_sub_ps(_mm_mul_ps(r.z, ux), _mm_mul_ps(r.x, uz))),
+                   _mm_add_ps(_mm_add_ps(z, _mm_mul_ps(r.w, uz)), _mm_sub_ps(_mm_mul_ps(r.x, uy), _mm_mul_ps(r.y, ux))));
+    }
+    if (i < n) {
+        scalar_kernels().rotate3(q + i * 4 * q_step, q_step, in + i * 3, out + i * 3, n - i);
+    }
+}
+
+//NOTE: the 3x3 block is built for 4 quaternions at once, then each column is transposed back
+//      into the 4 matrices
+void quat_to_mat4(const float* q, float* out, std::size_t n) noexcept {
+    const __m128 one  = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 col3 = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const quat4 r = load_quat4(q + i * 4);
+        const __m128 l2 = dot4(r, r);
+        const __m128 s  = _mm_and_ps(_mm_div_ps(_mm_set1_ps(2.0f), l2), _mm_cmpgt_ps(l2, zero));
+
+        const __m128 sx = _mm_mul_ps(s, r.x);
+        const __m128 sy = _mm_mul_ps(s, r.y);
+        const __m128 sz = _mm_mul_ps(s, r.z);
+        const __m128 xx = _mm_mul_ps(sx, r.x), yy = _mm_mul_ps(sy, r.y), zz = _mm_mul_ps(sz, r.z);
+        const __m128 xy = _mm_mul_ps(sx, r.y), xz = _mm_mul_ps(sx, r.z), yz = _mm_mul_ps(sy, r.z);
+        const __m128 wx = _mm_mul_ps(sx, r.w), wy = _mm_mul_ps(sy, r.w), wz = _mm_mul_ps(sz, r.w);
+
+        __m128 c0[4] = {_mm_sub_ps(one, _mm_add_ps(yy, zz)), _mm_add_ps(xy, wz), _mm_sub_ps(xz, wy), zero};
+        __m128 c1[4] = {_mm_sub_ps(xy, wz), _mm_sub_ps(one, _mm_add_ps(xx, zz)), _mm_add_ps(yz, wx), zero};
+        __m128 c2[4] = {_mm_add_ps(xz, wy), _mm_sub_ps(yz, wx), _mm_sub_ps(one, _mm_add_ps(xx, yy)), zero};
+        _MM_TRANSPOSE4_PS(c0[0], c0[1], c0[2], c0[3]);
+        _MM_TRANSPOSE4_PS(c1[0], c1[1], c1[2], c1[3]);
+        _MM_TRANSPOSE4_PS(c2[0], c2[1], c2[2], c2[3]);
+
+        float* m = out + i * 16;
+        for (int k = 0; k < 4; ++k, m += 16) {
+            _mm_storeu_ps(m, c0[k]);
+            _mm_storeu_ps(m + 4, c1[k]);
+            _mm_storeu_ps(m + 8, c2[k]);
+            _mm_storeu_ps(m + 12, col3);
+        }
+    }
+    if (i < n) {
+        scalar_kernels().quat_to_mat4(q + i * 4, out + i * 16, n - i);
+    }
+}
+
+//NOTE: clamp to [lo, 1], scale and round to nearest-even; maxps returns lo for NaN
+[[nodiscard]] inline __m128i quantize4(__m128 v, __m128 lo, __m128 scale) noexcept {
+    return _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(v, lo), _mm_set1_ps(1.0f)), scale));
+}
+
+//NOTE: the integer conversion of packing.hpp (no F16C); the sign is or'ed in last, so each lane
+//      holds the half in its low 16 bits
+[[nodiscard]] inline __m128i to_half4(__m128 f) noexcept {
+    const __m128i f16max      = _mm_set1_epi32(static_cast<int>(half_overflow));
+    const __m128i min_normal  = _mm_set1_epi32(static_cast<int>(half_min_normal));
+    const __m128i denorm_bits = _mm_set1_epi32(static_cast<int>(half_denorm_magic));
+    const __m128i normal_bias = _mm_set1_epi32(static_cast<int>(half_normal_bias));
+
+    const __m128  sign = _mm_and_ps(f, _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000u))));
+    const __m128  absf = _mm_xor_ps(f, sign);
+    const __m128i bits = _mm_castps_si128(absf);
+
+    const __m128i nan     = _mm_and_si128(_mm_castps_si128(_mm_cmpunord_ps(absf, absf)), _mm_set1_epi32(0x200));
+    const __m128i special = _mm_or_si128(nan, _mm_set1_epi32(0x7c00));
+    const __m128i regular = _mm_cmpgt_epi32(f16max, bits);
+    const __m128i subnorm = _mm_cmpgt_epi32(min_normal, bits);
+
+    const __m128i denorm = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absf, _mm_castsi128_ps(denorm_bits))),
+                                         denorm_bits);
+    const __m128i odd    = _mm_srai_epi32(_mm_slli_epi32(bits, 31 - 13), 31);
+    const __m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(bits, normal_bias), odd), 13);
+
+    const __m128i finite = _mm_or_si128(_mm_and_si128(subnorm, denorm), _mm_andnot_si128(subnorm, normal));
+    const __m128i joined = _mm_or_si128(_mm_and_si128(regular, finite), _mm_andnot_si128(regular, special));
+    return _mm_or_si128(joined, _mm_srli_epi32(_mm_castps_si128(sign), 16));
+}
+
+//NOTE: 4 lanes of 16-bit x, y, z, w (low halves of 32-bit lanes) -> 4 packed xyzw quadruples
+inline void store_u16x4(std::uint16_t* p, __m128i x, __m128i y, __m128i z, __m128i w) noexcept {
+    const __m128i mask = _mm_set1_epi32(0xffff);
+    const __m128i xy = _mm_or_si128(_mm_and_si128(x, mask), _mm_slli_epi32(y, 16));
+    const __m128i zw = _mm_or_si128(_mm_and_si128(z, mask), _mm_slli_epi32(w, 16));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p),     _mm_unpacklo_epi32(xy, zw));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p + 8), _mm_unpackhi_epi32(xy, zw));
+}
+
+void pack_half4(const float* in, std::uint16_t* out, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 x, y, z;
+        load_xyz4(in + i * 3, x, y, z);
+        store_u16x4(out + i * 4, to_half4(x), to_half4(y), to_half4(z), _mm_setzero_si128());
+    }
+    if (i < n) {
+        scalar_kernels().pack_half4(in + i * 3, out + i * 4, n - i);
+    }
+}
+
+void pack_snorm16x4(const float* in, std::uint16_t* out, std::size_t n) noexcept {
+    const __m128 lo    = _mm_set1_ps(-1.0f);
+    const __m128 scale = _mm_set1_ps(32767.0f);
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 x, y, z;
+        load_xyz4(in + i * 3, x, y, z);
+        store_u16x4(out + i * 4, quantize4(x, lo, scale), quantize4(y, lo, scale), quantize4(z, lo, scale),
+                    _mm_setzero_si128());
+    }
+    if (i < n) {
+        scalar_kernels().pack_snorm16x4(in + i * 3, out + i * 4, n - i);
+    }
+}
+
+void pack_unorm8x4(const float* in, std::uint32_t* out, std::size_t n) noexcept {
+    const __m128  lo    = _mm_setzero_ps();
+    const __m128  scale = _mm_set1_ps(255.0f);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xff000000u));
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 x, y, z;
+        load_xyz4(in + i * 3, x, y, z);
+        const __m128i xy = _mm_or_si128(quantize4(x, lo, scale), _mm_slli_epi32(quantize4(y, lo, scale), 8));
+        const __m128i za = _mm_or_si128(_mm_slli_epi32(quantize4(z, lo, scale), 16), alpha);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_or_si128(xy, za));
+    }
+    if (i < n) {
+        scalar_kernels().pack_unorm8x4(in + i * 3, out + i, n - i);
+    }
+}
+
+void pack_snorm10x3(const float* in, std::uint32_t* out, std::size_t n) noexcept {
+    const __m128  lo    = _mm_set1_ps(-1.0f);
+    const __m128  scale = _mm_set1_ps(511.0f);
+    const __m128i mask  = _mm_set1_epi32(0x3ff);
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 x, y, z;
+        load_xyz4(in + i * 3, x, y, z);
+        const __m128i px = _mm_and_si128(quantize4(x, lo, scale), mask);
+        const __m128i py = _mm_slli_epi32(_mm_and_si128(quantize4(y, lo, scale), mask), 10);
+        const __m128i pz = _mm_slli_epi32(_mm_and_si128(quantize4(z, lo, scale), mask), 20);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_or_si128(_mm_or_si128(px, py), pz));
+    }
+    if (i < n) {
+        scalar_kernels().pack_snorm10x3(in + i * 3, out + i, n - i);
+    }
+}
+
+void pack_oct16(const float* in, std::uint32_t* out, std::size_t n) noexcept {
+    const __m128  sign  = _mm_set1_ps(-0.0f);
+    const __m128  one   = _mm_set1_ps(1.0f);
+    const __m128  zero  = _mm_setzero_ps();
+    const __m128  lo    = _mm_set1_ps(-1.0f);
+    const __m128  scale = _mm_set1_ps(32767.0f);
+    const __m128i mask  = _mm_set1_epi32(0xffff);
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 x, y, z;
+        load_xyz4(in + i * 3, x, y, z);
+        const __m128 l1    = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(sign, x), _mm_andnot_ps(sign, y)),
+                                        _mm_andnot_ps(sign, z));
+        const __m128 valid = _mm_cmpgt_ps(l1, zero);
+        const __m128 ox    = _mm_and_ps(_mm_div_ps(x, l1), valid);
+        const __m128 oy    = _mm_and_ps(_mm_div_ps(y, l1), valid);
+
+        //NOTE: lower hemisphere folds over the diagonals, sign(0) counts as +1 like copysign
+        const __m128 fx    = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(sign, oy)), _mm_or_ps(_mm_and_ps(ox, sign), one));
+        const __m128 fy    = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(sign, ox)), _mm_or_ps(_mm_and_ps(oy, sign), one));
+        const __m128 below = _mm_cmplt_ps(z, zero);
+        const __m128 ex    = _mm_or_ps(_mm_and_ps(below, fx), _mm_andnot_ps(below, ox));
+        const __m128 ey    = _mm_or_ps(_mm_and_ps(below, fy), _mm_andnot_ps(below, oy));
+
+        const __m128i packed = _mm_or_si128(_mm_and_si128(quantize4(ex, lo, scale), mask),
+                                            _mm_slli_epi32(quantize4(ey, lo, scale), 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+    }
+    if (i < n) {
+        scalar_kernels().pack_oct16(in + i * 3, out + i, n - i);
+    }
+}
+
+//NOTE: lane for the shared kernels (cc/math/detail/lane.hpp); SSE2 has neither a 32-bit
+//      multiply nor floor, both are built from wider operations
+struct sse_u32 {
+    __m128i v;
+
+    sse_u32() noexcept : v(_mm_setzero_si128()) {}
+    sse_u32(__m128i v_) noexcept : v(v_) {}
+    sse_u32(std::uint32_t s) noexcept : v(_mm_set1_epi32(static_cast<int>(s))) {}
+};
+
+struct sse_f32 {
+    __m128 v;
+
+    sse_f32() noexcept : v(_mm_setzero_ps()) {}
+    sse_f32(__m128 v_) noexcept : v(v_) {}
+    sse_f32(float s) noexcept : v(_mm_set1_ps(s)) {}
+};
+
+struct sse_mask {
+    __m128 v;
+};
+
+inline sse_f32 operator+(sse_f32 a, sse_f32 b) noexcept { return _mm_add_ps(a.v, b.v); }
+inline sse_f32 operator-(sse_f32 a, sse_f32 b) noexcept { return _mm_sub_ps(a.v, b.v); }
+inline sse_f32 operator*(sse_f32 a, sse_f32 b) noexcept { return _mm_mul_ps(a.v, b.v); }
+inline sse_f32 operator/(sse_f32 a, sse_f32 b) noexcept { return _mm_div_ps(a.v, b.v); }
+inline sse_f32 operator-(sse_f32 a) noexcept { return _mm_xor_ps(a.v, _mm_set1_ps(-0.0f)); }
+
+inline sse_u32 operator+(sse_u32 a, sse_u32 b) noexcept { return _mm_add_epi32(a.v, b.v); }
+inline sse_u32 operator^(sse_u32 a, sse_u32 b) noexcept { return _mm_xor_si128(a.v, b.v); }
+inline sse_u32 operator&(sse_u32 a, sse_u32 b) noexcept { return _mm_and_si128(a.v, b.v); }
+inline sse_u32 operator|(sse_u32 a, sse_u32 b) noexcept { return _mm_or_si128(a.v, b.v); }
+inline sse_u32 operator<<(sse_u32 a, int s) noexcept { return _mm_slli_epi32(a.v, s); }
+inline sse_u32 operator>>(sse_u32 a, int s) noexcept { return _mm_srli_epi32(a.v, s); }
+inline sse_u32 operator*(sse_u32 a, sse_u32 b) noexcept {
+    const __m128i even = _mm_mul_epu32(a.v, b.v);
+    const __m128i odd  = _mm_mul_epu32(_mm_srli_epi64(a.v, 32), _mm_srli_epi64(b.v, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+struct sse_lane {
+    using f = sse_f32;
+    using u = sse_u32;
+    using m = sse_mask;
+
+    //NOTE: truncate, then step down where that rounded up (negative non-integers)
+    static f floor(f x) noexcept {
+        const __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(x.v));
+        return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, x.v), _mm_set1_ps(1.0f)));
+    }
+    static f sqrt(f x) noexcept { return _mm_sqrt_ps(x.v); }
+    static f max(f a, f b) noexcept { return _mm_max_ps(a.v, b.v); }
+
+    static u to_u(f x) noexcept { return _mm_cvttps_epi32(x.v); }
+    static f to_f(u x) noexcept { return _mm_cvtepi32_ps(x.v); }
+    static u as_u(f x) noexcept { return _mm_castps_si128(x.v); }
+    static f as_f(u x) noexcept { return _mm_castsi128_ps(x.v); }
+
+    static m gt(f a, f b) noexcept { return {_mm_cmpgt_ps(a.v, b.v)}; }
+    static m ge(f a, f b) noexcept { return {_mm_cmpge_ps(a.v, b.v)}; }
+    static m lt(u a, u b) noexcept { return {_mm_castsi128_ps(_mm_cmplt_epi32(a.v, b.v))}; }
+    //NOTE: b is a single bit
+    static m bit(u a, u b) noexcept { return {_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(a.v, b.v), b.v))}; }
+
+    static m mask_and(m a, m b) noexcept { return {_mm_and_ps(a.v, b.v)}; }
+    static m mask_or(m a, m b) noexcept { return {_mm_or_ps(a.v, b.v)}; }
+    static m mask_not(m a) noexcept { return {_mm_xor_ps(a.v, _mm_castsi128_ps(_mm_set1_epi32(-1)))}; }
+
+    static f select(m c, f a, f b) noexcept { return _mm_or_ps(_mm_and_ps(c.v, a.v), _mm_andnot_ps(c.v, b.v)); }
+    static u select(m c, u a, u b) noexcept {
+        const __m128i mask = _mm_castps_si128(c.v);
+        return _mm_or_si128(_mm_and_si128(mask, a.v), _mm_andnot_si128(mask, b.v));
+    }
+};
+
+void noise_row(const noise::detail::fbm_desc& desc, float x0, float dx, float y, float z,
+               float* out, std::size_t n) noexcept {
+    const __m128 iota = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    for (std::size_t i = 0; i < n; i += 4) {
+        const __m128 index = _mm_add_ps(_mm_set1_ps(static_cast<float>(i)), iota);
+        const sse_f32 x = _mm_add_ps(_mm_set1_ps(x0), _mm_mul_ps(index, _mm_set1_ps(dx)));
+        const sse_f32 r = noise::detail::fbm<sse_lane>(desc, x, y, z, 0.0f);
+        //NOTE: the last partial group is evaluated in full and only the valid lanes are kept
+        if (i + 4 <= n) {
+            _mm_storeu_ps(out + i, r.v);
+        } else {
+            alignas(16) float tail[4];
+            _mm_store_ps(tail, r.v);
+            for (std::size_t j = i; j < n; ++j) {
+                out[j] = tail[j - i];
+            }
+        }
+    }
+}
+
+template<int K>
+inline __m128i rotl64(__m128i x) noexcept {
+    return _mm_or_si128(_mm_slli_epi64(x, K), _mm_srli_epi64(x, 64 - K));
+}
+
+//NOTE: the eight xoshiro256++ streams as two-lane 64-bit registers, s[k][p] holding word k of
+//      streams 2p and 2p + 1
+struct sse_xoshiro {
+    __m128i s[4][4];
+
+    explicit sse_xoshiro(const std::uint64_t* state) noexcept {
+        for (int k = 0; k < 4; ++k) {
+            for (int p = 0; p < 4; ++p) {
+                s[k][p] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + k * 8 + p * 2));
+            }
+        }
+    }
+
+    void store(std::uint64_t* state) const noexcept {
+        for (int k = 0; k < 4; ++k) {
+            for (int p = 0; p < 4; ++p) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(state + k * 8 + p * 2), s[k][p]);
+            }
+        }
+    }
+
+    //NOTE: hi[h] / lo[h] get the upper / lower 32 bits of the outputs of streams 4h to 4h + 3
+    void step(sse_u32* hi, sse_u32* lo) noexcept {
+        __m128 r[4];
+        for (int p = 0; p < 4; ++p) {
+            r[p] = _mm_castsi128_ps(_mm_add_epi64(rotl64<23>(_mm_add_epi64(s[0][p], s[3][p])), s[0][p]));
+            const __m128i t = _mm_slli_epi64(s[1][p], 17);
+            s[2][p] = _mm_xor_si128(s[2][p], s[0][p]);
+            s[3][p] = _mm_xor_si128(s[3][p], s[1][p]);
+            s[1][p] = _mm_xor_si128(s[1][p], s[2][p]);
+            s[0][p] = _mm_xor_si128(s[0][p], s[3][p]);
+            s[2][p] = _mm_xor_si128(s[2][p], t);
+            s[3][p] = rotl64<45>(s[3][p]);
+        }
+        for (int h = 0; h < 2; ++h) {
+            hi[h] = _mm_castps_si128(_mm_shuffle_ps(r[2 * h], r[2 * h + 1], _MM_SHUFFLE(3, 1, 3, 1)));
+            lo[h] = _mm_castps_si128(_mm_shuffle_ps(r[2 * h], r[2 * h + 1], _MM_SHUFFLE(2, 0, 2, 0)));
+        }
+    }
+};
+
+//NOTE: whole steps are stored directly, a partial last one goes through a buffer
+void random_uniform(std::uint64_t* state, float* out, std::size_t n, float lo, float scale) noexcept {
+    sse_xoshiro rng(state);
+    const sse_f32 offset = lo;
+    const sse_f32 factor = scale;
+    alignas(16) float tail[16];
+    for (std::size_t i = 0; i < n; i += 16) {
+        sse_u32 hi[2];
+        sse_u32 lw[2];
+        rng.step(hi, lw);
+        float* dst = i + 16 <= n ? out + i : tail;
+        for (int h = 0; h < 2; ++h) {
+            _mm_storeu_ps(dst + 4 * h, (offset + factor * random::detail::uniform01<sse_lane>(hi[h])).v);
+            _mm_storeu_ps(dst + 8 + 4 * h, (offset + factor * random::detail::uniform01<sse_lane>(lw[h])).v);
+        }
+        if (dst == tail) {
+            std::memcpy(out + i, tail, (n - i) * sizeof(float));
+        }
+    }
+    rng.store(state);
+}
+
+void random_unit3(std::uint64_t* state, float* out, std::size_t n) noexcept {
+    sse_xoshiro rng(state);
+    alignas(16) float tail[24];
+    for (std::size_t i = 0; i < n; i += 8) {
+        sse_u32 hi[2];
+        sse_u32 lw[2];
+        rng.step(hi, lw);
+        float* dst = i + 8 <= n ? out + i * 3 : tail;
+        for (int h = 0; h < 2; ++h) {
+            sse_f32 x;
+            sse_f32 y;
+            sse_f32 z;
+            random::detail::unit_vector<sse_lane>(hi[h], lw[h], x, y, z);
+            store_xyz4(dst + 12 * h, x.v, y.v, z.v);
+        }
+        if (dst == tail) {
+            std::memcpy(out + i * 3, tail, (n - i) * 3 * sizeof(float));
+        }
+    }
+    rng.store(state);
+}
+
+void random_gaussian(std::uint64_t* state, float* out, std::size_t n, float mean, float stddev) noexcept {
+    sse_xoshiro rng(state);
+    const sse_f32 offset = mean;
+    const sse_f32 factor = stddev;
+    alignas(16) float tail[16];
+    for (std::size_t i = 0; i < n; i += 16) {
+        sse_u32 hi[2];
+        sse_u32 lw[2];
+        rng.step(hi, lw);
+        float* dst = i + 16 <= n ? out + i : tail;
+        for (int h = 0; h < 2; ++h) {
+            sse_f32 g0;
+            sse_f32 g1;
+            random::detail::gaussian_pair<sse_lane>(hi[h], lw[h], g0, g1);
+            _mm_storeu_ps(dst + 4 * h, (offset + factor * g0).v);
+            _mm_storeu_ps(dst + 8 + 4 * h, (offset + factor * g1).v);
+        }
+        if (dst == tail) {
+            std::memcpy(out + i, tail, (n - i) * sizeof(float));
+        }
+    }
+    rng.store(state);
+}
+
+namespace jacobi3 = cc::detail::jacobi3;
+
+//NOTE: up to 4 packed 3x3 matrices <-> one register per element; short groups are padded with
+//      zero matrices, which decompose without NaNs
+jacobi3::mat3<sse_lane> load_mat3x4(const float* p, std::size_t count) noexcept {
+    alignas(16) float t[9][4] = {};
+    for (std::size_t j = 0; j < count; ++j) {
+        for (int e = 0; e < 9; ++e) {
+            t[e][j] = p[j * 9 + e];
+        }
+    }
+    jacobi3::mat3<sse_lane> m;
+    for (int e = 0; e < 9; ++e) {
+        m.e[e] = _mm_load_ps(t[e]);
+    }
+    return m;
+}
+
+template<int N>
+void store_lanes(float* p, const sse_f32* v, std::size_t count) noexcept {
+    alignas(16) float t[N][4];
+    for (int e = 0; e < N; ++e) {
+        _mm_store_ps(t[e], v[e].v);
+    }
+    for (std::size_t j = 0; j < count; ++j) {
+        for (int e = 0; e < N; ++e) {
+            p[j * N + e] = t[e][j];
+        }
+    }
+}
+
+void svd3(const float* in, float* u, float* s, float* v, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; i += 4) {
+        const std::size_t count = std::min<std::size_t>(n - i, 4);
+        jacobi3::mat3<sse_lane> mu;
+        jacobi3::mat3<sse_lane> mv;
+        sse_f32 sigma[3];
+        jacobi3::svd<sse_lane>(load_mat3x4(in + i * 9, count), mu, sigma, mv);
+        store_lanes<9>(u + i * 9, mu.e, count);
+        store_lanes<3>(s + i * 3, sigma, count);
+        store_lanes<9>(v + i * 9, mv.e, count);
+    }
+}
+
+void eigen3(const float* in, float* values, float* vectors, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; i += 4) {
+        const std::size_t count = std::min<std::size_t>(n - i, 4);
+        jacobi3::mat3<sse_lane> mv;
+        sse_f32 lambda[3];
+        jacobi3::eigen_symmetric<sse_lane>(load_mat3x4(in + i * 9, count), lambda, mv);
+        store_lanes<3>(values + i * 3, lambda, count);
+        store_lanes<9>(vectors + i * 9, mv.e, count);
+    }
+}
+
+void polar3(const float* in, float* r, float* s, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; i += 4) {
+        const std::size_t count = std::min<std::size_t>(n - i, 4);
+        jacobi3::mat3<sse_lane> mr;
+        jacobi3::mat3<sse_lane> ms;
+        jacobi3::polar<sse_lane>(load_mat3x4(in + i * 9, count), mr, ms);
+        store_lanes<9>(r + i * 9, mr.e, count);
+        store_lanes<9>(s + i * 9, ms.e, count);
+    }
+}
+
+//NOTE: bits and count of the 4 elements starting at i; inliers may be null
+inline std::size_t store_inliers(sse_mask inside, std::size_t i, std::uint64_t* inliers) noexcept {
+    const auto bits = static_cast<std::uint64_t>(_mm_movemask_ps(inside.v));
+    if (inliers) {
+        inliers[i / 64] |= bits << (i % 64);
+    }
+    return static_cast<std::size_t>(std::popcount(bits));
+}
+
+std::size_t score_homography(const float* h, const float* sx, const float* sy, const float* dx,
+                             const float* dy, std::size_t n, float threshold2,
+                             std::uint64_t* inliers) noexcept {
+    std::size_t count = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const sse_mask inside = vision::detail::homography_inlier<sse_lane>(
+            h, _mm_loadu_ps(sx + i), _mm_loadu_ps(sy + i), _mm_loadu_ps(dx + i), _mm_loadu_ps(dy + i), threshold2);
+        count += store_inliers(inside, i, inliers);
+    }
+    if (i < n) {
+        std::uint64_t tail = 0;
+        count += scalar_kernels().score_homography(h, sx + i, sy + i, dx + i, dy + i, n - i, threshold2,
+                                                   inliers ? &tail : nullptr);
+        if (inliers) {
+            merge_tail(tail, i, inliers);
+        }
+    }
+    return count;
+}
+
+std::size_t score_epipolar(const float* f, const float* sx, const float* sy, const float* dx,
+                           const float* dy, std::size_t n, float threshold2,
+                           std::uint64_t* inliers) noexcept {
+    std::size_t count = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const sse_mask inside = vision::detail::epipolar_inlier<sse_lane>(
+            f, _mm_loadu_ps(sx + i), _mm_loadu_ps(sy + i), _mm_loadu_ps(dx + i), _mm_loadu_ps(dy + i), threshold2);
+        count += store_inliers(inside, i, inliers);
+    }
+    if (i < n) {
+        std::uint64_t tail = 0;
+        count += scalar_kernels().score_epipolar(f, sx + i, sy + i, dx + i, dy + i, n - i, threshold2,
+                                                 inliers ? &tail : nullptr);
+        if (inliers) {
+            merge_tail(tail, i, inliers);
+        }
+    }
+    return count;
+}
+
+std::size_t score_projection(const float* p, const float* x, const float* y, const float* z,
+                             const float* u, const float* v, std::size_t n, float threshold2,
+                             std::uint64_t* inliers) noexcept {
+    std::size_t count = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const sse_mask inside = vision::detail::projection_inlier<sse_lane>(
+            p, _mm_loadu_ps(x + i), _mm_loadu_ps(y + i), _mm_loadu_ps(z + i), _mm_loadu_ps(u + i), _mm_loadu_ps(v + i), threshold2);
+        count += store_inliers(inside, i, inliers);
+    }
+    if (i < n) {
+        std::uint64_t tail = 0;
+        count += scalar_kernels().score_projection(p, x + i, y + i, z + i, u + i, v + i, n - i, threshold2,
+                                                   inliers ? &tail : nullptr);
+        if (inliers) {
+            merge_tail(tail, i, inliers);
+        }
+    }
+    return count;
+}
+
+constexpr kernel_table table{"sse", &transform3, &multiply4x4, &normalize3, &cull_spheres, &cull_aabbs,
+                             &slerp_quat, &nlerp_quat, &rotate3, &quat_to_mat4,
+                             &pack_half4, &pack_snorm16x4, &pack_unorm8x4, &pack_snorm10x3, &pack_oct16,
+                             &noise_row, &random_uniform, &random_unit3, &random_gaussian,
+                             &svd3, &eigen3, &polar3,
+                             &score_homography, &score_epipolar, &score_projection};
+
+} // namespace
+
+const kernel_table* sse_kernels() noexcept {
+    return &table;
+}
+
+#else
+
+const kernel_table* sse_kernels() noexcept {
+    return nullptr;
+}
+
+#endif
+
+} // namespace cc::batch::detail
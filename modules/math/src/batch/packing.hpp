@@ -0,0 +1,26 @@
+#pragma once
+
+#include "packing/packing.hpp"
+
+#include <cstdint>
+
+//NOTE: shared by the packing kernels of every ISA. The scalar converters are the ones in
+//      cc/math/packing/packing.hpp; the SSE and AVX2 versions build the same bits from the
+//      constants below (Giesen's round-to-nearest-even float -> half with integer ops).
+namespace cc::batch::detail {
+
+inline constexpr std::uint32_t half_overflow     = (127 + 16) << 23;                        // 65520.0f
+inline constexpr std::uint32_t half_min_normal   = (127 - 14) << 23;                        // 2^-14
+inline constexpr std::uint32_t half_denorm_magic = ((127 - 15) + (23 - 10) + 1) << 23;      // 0.5f
+inline constexpr std::uint32_t half_normal_bias  = 0xfffu - ((127u - 15u) << 23);           // wraps
+
+[[nodiscard]] inline std::uint16_t to_half(float value) noexcept {
+    return half::from_float(value);
+}
+
+//NOTE: clamp to [lo, 1], scale and round to nearest-even; NaN clamps to lo like maxps
+[[nodiscard]] inline std::int32_t quantize(float value, float lo, float scale) noexcept {
+    return cc::detail::quantize(value, lo, scale);
+}
+
+} // namespace cc::batch::detail
@@ -1,3 +0,0 @@
-namespace cc{
-    void dummy(){};
-}
@@ -0,0 +1,52 @@
+#include "noise/noise.hpp"
+#include "batch/kernels.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+namespace cc::noise {
+
+namespace {
+
+//NOTE: samples per thread below which splitting a grid costs more than it saves (about one
+//      octave of a 128x128 tile)
+constexpr std::size_t MinSamplesPerThread = std::size_t{1} << 14;
+
+} // namespace
+
+void fill_grid(std::span<float> out, std::size_t width, std::size_t height, const grid_params& params) {
+    assert(out.size() == width * height);
+    if (width == 0 || height == 0) {
+        return;
+    }
+
+    const detail::fbm_desc desc = detail::make_desc(params.type, params.slice ? 3 : 2, params.fbm);
+    const float z = params.slice.value_or(0.0f);
+    const batch::detail::kernel_table& kernels = batch::detail::active_kernels();
+
+    const auto rows = [&](std::size_t first, std::size_t last) {
+        for (std::size_t y = first; y < last; ++y) {
+            const float py = params.origin.y + static_cast<float>(y) * params.step.y;
+            kernels.noise_row(desc, params.origin.x, params.step.x, py, z, out.data() + y * width, width);
+        }
+    };
+
+    const std::size_t samples = width * height * std::max<std::size_t>(params.fbm.octaves, 1);
+    const std::size_t requested = params.threads != 0
+        ? params.threads
+        : std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t workers = std::min({requested, height, std::max<std::size_t>(samples / MinSamplesPerThread, 1)});
+
+    //NOTE: contiguous bands of rows; the calling thread takes the first band
+    const std::size_t band = (height + workers - 1) / workers;
+    std::vector<std::jthread> threads;
+    threads.reserve(workers - 1);
+    for (std::size_t first = band; first < height; first += band) {
+        threads.emplace_back(rows, first, std::min(first + band, height));
+    }
+    rows(0, std::min(band, height));
+}
+
+} // namespace cc::noise
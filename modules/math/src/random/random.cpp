@@ -0,0 +1,21 @@
+#include "random/random.hpp"
+#include "batch/kernels.hpp"
+
+namespace cc::random {
+
+void fill_uniform(xoshiro256pp_x8& rng, std::span<float> out, float lo, float hi) noexcept {
+    batch::detail::active_kernels().random_uniform(rng.state().data(), out.data(), out.size(), lo, hi - lo);
+}
+
+void fill_unit_vectors(xoshiro256pp_x8& rng, std::span<vec<3, float>> out) noexcept {
+    //NOTE: written as packed xyz triples
+    static_assert(sizeof(vec<3, float>) == 3 * sizeof(float));
+    batch::detail::active_kernels().random_unit3(rng.state().data(), reinterpret_cast<float*>(out.data()),
+                                                 out.size());
+}
+
+void fill_gaussian(xoshiro256pp_x8& rng, std::span<float> out, float mean, float stddev) noexcept {
+    batch::detail::active_kernels().random_gaussian(rng.state().data(), out.data(), out.size(), mean, stddev);
+}
+
+} // namespace cc::random
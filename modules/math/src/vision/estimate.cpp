@@ -0,0 +1,397 @@
+#include "vision/estimate.hpp"
+#include "mat/decompose.hpp"
+#include "mat/solve.hpp"
+
+#include <array>
+#include <cmath>
+
+namespace cc::vision {
+
+namespace {
+
+using mat3d = mat<3, 3, double>;
+
+//NOTE: Hartley normalization: centroid to the origin, mean distance to it sqrt(2)
+struct normalization2 {
+    double cx;
+    double cy;
+    double scale;
+
+    [[nodiscard]] std::array<double, 2> apply(const vec<2, float>& p) const noexcept {
+        return {(p.x - cx) * scale, (p.y - cy) * scale};
+    }
+
+    [[nodiscard]] mat3d matrix() const noexcept {
+        mat3d m = mat3d::identity();
+        m(0, 0) = scale;
+        m(1, 1) = scale;
+        m(0, 2) = -scale * cx;
+        m(1, 2) = -scale * cy;
+        return m;
+    }
+
+    [[nodiscard]] mat3d inverse() const noexcept {
+        mat3d m = mat3d::identity();
+        m(0, 0) = 1.0 / scale;
+        m(1, 1) = 1.0 / scale;
+        m(0, 2) = cx;
+        m(1, 2) = cy;
+        return m;
+    }
+};
+
+[[nodiscard]] std::optional<normalization2> normalize(std::span<const vec<2, float>> points) noexcept {
+    double cx = 0.0;
+    double cy = 0.0;
+    for (const vec<2, float>& p : points) {
+        cx += p.x;
+        cy += p.y;
+    }
+    cx /= static_cast<double>(points.size());
+    cy /= static_cast<double>(points.size());
+
+    double spread = 0.0;
+    for (const vec<2, float>& p : points) {
+        spread += std::hypot(p.x - cx, p.y - cy);
+    }
+    spread /= static_cast<double>(points.size());
+    if (!(spread > 0.0)) {
+        return std::nullopt;
+    }
+    return normalization2{cx, cy, std::sqrt(2.0) / spread};
+}
+
+//NOTE: the points, normalized by n, lie on one line: the smaller principal variance vanishes
+//      against the larger
+[[nodiscard]] bool collinear(std::span<const vec<2, float>> points, const normalization2& n) noexcept {
+    double sxx = 0.0;
+    double sxy = 0.0;
+    double syy = 0.0;
+    for (const vec<2, float>& p : points) {
+        const auto [x, y] = n.apply(p);
+        sxx += x * x;
+        sxy += x * y;
+        syy += y * y;
+    }
+    const double trace = sxx + syy;
+    const double gap = std::sqrt((sxx - syy) * (sxx - syy) + 4.0 * sxy * sxy);
+    return !(trace - gap > 1e-8 * trace);
+}
+
+//NOTE: m += row * row^T on the lower triangle; mirror_lower() completes m once all rows are in
+template<std::size_t N>
+void accumulate(mat<N, N, double>& m, const std::array<double, N>& row) noexcept {
+    for (std::size_t c = 0; c < N; ++c) {
+        if (row[c] == 0.0) {
+            continue;
+        }
+        for (std::size_t r = c; r < N; ++r) {
+            m(r, c) += row[r] * row[c];
+        }
+    }
+}
+
+template<std::size_t N>
+void mirror_lower(mat<N, N, double>& m) noexcept {
+    for (std::size_t c = 0; c < N; ++c) {
+        for (std::size_t r = c + 1; r < N; ++r) {
+            m(c, r) = m(r, c);
+        }
+    }
+}
+
+//NOTE: unit eigenvector of the smallest eigenvalue of a symmetric positive semi-definite m, i.e.
+//      the least-squares null vector of the rows accumulated into it. Inverse iteration on m
+//      shifted just enough to stay regular when the null space is exact
+template<std::size_t N>
+[[nodiscard]] std::optional<vec<N, double>> smallest_eigenvector(mat<N, N, double> m) noexcept {
+    double trace = 0.0;
+    for (std::size_t i = 0; i < N; ++i) {
+        trace += m(i, i);
+    }
+    if (!(trace > 0.0)) {
+        return std::nullopt;
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        m(i, i) += 1e-10 * trace;
+    }
+    const auto f = lu(m);
+    if (!f) {
+        return std::nullopt;
+    }
+
+    vec<N, double> x;
+    for (std::size_t i = 0; i < N; ++i) {
+        x[i] = 1.0 / static_cast<double>(i + 1);
+    }
+    for (int iteration = 0; iteration < 6; ++iteration) {
+        x = solve(*f, x);
+        x /= x.length();
+    }
+    return x;
+}
+
+//NOTE: the 3x3 matrix whose rows are h[0..2], h[3..5], h[6..8]
+[[nodiscard]] mat3d from_rows(const vec<9, double>& h) noexcept {
+    mat3d m;
+    for (std::size_t r = 0; r < 3; ++r) {
+        for (std::size_t c = 0; c < 3; ++c) {
+            m(r, c) = h[r * 3 + c];
+        }
+    }
+    return m;
+}
+
+[[nodiscard]] double frobenius(const mat3d& m) noexcept {
+    double sum = 0.0;
+    for (std::size_t i = 0; i < 9; ++i) {
+        sum += m.data()[i] * m.data()[i];
+    }
+    return std::sqrt(sum);
+}
+
+//NOTE: the 8-point system in normalized coordinates; f maps src to epipolar lines in dst
+[[nodiscard]] std::optional<mat3d> epipolar_dlt(std::span<const vec<2, float>> src,
+                                                std::span<const vec<2, float>> dst) noexcept {
+    const std::size_t n = src.size();
+    if (n < 8 || dst.size() != n) {
+        return std::nullopt;
+    }
+    const auto ns = normalize(src);
+    const auto nd = normalize(dst);
+    if (!ns || !nd) {
+        return std::nullopt;
+    }
+
+    mat<9, 9, double> m(0.0);
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto [x, y] = ns->apply(src[i]);
+        const auto [u, v] = nd->apply(dst[i]);
+        accumulate<9>(m, {u * x, u * y, u, v * x, v * y, v, x, y, 1.0});
+    }
+    mirror_lower(m);
+
+    const auto f = smallest_eigenvector(m);
+    if (!f) {
+        return std::nullopt;
+    }
+
+    //NOTE: closest rank-2 matrix, then back to pixel coordinates
+    svd_result<double> d = svd(from_rows(*f));
+    d.s.z = 0.0;
+    mat3d fn = d.u;
+    for (std::size_t c = 0; c < 3; ++c) {
+        for (std::size_t r = 0; r < 3; ++r) {
+            fn(r, c) *= d.s[c];
+        }
+    }
+    return nd->matrix().transpose() * (fn * d.v.transpose()) * ns->matrix();
+}
+
+} // namespace
+
+std::optional<mat<3, 3, float>> homography(std::span<const vec<2, float>> src,
+                                           std::span<const vec<2, float>> dst) noexcept {
+    const std::size_t n = src.size();
+    if (n < 4 || dst.size() != n) {
+        return std::nullopt;
+    }
+    const auto ns = normalize(src);
+    const auto nd = normalize(dst);
+    if (!ns || !nd) {
+        return std::nullopt;
+    }
+    //NOTE: with every point on one line the system has a null space of several dimensions and
+    //      its smallest eigenvector is an arbitrary mix that can pass the determinant test below
+    if (collinear(src, *ns) || collinear(dst, *nd)) {
+        return std::nullopt;
+    }
+
+    std::optional<mat3d> hn;
+    if (n == 4) {
+        //NOTE: minimal case: h(2, 2) = 1 leaves an 8x8 system; the origin of the normalized src
+        //      (the centroid) mapping to infinity is the only case that needs the general path
+        mat<8, 8, double> a(0.0);
+        vec<8, double> b;
+        for (std::size_t i = 0; i < 4; ++i) {
+            const auto [x, y] = ns->apply(src[i]);
+            const auto [u, v] = nd->apply(dst[i]);
+            const std::size_t r = i * 2;
+            a(r, 0) = x;
+            a(r, 1) = y;
+            a(r, 2) = 1.0;
+            a(r, 6) = -u * x;
+            a(r, 7) = -u * y;
+            b[r] = u;
+            a(r + 1, 3) = x;
+            a(r + 1, 4) = y;
+            a(r + 1, 5) = 1.0;
+            a(r + 1, 6) = -v * x;
+            a(r + 1, 7) = -v * y;
+            b[r + 1] = v;
+        }
+        if (const auto h = solve(a, b)) {
+            vec<9, double> h9;
+            for (std::size_t i = 0; i < 8; ++i) {
+                h9[i] = (*h)[i];
+            }
+            h9[8] = 1.0;
+            hn = from_rows(h9);
+        }
+    }
+    if (!hn) {
+        mat<9, 9, double> m(0.0);
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto [x, y] = ns->apply(src[i]);
+            const auto [u, v] = nd->apply(dst[i]);
+            accumulate<9>(m, {-x, -y, -1.0, 0.0, 0.0, 0.0, u * x, u * y, u});
+            accumulate<9>(m, {0.0, 0.0, 0.0, -x, -y, -1.0, v * x, v * y, v});
+        }
+        mirror_lower(m);
+        const auto h = smallest_eigenvector(m);
+        if (!h) {
+            return std::nullopt;
+        }
+        hn = from_rows(*h);
+    }
+
+    //NOTE: collinear samples give a (near) singular map; in normalized coordinates a usable
+    //      homography has a determinant of the order of its norm cubed
+    const double norm = frobenius(*hn);
+    if (!(std::abs(det(*hn)) > 1e-6 * norm * norm * norm)) {
+        return std::nullopt;
+    }
+
+    mat3d h = nd->inverse() * *hn * ns->matrix();
+    const double h22 = h(2, 2);
+    h /= std::abs(h22) > 1e-12 * frobenius(h) ? h22 : frobenius(h);
+    return mat<3, 3, float>(h);
+}
+
+std::optional<mat<3, 3, float>> fundamental(std::span<const vec<2, float>> src,
+                                            std::span<const vec<2, float>> dst) noexcept {
+    const auto f = epipolar_dlt(src, dst);
+    if (!f) {
+        return std::nullopt;
+    }
+    const double norm = frobenius(*f);
+    if (!(norm > 0.0)) {
+        return std::nullopt;
+    }
+    return mat<3, 3, float>(*f / norm);
+}
+
+std::optional<mat<3, 3, float>> essential(std::span<const vec<2, float>> src,
+                                          std::span<const vec<2, float>> dst) noexcept {
+    const auto f = epipolar_dlt(src, dst);
+    if (!f) {
+        return std::nullopt;
+    }
+    //NOTE: project onto the essential matrices: equal non-zero singular values, scaled to unit
+    //      Frobenius norm like fundamental()
+    const svd_result<double> d = svd(*f);
+    if (!(d.s.y > 0.0)) {
+        return std::nullopt;
+    }
+    mat3d u = d.u;
+    for (std::size_t r = 0; r < 3; ++r) {
+        u(r, 2) = 0.0;
+    }
+    return mat<3, 3, float>(u * d.v.transpose() * std::sqrt(0.5));
+}
+
+std::optional<mat<4, 4, float>> pose(std::span<const vec<3, float>> world,
+                                     std::span<const vec<2, float>> image) noexcept {
+    const std::size_t n = world.size();
+    if (n < 6 || image.size() != n) {
+        return std::nullopt;
+    }
+    const auto ni = normalize(image);
+    if (!ni) {
+        return std::nullopt;
+    }
+
+    //NOTE: world points normalized like the image points, mean distance sqrt(3)
+    vec<3, double> centroid(0.0);
+    for (const vec<3, float>& p : world) {
+        centroid += vec<3, double>(p.x, p.y, p.z);
+    }
+    centroid /= static_cast<double>(n);
+    double spread = 0.0;
+    for (const vec<3, float>& p : world) {
+        spread += (vec<3, double>(p.x, p.y, p.z) - centroid).length();
+    }
+    spread /= static_cast<double>(n);
+    if (!(spread > 0.0)) {
+        return std::nullopt;
+    }
+    const double scale = std::sqrt(3.0) / spread;
+
+    mat<12, 12, double> m(0.0);
+    for (std::size_t i = 0; i < n; ++i) {
+        const vec<3, double> w = (vec<3, double>(world[i].x, world[i].y, world[i].z) - centroid) * scale;
+        const auto [x, y] = ni->apply(image[i]);
+        accumulate<12>(m, {w.x, w.y, w.z, 1.0, 0.0, 0.0, 0.0, 0.0, -x * w.x, -x * w.y, -x * w.z, -x});
+        accumulate<12>(m, {0.0, 0.0, 0.0, 0.0, w.x, w.y, w.z, 1.0, -y * w.x, -y * w.y, -y * w.z, -y});
+    }
+    mirror_lower(m);
+    const auto p = smallest_eigenvector(m);
+    if (!p) {
+        return std::nullopt;
+    }
+
+    //NOTE: p = inverse(image normalization) * p_n * world normalization
+    mat<3, 4, double> pn;
+    for (std::size_t r = 0; r < 3; ++r) {
+        for (std::size_t c = 0; c < 4; ++c) {
+            pn(r, c) = (*p)[r * 4 + c];
+        }
+    }
+    mat<4, 4, double> tw = mat<4, 4, double>::identity() * scale;
+    tw(0, 3) = -scale * centroid.x;
+    tw(1, 3) = -scale * centroid.y;
+    tw(2, 3) = -scale * centroid.z;
+    tw(3, 3) = 1.0;
+    const mat3d ti = ni->inverse();
+    mat<3, 4, double> pw;
+    for (std::size_t c = 0; c < 4; ++c) {
+        for (std::size_t r = 0; r < 3; ++r) {
+            double sum = 0.0;
+            for (std::size_t k = 0; k < 4; ++k) {
+                double row = 0.0;
+                for (std::size_t j = 0; j < 3; ++j) {
+                    row += ti(r, j) * pn(j, k);
+                }
+                sum += row * tw(k, c);
+            }
+            pw(r, c) = sum;
+        }
+    }
+
+    //NOTE: pw = lambda * [r | t]; the sign of p is free, pick the one with det(r) = +1
+    mat3d a;
+    for (std::size_t c = 0; c < 3; ++c) {
+        for (std::size_t r = 0; r < 3; ++r) {
+            a(r, c) = pw(r, c);
+        }
+    }
+    const double sign = det(a) < 0.0 ? -1.0 : 1.0;
+    const svd_result<double> d = svd(a * sign);
+    //NOTE: coplanar or degenerate points leave a far from a scaled rotation
+    if (!(d.s.z > 0.25 * d.s.x)) {
+        return std::nullopt;
+    }
+    const mat3d rotation = d.u * d.v.transpose();
+    const double lambda = (d.s.x + d.s.y + d.s.z) / 3.0;
+
+    mat<4, 4, float> result = mat<4, 4, float>::identity();
+    for (std::size_t r = 0; r < 3; ++r) {
+        for (std::size_t c = 0; c < 3; ++c) {
+            result(r, c) = static_cast<float>(rotation(r, c));
+        }
+        result(r, 3) = static_cast<float>(pw(r, 3) * sign / lambda);
+    }
+    return result;
+}
+
+} // namespace cc::vision
@@ -0,0 +1,276 @@
+#include "vision/estimate.hpp"
+#include "random/random.hpp"
+#include "batch/kernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cc::vision {
+
+namespace {
+
+//NOTE: point tests per thread below which another thread costs more than it saves (a few
+//      hundred hypotheses against a thousand correspondences)
+constexpr std::size_t MinTestsPerThread = std::size_t{1} << 18;
+
+//NOTE: refit rounds after which the inlier set is taken as settled even if it still changes
+constexpr std::size_t MaxRefinements = 10;
+
+template<typename A, typename Model>
+using solver = std::optional<Model> (*)(std::span<const A>, std::span<const vec<2, float>>) noexcept;
+
+//NOTE: iterations after which an all-inlier sample has been drawn with the requested confidence
+[[nodiscard]] std::uint32_t required_iterations(std::size_t inliers, std::size_t n, std::size_t sample_size,
+                                                float confidence, std::uint32_t cap) noexcept {
+    const double all_inliers = std::pow(static_cast<double>(inliers) / static_cast<double>(n),
+                                        static_cast<double>(sample_size));
+    if (all_inliers >= 1.0) {
+        return 1;
+    }
+    const double needed = std::ceil(std::log1p(-static_cast<double>(confidence)) / std::log1p(-all_inliers));
+    return needed < static_cast<double>(cap) ? static_cast<std::uint32_t>(std::max(needed, 1.0)) : cap;
+}
+
+template<std::size_t N>
+void draw_sample(random::xoshiro256pp& rng, std::size_t n, std::array<std::size_t, N>& sample) noexcept {
+    for (std::size_t i = 0; i < N; ++i) {
+        std::size_t index;
+        do {
+            index = static_cast<std::size_t>((std::uint64_t{random::detail::next_u32(rng)} * n) >> 32);
+        } while (std::find(sample.begin(), sample.begin() + i, index) != sample.begin() + i);
+        sample[i] = index;
+    }
+}
+
+//NOTE: the shared driver: hypotheses from minimal samples, scored by score(model, bits) over all
+//      correspondences. Workers pull iteration numbers from one counter and shrink the common
+//      limit whenever one of them finds a better model
+template<std::size_t SampleSize, typename A, typename Model, typename Score>
+[[nodiscard]] std::optional<ransac_result<Model>> run(std::span<const A> a, std::span<const vec<2, float>> b,
+                                                      solver<A, Model> fit, const Score& score,
+                                                      const ransac_params& params,
+                                                      std::span<std::uint64_t> inliers) {
+    const std::size_t n = a.size();
+    if (n < SampleSize || b.size() != n || params.max_iterations == 0) {
+        return std::nullopt;
+    }
+    assert(inliers.empty() || inliers.size() >= (n + 63) / 64);
+
+    std::mutex mutex;
+    std::optional<Model> best;
+    std::atomic<std::size_t> best_count{0};
+    std::atomic<std::uint32_t> next{0};
+    std::atomic<std::uint32_t> limit{params.max_iterations};
+
+    const auto worker = [&](random::xoshiro256pp rng) {
+        std::array<std::size_t, SampleSize> sample{};
+        std::array<A, SampleSize> sa;
+        std::array<vec<2, float>, SampleSize> sb;
+        while (next.fetch_add(1, std::memory_order_relaxed) < limit.load(std::memory_order_relaxed)) {
+            draw_sample(rng, n, sample);
+            for (std::size_t i = 0; i < SampleSize; ++i) {
+                sa[i] = a[sample[i]];
+                sb[i] = b[sample[i]];
+            }
+            const std::optional<Model> model = fit(sa, sb);
+            if (!model) {
+                continue;
+            }
+            const std::size_t count = score(*model, nullptr);
+            if (count <= best_count.load(std::memory_order_relaxed)) {
+                continue;
+            }
+
+            const std::scoped_lock lock(mutex);
+            if (count > best_count.load(std::memory_order_relaxed)) {
+                best = model;
+                best_count.store(count, std::memory_order_relaxed);
+                const std::uint32_t needed = required_iterations(count, n, SampleSize, params.confidence,
+                                                                 params.max_iterations);
+                limit.store(std::min(needed, limit.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+            }
+        }
+    };
+
+    const std::size_t requested = params.threads != 0
+        ? params.threads
+        : std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t tests = static_cast<std::size_t>(params.max_iterations) * n;
+    const std::size_t workers = std::min(requested, std::max<std::size_t>(tests / MinTestsPerThread, 1));
+
+    random::xoshiro256pp seed(params.seed);
+    {
+        //NOTE: the calling thread works too; the jthreads join at the end of the scope
+        std::vector<std::jthread> threads;
+        threads.reserve(workers - 1);
+        for (std::size_t i = 1; i < workers; ++i) {
+            threads.emplace_back(worker, seed.fork());
+        }
+        worker(seed.fork());
+    }
+    if (!best) {
+        return std::nullopt;
+    }
+
+    ransac_result<Model> result{*best, best_count.load(), std::min(next.load(), limit.load())};
+    if (params.refine) {
+        //NOTE: a model from a minimal sample carries that sample's noise (the 6-point pose most
+        //      of all), and a refit on its inliers can admit more; repeat until the set settles
+        std::vector<std::uint64_t> bits((n + 63) / 64, 0);
+        std::vector<std::uint64_t> refined_bits(bits.size());
+        score(result.model, bits.data());
+        std::vector<A> ra;
+        std::vector<vec<2, float>> rb;
+        for (std::size_t round = 0; round < MaxRefinements; ++round) {
+            ra.clear();
+            rb.clear();
+            for (std::size_t i = 0; i < n; ++i) {
+                if (bits[i / 64] & (std::uint64_t{1} << (i % 64))) {
+                    ra.push_back(a[i]);
+                    rb.push_back(b[i]);
+                }
+            }
+            const std::optional<Model> refined = fit(ra, rb);
+            if (!refined) {
+                break;
+            }
+            std::fill(refined_bits.begin(), refined_bits.end(), 0);
+            const std::size_t count = score(*refined, refined_bits.data());
+            if (count < result.inliers) {
+                break;
+            }
+            result.model = *refined;
+            result.inliers = count;
+            if (refined_bits == bits) {
+                break;
+            }
+            bits.swap(refined_bits);
+        }
+    }
+    if (!inliers.empty()) {
+        std::fill(inliers.begin(), inliers.end(), 0);
+        score(result.model, inliers.data());
+    }
+    return result;
+}
+
+//NOTE: SoA copies of the correspondences for the kernels
+struct planar_points {
+    std::vector<float> x;
+    std::vector<float> y;
+
+    explicit planar_points(std::span<const vec<2, float>> points) : x(points.size()), y(points.size()) {
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            x[i] = points[i].x;
+            y[i] = points[i].y;
+        }
+    }
+};
+
+struct spatial_points {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+
+    explicit spatial_points(std::span<const vec<3, float>> points)
+        : x(points.size()), y(points.size()), z(points.size()) {
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            x[i] = points[i].x;
+            y[i] = points[i].y;
+            z[i] = points[i].z;
+        }
+    }
+};
+
+[[nodiscard]] std::array<float, 9> pack(const mat<3, 3, float>& m) noexcept {
+    std::array<float, 9> packed;
+    for (std::size_t c = 0; c < 3; ++c) {
+        for (std::size_t r = 0; r < 3; ++r) {
+            packed[c * 3 + r] = m(r, c);
+        }
+    }
+    return packed;
+}
+
+//NOTE: the top three rows, i.e. the 3x4 projection [r | t]
+[[nodiscard]] std::array<float, 12> pack(const mat<4, 4, float>& m) noexcept {
+    std::array<float, 12> packed;
+    for (std::size_t c = 0; c < 4; ++c) {
+        for (std::size_t r = 0; r < 3; ++r) {
+            packed[c * 3 + r] = m(r, c);
+        }
+    }
+    return packed;
+}
+
+template<std::size_t SampleSize>
+[[nodiscard]] std::optional<ransac_result<mat<3, 3, float>>> find_epipolar(
+    std::span<const vec<2, float>> src, std::span<const vec<2, float>> dst,
+    solver<vec<2, float>, mat<3, 3, float>> fit, const ransac_params& params, std::span<std::uint64_t> inliers) {
+    const planar_points s(src);
+    const planar_points d(dst);
+    const batch::detail::kernel_table& kernels = batch::detail::active_kernels();
+    const float threshold2 = params.threshold * params.threshold;
+    const auto score = [&](const mat<3, 3, float>& f, std::uint64_t* bits) {
+        const std::array<float, 9> packed = pack(f);
+        return kernels.score_epipolar(packed.data(), s.x.data(), s.y.data(), d.x.data(), d.y.data(),
+                                      src.size(), threshold2, bits);
+    };
+    return run<SampleSize>(src, dst, fit, score, params, inliers);
+}
+
+} // namespace
+
+std::optional<ransac_result<mat<3, 3, float>>> find_homography(std::span<const vec<2, float>> src,
+                                                               std::span<const vec<2, float>> dst,
+                                                               const ransac_params& params,
+                                                               std::span<std::uint64_t> inliers) {
+    const planar_points s(src);
+    const planar_points d(dst);
+    const batch::detail::kernel_table& kernels = batch::detail::active_kernels();
+    const float threshold2 = params.threshold * params.threshold;
+    const auto score = [&](const mat<3, 3, float>& h, std::uint64_t* bits) {
+        const std::array<float, 9> packed = pack(h);
+        return kernels.score_homography(packed.data(), s.x.data(), s.y.data(), d.x.data(), d.y.data(),
+                                        src.size(), threshold2, bits);
+    };
+    return run<4>(src, dst, &homography, score, params, inliers);
+}
+
+std::optional<ransac_result<mat<3, 3, float>>> find_fundamental(std::span<const vec<2, float>> src,
+                                                                std::span<const vec<2, float>> dst,
+                                                                const ransac_params& params,
+                                                                std::span<std::uint64_t> inliers) {
+    return find_epipolar<8>(src, dst, &fundamental, params, inliers);
+}
+
+std::optional<ransac_result<mat<3, 3, float>>> find_essential(std::span<const vec<2, float>> src,
+                                                              std::span<const vec<2, float>> dst,
+                                                              const ransac_params& params,
+                                                              std::span<std::uint64_t> inliers) {
+    return find_epipolar<8>(src, dst, &essential, params, inliers);
+}
+
+std::optional<ransac_result<mat<4, 4, float>>> find_pose(std::span<const vec<3, float>> world,
+                                                         std::span<const vec<2, float>> image,
+                                                         const ransac_params& params,
+                                                         std::span<std::uint64_t> inliers) {
+    const spatial_points w(world);
+    const planar_points i(image);
+    const batch::detail::kernel_table& kernels = batch::detail::active_kernels();
+    const float threshold2 = params.threshold * params.threshold;
+    const auto score = [&](const mat<4, 4, float>& m, std::uint64_t* bits) {
+        const std::array<float, 12> packed = pack(m);
+        return kernels.score_projection(packed.data(), w.x.data(), w.y.data(), w.z.data(), i.x.data(),
+                                        i.y.data(), world.size(), threshold2, bits);
+    };
+    return run<6>(world, image, &pose, score, params, inliers);
+}
+
+} // namespace cc::vision
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <cc/core/types.hpp>
+#include <cc/math/common/constants.hpp>
+#include <cc/math/geometry/aabb.hpp>
+#include <cc/math/geometry/ray.hpp>
+#include <cc/math/vec/vec3.hpp>
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace cc::spatial {
+
+//NOTE: Flattened node, 32 bytes so two share a cache line. Nodes are stored depth-first: the left
+//      child of an interior node is the next node, leftFirst holds the right child. For leaves
+//      leftFirst is the first primitive slot and count the number of primitives.
+struct BvhNode {
+    vec<3, float> min{};
+    u32           leftFirst{0};
+    vec<3, float> max{};
+    u32           count{0};
+
+    [[nodiscard]] constexpr bool IsLeaf() const noexcept {
+        return count != 0;
+    }
+
+    [[nodiscard]] constexpr aabb<float> Bounds() const noexcept {
+        return {min, max};
+    }
+};
+
+static_assert(sizeof(BvhNode) == 32);
+
+//NOTE: leaves are forced at this depth, which also bounds the traversal stack
+inline constexpr u32 BvhMaxDepth = 64;
+
+struct BvhBuildSettings {
+    //NOTE: SAH candidate planes per axis, clamped to [2, 32]
+    u32   binCount{16};
+    //NOTE: ranges above this size are always split, smaller ones only when SAH says it pays off
+    u32   maxLeafSize{8};
+    //NOTE: cost of visiting an interior node relative to one primitive test
+    float traversalCost{1.0f};
+    //NOTE: 0 uses std::thread::hardware_concurrency()
+    u32   threadCount{0};
+};
+
+//NOTE: primitive is the source index; detail::Traverse reports the leaf slot there instead, with
+//      Bvh::Indices()[slot] being the source primitive
+struct BvhHit {
+    float t{0.0f};
+    u32   primitive{0};
+};
+
+namespace detail {
+
+//NOTE: entry distance of the ray into the node, +inf when it misses [tMin, tMax]
+[[nodiscard]] inline float SlabEntry(const BvhNode& node, const vec<3, float>& origin, const vec<3, float>& invDir,
+                                     float tMin, float tMax) noexcept {
+    const float tx0 = (node.min.x - origin.x) * invDir.x;
+    const float tx1 = (node.max.x - origin.x) * invDir.x;
+    const float ty0 = (node.min.y - origin.y) * invDir.y;
+    const float ty1 = (node.max.y - origin.y) * invDir.y;
+    const float tz0 = (node.min.z - origin.z) * invDir.z;
+    const float tz1 = (node.max.z - origin.z) * invDir.z;
+
+    const float nearX = tx0 < tx1 ? tx0 : tx1;
+    const float farX  = tx0 < tx1 ? tx1 : tx0;
+    const float nearY = ty0 < ty1 ? ty0 : ty1;
+    const float farY  = ty0 < ty1 ? ty1 : ty0;
+    const float nearZ = tz0 < tz1 ? tz0 : tz1;
+    const float farZ  = tz0 < tz1 ? tz1 : tz0;
+
+    float entry = nearX > nearY ? nearX : nearY;
+    entry       = nearZ > entry ? nearZ : entry;
+    entry       = tMin > entry ? tMin : entry;
+    float exit  = farX < farY ? farX : farY;
+    exit        = farZ < exit ? farZ : exit;
+    exit        = tMax < exit ? tMax : exit;
+
+    return entry <= exit ? entry : infinity<float>;
+}
+
+[[nodiscard]] inline bool Overlaps(const BvhNode& node, const aabb<float>& box) noexcept {
+    return node.min.x <= box.max.x && node.max.x >= box.min.x &&
+           node.min.y <= box.max.y && node.max.y >= box.min.y &&
+           node.min.z <= box.max.z && node.max.z >= box.min.z;
+}
+
+//NOTE: Ordered short-stack traversal. test(slot, tMax) returns the hit distance of a primitive
+//      when it is closer than tMax; the near child is descended first and far children are only
+//      popped while their entry distance still beats the closest hit.
+template<bool AnyHit, typename Fn>
+[[nodiscard]] std::optional<BvhHit> Traverse(std::span<const BvhNode> nodes, const vec<3, float>& origin,
+                                             const vec<3, float>& invDir, float tMin, float tMax, Fn&& test) {
+    if (nodes.empty() || SlabEntry(nodes[0], origin, invDir, tMin, tMax) == infinity<float>) {
+        return std::nullopt;
+    }
+
+    std::array<u32, BvhMaxDepth>   stack;
+    std::array<float, BvhMaxDepth> stackEntry;
+    u32 top = 0;
+
+    std::optional<BvhHit> best;
+    u32 current = 0;
+    for (;;) {
+        const BvhNode& node = nodes[current];
+        if (node.IsLeaf()) {
+            for (u32 slot = node.leftFirst; slot < node.leftFirst + node.count; ++slot) {
+                if (const std::optional<float> t = test(slot, tMax)) {
+                    tMax = *t;
+                    best = BvhHit{*t, slot};
+                    if constexpr (AnyHit) {
+                        return best;
+                    }
+                }
+            }
+        } else {
+            u32 nearChild = current + 1;
+            u32 farChild  = node.leftFirst;
+            float nearT = SlabEntry(nodes[nearChild], origin, invDir, tMin, tMax);
+            float farT  = SlabEntry(nodes[farChild], origin, invDir, tMin, tMax);
+            if (farT < nearT) {
+                std::swap(nearChild, farChild);
+                std::swap(nearT, farT);
+            }
+
+            if (nearT != infinity<float>) {
+                if (farT != infinity<float>) {
+                    stack[top]      = farChild;
+                    stackEntry[top] = farT;
+                    ++top;
+                }
+                current = nearChild;
+                continue;
+            }
+        }
+
+        //NOTE: skip far children that lie behind a hit found after they were pushed
+        do {
+            if (top == 0) {
+                return best;
+            }
+            --top;
+        } while (stackEntry[top] > tMax);
+        current = stack[top];
+    }
+}
+
+//NOTE: calls fn(slot) for every primitive of every leaf overlapping box
+template<typename Fn>
+void Query(std::span<const BvhNode> nodes, const aabb<float>& box, Fn&& fn) {
+    if (nodes.empty() || !Overlaps(nodes[0], box)) {
+        return;
+    }
+
+    std::array<u32, BvhMaxDepth> stack;
+    u32 top = 0;
+
+    u32 current = 0;
+    for (;;) {
+        const BvhNode& node = nodes[current];
+        if (node.IsLeaf()) {
+            for (u32 slot = node.leftFirst; slot < node.leftFirst + node.count; ++slot) {
+                fn(slot);
+            }
+        } else {
+            const u32 left  = current + 1;
+            const u32 right = node.leftFirst;
+            const bool hitL = Overlaps(nodes[left], box);
+            const bool hitR = Overlaps(nodes[right], box);
+            if (hitL || hitR) {
+                if (hitL && hitR) {
+                    stack[top++] = right;
+                }
+                current = hitL ? left : right;
+                continue;
+            }
+        }
+
+        if (top == 0) {
+            return;
+        }
+        current = stack[--top];
+    }
+}
+
+} // namespace detail
+
+//NOTE: Bounding volume hierarchy over arbitrary boxes, built with binned SAH. Large subtrees are
+//      built on separate threads and the binning pass of the top levels is split across threads.
+//      Primitive tests are supplied by the caller, which keeps the tree independent of what it
+//      indexes; see MeshBvh for a triangle mesh built on top of it.
+class Bvh {
+public:
+    Bvh() = default;
+
+    explicit Bvh(std::span<const aabb<float>> bounds, const BvhBuildSettings& settings = {}) {
+        Build(bounds, settings);
+    }
+
+    void Build(std::span<const aabb<float>> bounds, const BvhBuildSettings& settings = {});
+
+    //NOTE: closest hit; test(primitive, tMax) returns the hit distance if it is below tMax
+    template<typename Fn>
+    [[nodiscard]] std::optional<BvhHit> Intersect(const ray<float>& r, Fn&& test,
+                                                  float tMin = 0.0f, float tMax = infinity<float>) const {
+        return Resolve(detail::Traverse<false>(nodes_, r.origin, r.inv_direction(), tMin, tMax,
+            [&](u32 slot, float limit) { return test(indices_[slot], limit); }));
+    }
+
+    //NOTE: any hit in [tMin, tMax], for shadow and visibility rays
+    template<typename Fn>
+    [[nodiscard]] bool Occluded(const ray<float>& r, Fn&& test,
+                                float tMin = 0.0f, float tMax = infinity<float>) const {
+        return detail::Traverse<true>(nodes_, r.origin, r.inv_direction(), tMin, tMax,
+            [&](u32 slot, float limit) { return test(indices_[slot], limit); }).has_value();
+    }
+
+    //NOTE: calls fn(primitive) for the primitives of every leaf overlapping box; the result is
+    //      conservative, callers test their own primitive bounds if they need an exact set
+    template<typename Fn>
+    void Query(const aabb<float>& box, Fn&& fn) const {
+        detail::Query(nodes_, box, [&](u32 slot) { fn(indices_[slot]); });
+    }
+
+    [[nodiscard]] std::span<const BvhNode> Nodes() const noexcept {
+        return nodes_;
+    }
+
+    //NOTE: primitive indices in leaf order
+    [[nodiscard]] std::span<const u32> Indices() const noexcept {
+        return indices_;
+    }
+
+    [[nodiscard]] aabb<float> Bounds() const noexcept {
+        return nodes_.empty() ? aabb<float>::empty() : nodes_[0].Bounds();
+    }
+
+    [[nodiscard]] bool Empty() const noexcept {
+        return nodes_.empty();
+    }
+
+    void Clear() noexcept {
+        nodes_.clear();
+        indices_.clear();
+    }
+
+private:
+    [[nodiscard]] std::optional<BvhHit> Resolve(std::optional<BvhHit> hit) const noexcept {
+        if (hit) {
+            hit->primitive = indices_[hit->primitive];
+        }
+        return hit;
+    }
+
+    std::vector<BvhNode> nodes_;
+    std::vector<u32>     indices_;
+};
+
+} // namespace cc::spatial
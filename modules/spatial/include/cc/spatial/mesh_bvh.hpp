@@ -0,0 +1,77 @@
+#pragma once
+
+#include "bvh.hpp"
+
+#include <cc/core/types.hpp>
+#include <cc/math/common/constants.hpp>
+#include <cc/math/geometry/aabb.hpp>
+#include <cc/math/geometry/ray.hpp>
+#include <cc/math/geometry/triangle.hpp>
+
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace cc::spatial {
+
+//NOTE: barycentrics follow cc::ray_hit: point = a + u * (b - a) + v * (c - a)
+struct MeshHit {
+    float t{0.0f};
+    float u{0.0f};
+    float v{0.0f};
+    u32   triangle{0};
+};
+
+//NOTE: Triangle mesh BVH for picking and CPU ray casts. Triangles are copied in leaf order so a
+//      leaf's triangles are contiguous in memory; hits report the source triangle index.
+class MeshBvh {
+public:
+    MeshBvh() = default;
+
+    explicit MeshBvh(std::span<const triangle<float>> triangles, const BvhBuildSettings& settings = {}) {
+        Build(triangles, settings);
+    }
+
+    //NOTE: indexed triangle list, three indices per triangle
+    MeshBvh(std::span<const vec<3, float>> positions, std::span<const u32> indices,
+            const BvhBuildSettings& settings = {}) {
+        Build(positions, indices, settings);
+    }
+
+    void Build(std::span<const triangle<float>> triangles, const BvhBuildSettings& settings = {});
+    void Build(std::span<const vec<3, float>> positions, std::span<const u32> indices,
+               const BvhBuildSettings& settings = {});
+
+    [[nodiscard]] std::optional<MeshHit> Intersect(const ray<float>& r,
+                                                   float tMin = 0.0f, float tMax = infinity<float>) const;
+
+    [[nodiscard]] bool Occluded(const ray<float>& r, float tMin = 0.0f, float tMax = infinity<float>) const;
+
+    //NOTE: appends the triangles whose bounds overlap box
+    void Query(const aabb<float>& box, std::vector<u32>& out) const;
+
+    [[nodiscard]] const Bvh& Tree() const noexcept {
+        return bvh_;
+    }
+
+    //NOTE: triangles in leaf order, Tree().Indices() maps them back to the source
+    [[nodiscard]] std::span<const triangle<float>> Triangles() const noexcept {
+        return triangles_;
+    }
+
+    [[nodiscard]] std::size_t Size() const noexcept {
+        return triangles_.size();
+    }
+
+    [[nodiscard]] bool Empty() const noexcept {
+        return triangles_.empty();
+    }
+
+private:
+    void Finish(std::vector<triangle<float>>&& source, const BvhBuildSettings& settings);
+
+    Bvh                          bvh_;
+    std::vector<triangle<float>> triangles_;
+};
+
+} // namespace cc::spatial
@@ -0,0 +1,6 @@
+#pragma once
+
+// IWYU pragma: begin_exports
+#include "bvh.hpp"
+#include "mesh_bvh.hpp"
+// IWYU pragma: end_exports
@@ -0,0 +1,310 @@
+#include <cc/spatial/bvh.hpp>
+
+#include <algorithm>
+#include <array>
+#include <thread>
+
+namespace cc::spatial {
+
+namespace {
+
+constexpr u32 MaxBins = 32;
+
+//NOTE: below this many primitives a range is binned and built on a single thread, spawning costs
+//      more than the work it would split
+constexpr u32 ParallelThreshold = 1u << 14;
+
+struct Bin {
+    aabb<float> bounds = aabb<float>::empty();
+    u32         count{0};
+};
+
+using Bins = std::array<std::array<Bin, MaxBins>, 3>;
+
+//NOTE: primitives are partitioned as self-contained records instead of through an index array, so
+//      every pass over a range streams memory rather than gathering from the input
+struct Reference {
+    vec<3, float> min;
+    u32           index;
+    vec<3, float> max;
+
+    [[nodiscard]] vec<3, float> Centroid() const noexcept {
+        return (min + max) * 0.5f;
+    }
+};
+
+struct RangeBounds {
+    aabb<float> bounds   = aabb<float>::empty();
+    aabb<float> centroid = aabb<float>::empty();
+
+    void Merge(const RangeBounds& other) noexcept {
+        bounds.expand(other.bounds);
+        centroid.expand(other.centroid);
+    }
+};
+
+struct Split {
+    int   axis{-1};
+    u32   bin{0};
+    u32   binCount{0};
+    float cost{infinity<float>};
+};
+
+//NOTE: runs fn(begin, end, result) over `workers` contiguous chunks, each with a Result(args...),
+//      and merges the partial results
+template<typename Result, typename Fn, typename... Args>
+Result ParallelReduce(u32 begin, u32 end, u32 workers, Fn&& fn, const Args&... args) {
+    const u32 count = end - begin;
+    if (workers <= 1 || count < ParallelThreshold) {
+        Result result(args...);
+        fn(begin, end, result);
+        return result;
+    }
+
+    std::vector<Result> partial(workers, Result(args...));
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(workers - 1);
+        for (u32 w = 1; w < workers; ++w) {
+            const u32 first = begin + static_cast<u32>(u64{count} * w / workers);
+            const u32 last  = begin + static_cast<u32>(u64{count} * (w + 1) / workers);
+            threads.emplace_back([&, first, last, w] { fn(first, last, partial[w]); });
+        }
+        fn(begin, begin + count / workers, partial[0]);
+    }
+
+    for (u32 w = 1; w < workers; ++w) {
+        partial[0].Merge(partial[w]);
+    }
+    return partial[0];
+}
+
+class Builder {
+public:
+    Builder(std::vector<Reference>& refs, const BvhBuildSettings& settings)
+        : refs_(refs)
+        , binCount_(std::clamp(settings.binCount, 2u, MaxBins))
+        , maxLeafSize_(std::max(settings.maxLeafSize, 1u))
+        , traversalCost_(settings.traversalCost) {}
+
+    //NOTE: appends the subtree of [begin, end) to out in depth-first order; child links are
+    //      relative to out, primitive slots are absolute
+    void Build(u32 begin, u32 end, u32 depth, u32 workers, std::vector<BvhNode>& out) const {
+        const u32 count = end - begin;
+        const RangeBounds range = ComputeBounds(begin, end, workers);
+
+        const u32 nodeIndex = static_cast<u32>(out.size());
+        out.push_back(BvhNode{range.bounds.min, begin, range.bounds.max, count});
+
+        if (count == 1 || depth + 1 >= BvhMaxDepth) {
+            return;
+        }
+
+        const Split split = FindSplit(begin, end, range, workers);
+        u32 mid = 0;
+        if (split.axis < 0) {
+            //NOTE: all centroids coincide, halve the range arbitrarily if it is too large for a leaf
+            if (count <= maxLeafSize_) {
+                return;
+            }
+            mid = begin + count / 2;
+        } else {
+            if (split.cost >= static_cast<float>(count) && count <= maxLeafSize_) {
+                return;
+            }
+
+            const int axis    = split.axis;
+            const float low   = range.centroid.min[axis];
+            const float scale = BinScale(range.centroid, axis, split.binCount);
+            const auto first  = refs_.begin() + begin;
+            const auto last   = refs_.begin() + end;
+            mid = static_cast<u32>(std::partition(first, last, [&](const Reference& ref) {
+                return BinIndex(ref.Centroid()[axis], low, scale, split.binCount) <= split.bin;
+            }) - refs_.begin());
+
+            if (mid == begin || mid == end) {
+                mid = begin + count / 2;
+            }
+        }
+
+        out[nodeIndex].count = 0;
+
+        if (workers > 1 && count >= ParallelThreshold) {
+            //NOTE: each half gets its share of the workers and its own node list, spliced afterwards
+            const u32 leftWorkers = workers / 2;
+            std::vector<BvhNode> left;
+            std::vector<BvhNode> right;
+            {
+                std::jthread worker([&] { Build(begin, mid, depth + 1, leftWorkers, left); });
+                Build(mid, end, depth + 1, workers - leftWorkers, right);
+            }
+
+            Append(out, left);
+            out[nodeIndex].leftFirst = static_cast<u32>(out.size());
+            Append(out, right);
+        } else {
+            Build(begin, mid, depth + 1, 1, out);
+            out[nodeIndex].leftFirst = static_cast<u32>(out.size());
+            Build(mid, end, depth + 1, 1, out);
+        }
+    }
+
+private:
+    [[nodiscard]] static float BinScale(const aabb<float>& centroid, int axis, u32 bins) noexcept {
+        const float extent = centroid.max[axis] - centroid.min[axis];
+        return extent > 0.0f ? static_cast<float>(bins) / extent : 0.0f;
+    }
+
+    [[nodiscard]] static u32 BinIndex(float c, float low, float scale, u32 bins) noexcept {
+        return std::min(bins - 1, static_cast<u32>((c - low) * scale));
+    }
+
+    [[nodiscard]] RangeBounds ComputeBounds(u32 begin, u32 end, u32 workers) const {
+        return ParallelReduce<RangeBounds>(begin, end, workers, [&](u32 first, u32 last, RangeBounds& result) {
+            for (u32 k = first; k < last; ++k) {
+                const Reference& ref = refs_[k];
+                result.bounds.expand(aabb<float>(ref.min, ref.max));
+                result.centroid.expand(ref.Centroid());
+            }
+        });
+    }
+
+    [[nodiscard]] Split FindSplit(u32 begin, u32 end, const RangeBounds& range, u32 workers) const {
+        //NOTE: small ranges need no more bins than primitives; most nodes are near the leaves so
+        //      this keeps the per-node cost of the SAH sweep proportional to the range
+        const u32 count    = end - begin;
+        const u32 binCount = std::min(binCount_, std::max(count, 2u));
+
+        std::array<float, 3> scale{};
+        for (int axis = 0; axis < 3; ++axis) {
+            scale[axis] = BinScale(range.centroid, axis, binCount);
+        }
+
+        struct BinSet {
+            Bins bins;
+            u32  size;
+
+            explicit BinSet(u32 size_) noexcept : size(size_) {
+                for (auto& axis : bins) {
+                    for (u32 b = 0; b < size; ++b) {
+                        axis[b] = Bin{};
+                    }
+                }
+            }
+
+            void Merge(const BinSet& other) noexcept {
+                for (int axis = 0; axis < 3; ++axis) {
+                    for (u32 b = 0; b < size; ++b) {
+                        bins[axis][b].bounds.expand(other.bins[axis][b].bounds);
+                        bins[axis][b].count += other.bins[axis][b].count;
+                    }
+                }
+            }
+        };
+
+        const BinSet binned = ParallelReduce<BinSet>(begin, end, workers, [&](u32 first, u32 last, BinSet& result) {
+            //NOTE: flat axes have a zero scale and collect everything in bin 0, the sweep skips them
+            const vec<3, float> low = range.centroid.min;
+            for (u32 k = first; k < last; ++k) {
+                const Reference& ref = refs_[k];
+                const aabb<float> box(ref.min, ref.max);
+                const vec<3, float> centroid = ref.Centroid();
+                const u32 bx = BinIndex(centroid.x, low.x, scale[0], binCount);
+                const u32 by = BinIndex(centroid.y, low.y, scale[1], binCount);
+                const u32 bz = BinIndex(centroid.z, low.z, scale[2], binCount);
+                result.bins[0][bx].bounds.expand(box);
+                result.bins[1][by].bounds.expand(box);
+                result.bins[2][bz].bounds.expand(box);
+                ++result.bins[0][bx].count;
+                ++result.bins[1][by].count;
+                ++result.bins[2][bz].count;
+            }
+        }, binCount);
+
+        //NOTE: SAH, cost = traversal + (area_l * n_l + area_r * n_r) / area_parent in units of one
+        //      primitive test; planes sit between bins, the right side is swept back to front
+        const float parentArea = range.bounds.surface_area();
+        const float invArea    = parentArea > 0.0f ? 1.0f / parentArea : 0.0f;
+
+        Split best;
+        for (int axis = 0; axis < 3; ++axis) {
+            if (scale[axis] == 0.0f) {
+                continue;
+            }
+
+            const auto& bins = binned.bins[axis];
+            std::array<float, MaxBins> rightCost;
+            aabb<float> rightBox = aabb<float>::empty();
+            u32 rightCount = 0;
+            for (u32 b = binCount - 1; b > 0; --b) {
+                rightBox.expand(bins[b].bounds);
+                rightCount += bins[b].count;
+                rightCost[b - 1] = rightCount ? rightBox.surface_area() * static_cast<float>(rightCount) : 0.0f;
+            }
+
+            aabb<float> leftBox = aabb<float>::empty();
+            u32 leftCount = 0;
+            for (u32 b = 0; b + 1 < binCount; ++b) {
+                leftBox.expand(bins[b].bounds);
+                leftCount += bins[b].count;
+                if (leftCount == 0 || leftCount == count) {
+                    continue;
+                }
+
+                const float cost = traversalCost_ +
+                    (leftBox.surface_area() * static_cast<float>(leftCount) + rightCost[b]) * invArea;
+                if (cost < best.cost) {
+                    best = Split{axis, b, binCount, cost};
+                }
+            }
+        }
+        return best;
+    }
+
+    static void Append(std::vector<BvhNode>& out, const std::vector<BvhNode>& subtree) {
+        const u32 base = static_cast<u32>(out.size());
+        for (BvhNode node : subtree) {
+            if (!node.IsLeaf()) {
+                node.leftFirst += base;
+            }
+            out.push_back(node);
+        }
+    }
+
+    std::vector<Reference>& refs_;
+    u32                     binCount_;
+    u32                     maxLeafSize_;
+    float                   traversalCost_;
+};
+
+} // namespace
+
+void Bvh::Build(std::span<const aabb<float>> bounds, const BvhBuildSettings& settings) {
+    Clear();
+    if (bounds.empty()) {
+        return;
+    }
+
+    const u32 count = static_cast<u32>(bounds.size());
+    std::vector<Reference> refs(count);
+    for (u32 i = 0; i < count; ++i) {
+        refs[i] = Reference{bounds[i].min, i, bounds[i].max};
+    }
+
+    const u32 workers = settings.threadCount != 0
+        ? settings.threadCount
+        : std::max(1u, std::thread::hardware_concurrency());
+
+    nodes_.reserve(2 * static_cast<std::size_t>(count) - 1);
+
+    const Builder builder(refs, settings);
+    builder.Build(0, count, 0, workers, nodes_);
+    nodes_.shrink_to_fit();
+
+    indices_.resize(count);
+    for (u32 slot = 0; slot < count; ++slot) {
+        indices_[slot] = refs[slot].index;
+    }
+}
+
+} // namespace cc::spatial
@@ -0,0 +1,78 @@
+#include <cc/spatial/mesh_bvh.hpp>
+
+#include <cc/math/geometry/intersect.hpp>
+
+#include <cassert>
+
+namespace cc::spatial {
+
+void MeshBvh::Build(std::span<const triangle<float>> triangles, const BvhBuildSettings& settings) {
+    Finish(std::vector<triangle<float>>(triangles.begin(), triangles.end()), settings);
+}
+
+void MeshBvh::Build(std::span<const vec<3, float>> positions, std::span<const u32> indices,
+                    const BvhBuildSettings& settings) {
+    assert(indices.size() % 3 == 0);
+
+    std::vector<triangle<float>> source;
+    source.reserve(indices.size() / 3);
+    for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+        source.emplace_back(positions[indices[i]], positions[indices[i + 1]], positions[indices[i + 2]]);
+    }
+    Finish(std::move(source), settings);
+}
+
+void MeshBvh::Finish(std::vector<triangle<float>>&& source, const BvhBuildSettings& settings) {
+    std::vector<aabb<float>> bounds;
+    bounds.reserve(source.size());
+    for (const triangle<float>& tri : source) {
+        bounds.push_back(aabb<float>::empty().expand(tri.a).expand(tri.b).expand(tri.c));
+    }
+
+    bvh_.Build(bounds, settings);
+
+    //NOTE: leaf order, so traversal reads each leaf's triangles from one contiguous block
+    const std::span<const u32> order = bvh_.Indices();
+    triangles_.resize(source.size());
+    for (std::size_t slot = 0; slot < order.size(); ++slot) {
+        triangles_[slot] = source[order[slot]];
+    }
+}
+
+std::optional<MeshHit> MeshBvh::Intersect(const ray<float>& r, float tMin, float tMax) const {
+    ray_hit<float> closest{};
+    const std::optional<BvhHit> hit = detail::Traverse<false>(bvh_.Nodes(), r.origin, r.inv_direction(), tMin, tMax,
+        [&](u32 slot, float limit) -> std::optional<float> {
+            const std::optional<ray_hit<float>> h = intersect(r, triangles_[slot], tMin, limit);
+            if (!h) {
+                return std::nullopt;
+            }
+            closest = *h;
+            return h->t;
+        });
+
+    if (!hit) {
+        return std::nullopt;
+    }
+    return MeshHit{closest.t, closest.u, closest.v, bvh_.Indices()[hit->primitive]};
+}
+
+bool MeshBvh::Occluded(const ray<float>& r, float tMin, float tMax) const {
+    return detail::Traverse<true>(bvh_.Nodes(), r.origin, r.inv_direction(), tMin, tMax,
+        [&](u32 slot, float limit) -> std::optional<float> {
+            const std::optional<ray_hit<float>> h = intersect(r, triangles_[slot], tMin, limit);
+            return h ? std::optional<float>(h->t) : std::nullopt;
+        }).has_value();
+}
+
+void MeshBvh::Query(const aabb<float>& box, std::vector<u32>& out) const {
+    const std::span<const u32> order = bvh_.Indices();
+    detail::Query(bvh_.Nodes(), box, [&](u32 slot) {
+        const triangle<float>& tri = triangles_[slot];
+        if (intersects(aabb<float>::empty().expand(tri.a).expand(tri.b).expand(tri.c), box)) {
+            out.push_back(order[slot]);
+        }
+    });
+}
+
+} // namespace cc::spatial